@@ -3,43 +3,134 @@
 // MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
 
 #include <stdlib.h>
-#include <string.h> // used for strlen
+#include <string.h> // used for strlen, memcpy
+#if defined(_WIN32)
+#include <windows.h>
+#include <process.h> // used for _beginthreadex
+#else
+#include <pthread.h>
+#include <time.h> // used for clock_gettime
+#endif
 #include "shrinquem.h"
+#include "shrinquem_internal.h"
 
-#define BITS_PER_BYTE (8)
+#define MAX_PARALLEL_TASKS (2)
 
-static const unsigned long MAX_NUM_VARIABLES = sizeof(long) * BITS_PER_BYTE;
+static const unsigned long MAX_NUM_VARIABLES = sizeof(cube64) * BITS_PER_BYTE;
 
 static unsigned long numTermsKept = 0;
 static unsigned long numTermsRemoved = 0;
 
-static unsigned long EstimateMaxNumOfMinterms(
-    const unsigned long numVars,
-    const triLogic truthTable[]);
+static const ReduceLogicOptions DEFAULT_OPTIONS = { .polarity = POLARITY_SUM_OF_PRODUCTS };
 
-static void RemoveNonprimeImplicants(
+// arguments and results of one ReduceLogicCore run on its own thread
+typedef struct ReduceLogicTask
+{
+    const triLogic* truthTable;
+    triLogic onValue;
+    const ReduceLogicOptions* options;
+    triLogic* resolved;
+    int isIrredundancyDeferred;
+    SumOfProducts* sumOfProducts;
+    shrinquemStatus status;
+    unsigned long numTermsKept;
+    unsigned long numTermsRemoved;
+} ReduceLogicTask;
+
+typedef void (*parallelTask)(void* args);
+
+static shrinquemStatus CheckReduceLogicArguments(
+    const triLogic truthTable[],
     SumOfProducts* sumOfProducts);
 
+static void ReduceLogicTaskEntry(
+    void* args);
+
+static shrinquemStatus ReduceLogicLimited(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    Checkpoint* checkpoint);
+
+static shrinquemStatus ReduceLogicCheckpointed(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options,
+    const char* checkpointPath,
+    double interval,
+    int isResuming);
+
+static shrinquemStatus ReduceLogicCore(
+    const triLogic truthTable[],
+    const triLogic onValue,
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    Checkpoint* checkpoint,
+    triLogic resolved[],
+    const int isIrredundancyDeferred,
+    SumOfProducts* sumOfProducts,
+    unsigned long* numKept,
+    unsigned long* numRemoved);
+
+static shrinquemStatus RunIrredundancyPass(
+    const triLogic truthTable[],
+    const triLogic onValue,
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    SumOfProducts* sumOfProducts,
+    unsigned long* numKept,
+    unsigned long* numRemoved);
+
+static int HasOrderingOptions(
+    const ReduceLogicOptions* options);
+
+static int UsesRedundantTermsPass(
+    const ReduceLogicOptions* options);
+
+static size_t EstimateMaxNumOfMinterms(
+    const unsigned long numVars,
+    const triLogic truthTable[],
+    const triLogic onValue,
+    const int isExpanded);
+
+static shrinquemStatus RemoveNonprimeImplicants(
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    SumOfProducts* sumOfProducts,
+    unsigned long* numKept,
+    unsigned long* numRemoved);
+
+static unsigned long CountLiterals(
+    const SumOfProducts* sumOfProducts);
+
+static void RunInParallel(
+    parallelTask task,
+    void* taskArgs[],
+    unsigned long numTasks);
+
 void FinalizeSumOfProducts(SumOfProducts* sumOfProducts)
 {
     sumOfProducts->numVars = 0;
     sumOfProducts->numTerms = 0;
+    sumOfProducts->polarity = POLARITY_SUM_OF_PRODUCTS;
+    sumOfProducts->cost = 0.0;
 
     if (sumOfProducts->terms)
     {
-        free(sumOfProducts->terms);
+        FreeMemory(sumOfProducts->terms);
         sumOfProducts->terms = NULL;
     }
 
     if (sumOfProducts->dontCares)
     {
-        free(sumOfProducts->dontCares);
+        FreeMemory(sumOfProducts->dontCares);
         sumOfProducts->dontCares = NULL;
     }
 
     if (sumOfProducts->equation)
     {
-        free(sumOfProducts->equation);
+        FreeMemory(sumOfProducts->equation);
         sumOfProducts->equation = NULL;
     }
 }
@@ -113,56 +204,474 @@ shrinquemStatus ReduceLogic(
     const triLogic truthTable[],
     SumOfProducts* sumOfProducts)
 {
-    shrinquemStatus status = STATUS_OKAY;
-    triLogic* resolved = NULL;
+    return ReduceLogicWithOptions(truthTable, sumOfProducts, NULL);
+}
 
-    // initialize and allocate
+/*************************************************************************
+ReduceLogicPOS
+Purpose - generates the minimum product-of-sums equation by minimizing the
+  complement of the truth table. The complement is never materialized: the
+  FALSE entries are simply treated as the ones to cover. The terms and
+  dontCares hold the cubes of the complement and polarity is set to
+  POLARITY_PRODUCT_OF_SUMS, which EvaluateSumOfProducts and
+  GenerateEquationString respect.
+*************************************************************************/
+
+shrinquemStatus ReduceLogicPOS(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts)
+{
+    const ReduceLogicOptions options = { .polarity = POLARITY_PRODUCT_OF_SUMS };
+    return ReduceLogicWithOptions(truthTable, sumOfProducts, &options);
+}
+
+/*************************************************************************
+ReduceLogicAuto
+Purpose - minimizes both polarities in parallel and returns whichever form
+  has fewer terms, or fewer literals when the terms are tied. The two runs
+  share the truth table and the resolved buffer; each one only marks the
+  entries it covers, so they never write the same byte.
+
+Only the expansion loops run in parallel. The irredundancy passes follow
+one after the other on the calling thread, once resolved is freed, as each
+counts the terms into a table of 2^numVars longs. Besides the truth table
+and the covers, the peak is then 2^numVars bytes for resolved during the
+loops, and the one table of counts after them, rather than two.
+*************************************************************************/
+
+shrinquemStatus ReduceLogicAuto(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts)
+{
+    shrinquemStatus status;
+    ScratchRegion resolved = { 0 };
 
-    if (truthTable == NULL)
+    status = CheckReduceLogicArguments(truthTable, sumOfProducts);
+    if (status != STATUS_OKAY)
+        return status;
+
+    SumOfProducts complement = { .numVars = sumOfProducts->numVars };
+    ReduceLogicTask tasks[2] =
     {
-        status = STATUS_NULL_ARGUMENT;
-        goto cleanupAndExit;
+        { .truthTable = truthTable, .onValue = LOGIC_TRUE, .options = &DEFAULT_OPTIONS, .sumOfProducts = sumOfProducts },
+        { .truthTable = truthTable, .onValue = LOGIC_FALSE, .options = &DEFAULT_OPTIONS, .sumOfProducts = &complement },
+    };
+    void* taskArgs[2] = { &tasks[0], &tasks[1] };
+
+    if (sumOfProducts->numVars <= SINGLE_WORD_MAX_VARS)
+    {
+        // these take less time than starting a thread
+        ReduceLogicTaskEntry(taskArgs[0]);
+        ReduceLogicTaskEntry(taskArgs[1]);
+    }
+    else
+    {
+        // both threads probe all of it, so on a machine of several NUMA nodes its pages are spread over them
+        status = AllocateScratch(NULL, ((size_t)1 << sumOfProducts->numVars) * sizeof(triLogic), 1, &resolved);
+        if (status != STATUS_OKAY)
+        {
+            sumOfProducts->numTerms = 0;
+            sumOfProducts->terms = NULL;
+            sumOfProducts->dontCares = NULL;
+            return status;
+        }
+        RecordMemoryPlacement(&resolved);
+
+        tasks[0].resolved = (triLogic*)resolved.data;
+        tasks[1].resolved = (triLogic*)resolved.data;
+        tasks[0].isIrredundancyDeferred = 1;
+        tasks[1].isIrredundancyDeferred = 1;
+        RunInParallel(ReduceLogicTaskEntry, taskArgs, 2);
+        FreeScratch(&resolved);
+
+        // each pass counts into a table the size of the truth table, so they take turns rather than hold two at once
+        for (int iTask = 0; iTask < 2; iTask++)
+        {
+            if (tasks[iTask].status == STATUS_OKAY)
+                tasks[iTask].status = RunIrredundancyPass(truthTable, tasks[iTask].onValue, &DEFAULT_OPTIONS, NULL,
+                    tasks[iTask].sumOfProducts, &tasks[iTask].numTermsKept, &tasks[iTask].numTermsRemoved);
+        }
+    }
+
+    for (int iTask = 0; iTask < 2; iTask++)
+    {
+        numTermsKept += tasks[iTask].numTermsKept;
+        numTermsRemoved += tasks[iTask].numTermsRemoved;
+    }
+
+    status = (tasks[0].status != STATUS_OKAY) ? tasks[0].status : tasks[1].status;
+    sumOfProducts->polarity = POLARITY_SUM_OF_PRODUCTS;
+
+    // keep the cheaper of the two forms, only the terms and dontCares are swapped
+    // so the caller's equation field is left alone like it is by ReduceLogic
+    if (status == STATUS_OKAY &&
+        (complement.numTerms < sumOfProducts->numTerms ||
+        (complement.numTerms == sumOfProducts->numTerms && CountLiterals(&complement) < CountLiterals(sumOfProducts))))
+    {
+        SumOfProducts swap = *sumOfProducts;
+        sumOfProducts->numTerms = complement.numTerms;
+        sumOfProducts->terms = complement.terms;
+        sumOfProducts->dontCares = complement.dontCares;
+        sumOfProducts->polarity = POLARITY_PRODUCT_OF_SUMS;
+        complement.terms = swap.terms;
+        complement.dontCares = swap.dontCares;
     }
+    else if (status != STATUS_OKAY)
+    {
+        FreeMemory(sumOfProducts->terms);
+        FreeMemory(sumOfProducts->dontCares);
+        sumOfProducts->numTerms = 0;
+        sumOfProducts->terms = NULL;
+        sumOfProducts->dontCares = NULL;
+    }
+
+    FreeMemory(complement.terms);
+    FreeMemory(complement.dontCares);
+
+    sumOfProducts->cost = (status == STATUS_OKAY) ? CoverCost(&DEFAULT_OPTIONS, sumOfProducts) : 0.0;
+
+    return status;
+}
+
+static shrinquemStatus CheckReduceLogicArguments(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts)
+{
+    if (truthTable == NULL || sumOfProducts == NULL)
+        return STATUS_NULL_ARGUMENT;
     else if (sumOfProducts->numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+    else if (sumOfProducts->numVars > MAX_NUM_VARIABLES || sumOfProducts->numVars >= sizeof(size_t) * BITS_PER_BYTE)
+        return STATUS_TOO_MANY_VARIABLES; // a truth table this large couldn't even be addressed
+
+    return STATUS_OKAY;
+}
+
+/*************************************************************************
+ReduceLogicWithOptions
+Purpose - same as ReduceLogic or ReduceLogicPOS, depending on the polarity
+  of the options, with a choice of the order minterms seed new terms and
+  the order literals are dropped from a term. Growing each term toward the
+  most uncovered ON minterms makes larger cubes early, so fewer terms are
+  made and fewer are left for RemoveNonprimeImplicants to remove. With
+  IRREDUNDANCY_ON_ENTRIES, terms only needed for DON'T CARE entries are
+  removed as well, which gives smaller covers for tables with many of them.
+  Any objective other than OBJECTIVE_TERMS does the same, dropping the most
+  expensive redundant terms first, and weights also have the heaviest
+  variables tried first. The cost of the result is put in cost. A progress
+  callback and cancel flag in the options let a long run be watched and
+  stopped, and a cancelled run returns STATUS_CANCELLED with no terms.
+*************************************************************************/
+
+shrinquemStatus ReduceLogicWithOptions(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options)
+{
+    return ReduceLogicLimited(truthTable, sumOfProducts, options, NULL, NULL);
+}
+
+/*************************************************************************
+ReduceLogicWithDeadline
+Purpose - same as ReduceLogicWithOptions, but always returns within about
+  timeLimit seconds with a correct cover, setting isComplete to nonzero
+  when the minimization got to its normal end.
+
+The cover is built up so it can be finished at any time. Every term made
+before the deadline is a full expansion, and the minterms still uncovered
+past it become terms as they are, in the single quick pass the expansion
+loop turns into. The irredundancy pass stops where it is too, keeping
+the terms it hasn't tried, since every term removed so far was covered by
+the rest. So the more time is given, the more of the cover is expanded
+terms, and with enough of it the result is exactly ReduceLogicWithOptions.
+The passes over the whole table before the expansion loop aren't cut
+short, so a table too large to be read in timeLimit takes longer.
+*************************************************************************/
+
+shrinquemStatus ReduceLogicWithDeadline(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options,
+    double timeLimit,
+    int* isComplete)
+{
+    if (isComplete == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    Deadline deadline = { GetSeconds() + timeLimit, 0 };
+    shrinquemStatus status = ReduceLogicLimited(truthTable, sumOfProducts, options, &deadline, NULL);
+    *isComplete = (status == STATUS_OKAY) && !deadline.isPassed;
+
+    return status;
+}
+
+/*************************************************************************
+ReduceLogicWithCheckpoints
+Purpose - same as ReduceLogicWithOptions, while saving the state of the
+  expansion loop to checkpointPath about every interval seconds and once
+  more when the loop is done. ResumeReduceLogic continues from the file
+  after the process is stopped, with the same result the run would have
+  had. The state is the next input of the loop, the terms so far and the
+  resolved entries, which is all the loop carries from one input to the
+  next; the irredundancy pass is short next to the loop and is rerun.
+
+Only the expansion loop of the default orders saves its state, so
+options with other seed or expansion orders, or with OBJECTIVE_WEIGHTED,
+which also takes the ordered expansion, give STATUS_INVALID_ARGUMENT.
+Functions of up to SINGLE_WORD_MAX_VARS variables are too quick to need a
+checkpoint and never write one.
+*************************************************************************/
+
+shrinquemStatus ReduceLogicWithCheckpoints(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options,
+    const char* checkpointPath,
+    double interval)
+{
+    return ReduceLogicCheckpointed(truthTable, sumOfProducts, options, checkpointPath, interval, 0);
+}
+
+shrinquemStatus ResumeReduceLogic(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options,
+    const char* checkpointPath,
+    double interval)
+{
+    return ReduceLogicCheckpointed(truthTable, sumOfProducts, options, checkpointPath, interval, 1);
+}
+
+static shrinquemStatus ReduceLogicCheckpointed(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options,
+    const char* checkpointPath,
+    double interval,
+    int isResuming)
+{
+    shrinquemStatus status = CheckReduceLogicArguments(truthTable, sumOfProducts);
+    if (status != STATUS_OKAY)
+        return status;
+    else if (checkpointPath == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (options != NULL && HasOrderingOptions(options))
+        return STATUS_INVALID_ARGUMENT;
+
+    Checkpoint checkpoint = { checkpointPath, interval, GetSeconds(), 0, isResuming };
+    if (sumOfProducts->numVars > SINGLE_WORD_MAX_VARS)
+        checkpoint.tableHash = HashTruthTable(truthTable, sumOfProducts->numVars);
+
+    return ReduceLogicLimited(truthTable, sumOfProducts, options, NULL, &checkpoint);
+}
+
+static shrinquemStatus ReduceLogicLimited(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    Checkpoint* checkpoint)
+{
+    shrinquemStatus status;
+    ScratchRegion resolved = { 0 };
+    unsigned long numKept = 0;
+    unsigned long numRemoved = 0;
+
+    status = CheckReduceLogicArguments(truthTable, sumOfProducts);
+    if (status != STATUS_OKAY)
+        return status;
+
+    if (options == NULL)
+        options = &DEFAULT_OPTIONS;
+    else if (options->objective == OBJECTIVE_WEIGHTED && options->weights == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    // small functions are minimized in registers and other orders keep their own bit sets, neither needs the resolved buffer
+    if (sumOfProducts->numVars > SINGLE_WORD_MAX_VARS && !HasOrderingOptions(options))
     {
-        status = STATUS_TOO_FEW_VARIABLES;
-        goto cleanupAndExit;
+        status = AllocateScratch(options, ((size_t)1 << sumOfProducts->numVars) * sizeof(triLogic), 0, &resolved);
+        if (status != STATUS_OKAY)
+        {
+            sumOfProducts->numTerms = 0;
+            sumOfProducts->terms = NULL;
+            sumOfProducts->dontCares = NULL;
+            return status;
+        }
+        RecordMemoryPlacement(&resolved);
     }
-    else if (sumOfProducts->numVars > MAX_NUM_VARIABLES)
+
+    triLogic onValue = (options->polarity == POLARITY_PRODUCT_OF_SUMS) ? LOGIC_FALSE : LOGIC_TRUE;
+    status = ReduceLogicCore(truthTable, onValue, options, deadline, checkpoint, (triLogic*)resolved.data, 0, sumOfProducts,
+        &numKept, &numRemoved);
+    sumOfProducts->polarity = options->polarity;
+    sumOfProducts->cost = (status == STATUS_OKAY) ? CoverCost(options, sumOfProducts) : 0.0;
+    numTermsKept += numKept;
+    numTermsRemoved += numRemoved;
+
+    FreeScratch(&resolved);
+
+    return status;
+}
+
+static void ReduceLogicTaskEntry(
+    void* args)
+{
+    ReduceLogicTask* task = (ReduceLogicTask*)args;
+
+    task->status = ReduceLogicCore(task->truthTable, task->onValue, task->options, NULL, NULL, task->resolved,
+        task->isIrredundancyDeferred, task->sumOfProducts, &task->numTermsKept, &task->numTermsRemoved);
+}
+
+/*************************************************************************
+ReduceLogicCore
+Purpose - covers every entry equal to onValue while never covering the
+  opposite value. resolved must hold 2^numVars zeroed entries, and only the
+  entries equal to onValue are written. Functions of up to
+  SINGLE_WORD_MAX_VARS variables go to ReduceLogicSingleWord, which gives
+  the same terms and doesn't use resolved. Other seed and expansion orders
+  go to ExpandTermsOrdered, which doesn't use it either. The options also
+  pick which irredundancy pass runs after the expansion, unless it is
+  deferred for the caller to run with RunIrredundancyPass. Once the deadline,
+  if any, passes, the uncovered minterms become terms without expansion.
+  With a checkpoint the loop saves its state every so often, or starts
+  from the saved state when resuming.
+*************************************************************************/
+
+static shrinquemStatus ReduceLogicCore(
+    const triLogic truthTable[],
+    const triLogic onValue,
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    Checkpoint* checkpoint,
+    triLogic resolved[],
+    const int isIrredundancyDeferred,
+    SumOfProducts* sumOfProducts,
+    unsigned long* numKept,
+    unsigned long* numRemoved)
+{
+    shrinquemStatus status = STATUS_OKAY;
+    const triLogic offValue = (onValue == LOGIC_TRUE) ? LOGIC_FALSE : LOGIC_TRUE;
+    OffSetOracle* oracle = NULL;
+    ScratchRegion termScratch = { 0 };
+    ScratchRegion dontCareScratch = { 0 };
+
+    if (HasOrderingOptions(options))
     {
-        status = STATUS_TOO_MANY_VARIABLES;
+        status = ExpandTermsOrdered(truthTable, onValue, options, deadline, sumOfProducts);
         goto cleanupAndExit;
     }
 
-    unsigned long sizeTruthtable = 1 << sumOfProducts->numVars;
-    unsigned long maxNumOfMinterms = EstimateMaxNumOfMinterms(sumOfProducts->numVars, truthTable);
+    if (sumOfProducts->numVars <= SINGLE_WORD_MAX_VARS)
+    {
+        unsigned long numWordKept = 0;
+        unsigned long numWordRemoved = 0;
+        status = ReduceLogicSingleWord(truthTable, onValue, sumOfProducts, &numWordKept, &numWordRemoved);
+
+        // the terms kept for DON'T CARE entries alone are removed by a second pass, which recounts the kept ones
+        if (status == STATUS_OKAY && UsesRedundantTermsPass(options))
+        {
+            numWordKept = 0;
+            status = RemoveRedundantTerms(truthTable, onValue, options, deadline, sumOfProducts, &numWordKept, &numWordRemoved);
+        }
+
+        *numKept += numWordKept;
+        *numRemoved += numWordRemoved;
+        return status;
+    }
+
+    // initialize and allocate
+
+    cube64 sizeTruthtable = CUBE64_BIT(sumOfProducts->numVars);
+    size_t maxNumOfMinterms = EstimateMaxNumOfMinterms(sumOfProducts->numVars, truthTable, onValue, deadline == NULL);
     sumOfProducts->numTerms = 0;
     sumOfProducts->terms = NULL; // the caller should not have allocated any memory
     sumOfProducts->dontCares = NULL; // the caller should not have allocated any memory
-    resolved = calloc(sizeTruthtable, sizeof(triLogic));
-    sumOfProducts->terms = malloc(maxNumOfMinterms * sizeof(long));
-    sumOfProducts->dontCares = malloc(maxNumOfMinterms * sizeof(long));
 
-    if (resolved == NULL || sumOfProducts->terms == NULL || sumOfProducts->dontCares == NULL)
+    // out of core the estimate can be far more than memory, so the terms grow in the scratch files and are copied out after
+    if (options->scratchDirectory != NULL)
+    {
+        status = AllocateScratch(options, maxNumOfMinterms * sizeof(cube64), 0, &termScratch);
+        if (status == STATUS_OKAY)
+            status = AllocateScratch(options, maxNumOfMinterms * sizeof(cube64), 0, &dontCareScratch);
+        if (status != STATUS_OKAY)
+            goto cleanupAndExit;
+
+        sumOfProducts->terms = termScratch.data;
+        sumOfProducts->dontCares = dontCareScratch.data;
+    }
+    else
+    {
+        sumOfProducts->terms = AllocateMemory(maxNumOfMinterms * sizeof(cube64));
+        sumOfProducts->dontCares = AllocateMemory(maxNumOfMinterms * sizeof(cube64));
+    }
+
+    if (sumOfProducts->terms == NULL || sumOfProducts->dontCares == NULL)
     {
         status = STATUS_OUT_OF_MEMORY;
         goto cleanupAndExit;
     }
 
+    cube64 firstInput = 0;
+    if (checkpoint != NULL && checkpoint->isResuming)
+    {
+        status = LoadCheckpoint(checkpoint, sumOfProducts, maxNumOfMinterms, onValue, resolved, &firstInput);
+        if (status != STATUS_OKAY)
+            goto cleanupAndExit;
+    }
+
+    // when the oracle can't be created the cubes are probed below as before, and past the deadline nothing is probed
+    if (!IsPastDeadline(deadline))
+        oracle = CreateOffSetOracle(truthTable, sumOfProducts->numVars, offValue, OFFSET_ORACLE_MEMORY_BUDGET);
+
     // loop through each entry in the truth table and derive the terms for the reduced logic
-    for (unsigned long iInput = 0; iInput < sizeTruthtable; iInput++)
+    for (cube64 iInput = firstInput; iInput < sizeTruthtable; iInput++)
     {
-        if ((truthTable[iInput] == LOGIC_TRUE) && !resolved[iInput])
+        if ((iInput & (PROGRESS_MINTERM_INTERVAL - 1)) == 0)
+        {
+            if (checkpoint != NULL && iInput != firstInput && GetSeconds() - checkpoint->lastSaved >= checkpoint->interval)
+            {
+                status = SaveCheckpoint(checkpoint, sumOfProducts, onValue, resolved, iInput);
+                if (status != STATUS_OKAY)
+                    goto cleanupAndExit;
+            }
+
+            status = ReportProgress(options, PROGRESS_PHASE_EXPANDING, iInput, sizeTruthtable, sumOfProducts->numTerms);
+            if (status != STATUS_OKAY)
+                goto cleanupAndExit;
+        }
+
+        // out of core the next block of both arrays is read ahead while this one is worked on
+        if ((iInput & (SCRATCH_BLOCK_ENTRIES - 1)) == 0 && options->scratchDirectory != NULL)
+        {
+            AdviseScratchBlock(truthTable, (size_t)sizeTruthtable, (size_t)(iInput + SCRATCH_BLOCK_ENTRIES), (size_t)SCRATCH_BLOCK_ENTRIES);
+            AdviseScratchBlock(resolved, (size_t)sizeTruthtable, (size_t)(iInput + SCRATCH_BLOCK_ENTRIES), (size_t)SCRATCH_BLOCK_ENTRIES);
+        }
+
+        if ((iInput & (DEADLINE_MINTERM_INTERVAL - 1)) == 0)
+            IsPastDeadline(deadline);
+
+        if ((truthTable[iInput] == onValue) && !resolved[iInput])
         {
             unsigned long iTerm = sumOfProducts->numTerms;
             sumOfProducts->numTerms++;
             sumOfProducts->terms[iTerm] = iInput; // the term starts out equal to the minterm 
             sumOfProducts->dontCares[iTerm] = 0;  // initially there are no "don't cares"
 
+            // past the deadline the minterm is a term of its own, and no entry after it needs marking
+            if (deadline != NULL && deadline->isPassed)
+                continue;
+
             // loop through each bit to see if it can be replaced by a "don't care"
             for (unsigned long iBitTest = 0; iBitTest < sumOfProducts->numVars; iBitTest++)
             {
-                unsigned long bitMaskTest = 1 << iBitTest;
+                cube64 bitMaskTest = CUBE64_BIT(iBitTest);
+                if (oracle != NULL)
+                {
+                    if (!CubeHasOffValue(oracle, sumOfProducts->terms[iTerm] ^ bitMaskTest, sumOfProducts->dontCares[iTerm]))
+                        sumOfProducts->dontCares[iTerm] |= bitMaskTest;
+                    continue;
+                }
+
                 sumOfProducts->terms[iTerm] ^= bitMaskTest;
                 // test all minterms associated with the term by checking all the "don't care" combinations
                 // start by clearing all "don't care" bits
@@ -170,7 +679,7 @@ shrinquemStatus ReduceLogic(
 
                 while (1)
                 {
-                    if (truthTable[sumOfProducts->terms[iTerm]] == LOGIC_FALSE)
+                    if (truthTable[sumOfProducts->terms[iTerm]] == offValue)
                     {
                         // we can't replace this variable with a don't care, so flip the bit back and exit
                         sumOfProducts->terms[iTerm] ^= bitMaskTest;
@@ -181,7 +690,7 @@ shrinquemStatus ReduceLogic(
                     unsigned long iBitDC;
                     for (iBitDC = 0; iBitDC < iBitTest; iBitDC++)
                     {
-                        unsigned long bitMaskDC = 1 << iBitDC;
+                        cube64 bitMaskDC = CUBE64_BIT(iBitDC);
                         if (sumOfProducts->dontCares[iTerm] & bitMaskDC)
                         {
                             if (sumOfProducts->terms[iTerm] & bitMaskDC)
@@ -207,18 +716,21 @@ shrinquemStatus ReduceLogic(
 
             // At this point, we have expanded the term to cover as many minterms as possible.
             // Now go through all minterms associated with this term to mark them as resolved.
+            // Only the entries we have to cover are marked, the others are never looked at,
+            // and neither are the ones behind the loop, so the pages already passed stay untouched.
             // Start by clearing all "don't care" bits.
             sumOfProducts->terms[iTerm] &= ~(sumOfProducts->dontCares[iTerm]);
 
             while (1)
             {
-                resolved[sumOfProducts->terms[iTerm]] = LOGIC_TRUE;
+                if (sumOfProducts->terms[iTerm] > iInput && truthTable[sumOfProducts->terms[iTerm]] == onValue)
+                    resolved[sumOfProducts->terms[iTerm]] = LOGIC_TRUE;
 
                 // get the next minterm to set as resolved
                 unsigned long iBitDC;
                 for (iBitDC = 0; iBitDC < sumOfProducts->numVars; iBitDC++)
                 {
-                    unsigned long bitMaskDC = 1 << iBitDC;
+                    cube64 bitMaskDC = CUBE64_BIT(iBitDC);
                     if (sumOfProducts->dontCares[iTerm] & bitMaskDC)
                     {
                         if (sumOfProducts->terms[iTerm] & bitMaskDC)
@@ -241,24 +753,55 @@ shrinquemStatus ReduceLogic(
         }
     }
 
+    // the loop is the long part, so a run stopped in the irredundancy pass resumes right after it
+    if (checkpoint != NULL && firstInput != sizeTruthtable)
+    {
+        status = SaveCheckpoint(checkpoint, sumOfProducts, onValue, resolved, sizeTruthtable);
+        if (status != STATUS_OKAY)
+            goto cleanupAndExit;
+    }
+
+    status = ReportProgress(options, PROGRESS_PHASE_EXPANDING, sizeTruthtable, sizeTruthtable, sumOfProducts->numTerms);
+
 cleanupAndExit:
 
-    if (resolved)
+    DestroyOffSetOracle(oracle);
+
+    if (termScratch.data != NULL || dontCareScratch.data != NULL)
     {
-        free(resolved);
-        resolved = NULL;
+        // the cover goes back in memory the caller frees, so it is copied out of the scratch files
+        sumOfProducts->terms = NULL;
+        sumOfProducts->dontCares = NULL;
+        if (status == STATUS_OKAY && sumOfProducts->numTerms > 0)
+        {
+            sumOfProducts->terms = AllocateMemory(sumOfProducts->numTerms * sizeof(cube64));
+            sumOfProducts->dontCares = AllocateMemory(sumOfProducts->numTerms * sizeof(cube64));
+            if (sumOfProducts->terms == NULL || sumOfProducts->dontCares == NULL)
+            {
+                status = STATUS_OUT_OF_MEMORY;
+            }
+            else
+            {
+                memcpy(sumOfProducts->terms, termScratch.data, sumOfProducts->numTerms * sizeof(cube64));
+                memcpy(sumOfProducts->dontCares, dontCareScratch.data, sumOfProducts->numTerms * sizeof(cube64));
+            }
+        }
+
+        FreeScratch(&termScratch);
+        FreeScratch(&dontCareScratch);
     }
 
     if (status == STATUS_OKAY)
     {
         // we're just making these buffers smaller so it should never fail, but ignore the case that it does
         void* p;
-        p = realloc(sumOfProducts->terms, sumOfProducts->numTerms * sizeof(long));
+        p = ReallocateMemory(sumOfProducts->terms, sumOfProducts->numTerms * sizeof(cube64));
         sumOfProducts->terms = (p || sumOfProducts->numTerms == 0) ? p : sumOfProducts->terms;
-        p = realloc(sumOfProducts->dontCares, sumOfProducts->numTerms * sizeof(long));
+        p = ReallocateMemory(sumOfProducts->dontCares, sumOfProducts->numTerms * sizeof(cube64));
         sumOfProducts->dontCares = (p || sumOfProducts->numTerms == 0) ? p : sumOfProducts->dontCares;
 
-        RemoveNonprimeImplicants(sumOfProducts);
+        if (!isIrredundancyDeferred)
+            status = RunIrredundancyPass(truthTable, onValue, options, deadline, sumOfProducts, numKept, numRemoved);
     }
 
     if (status != STATUS_OKAY)
@@ -268,13 +811,13 @@ cleanupAndExit:
 
         if (sumOfProducts->terms)
         {
-            free(sumOfProducts->terms);
+            FreeMemory(sumOfProducts->terms);
             sumOfProducts->terms = NULL;
         }
 
         if (sumOfProducts->dontCares)
         {
-            free(sumOfProducts->dontCares);
+            FreeMemory(sumOfProducts->dontCares);
             sumOfProducts->dontCares = NULL;
         }
     }
@@ -285,31 +828,57 @@ cleanupAndExit:
 /*************************************************************************
 GenerateEquationString
 Purpose - generates a null-terminated string representation of the
-  minimum sum-of-products equation generated by the ReduceLogic function
+  minimum sum-of-products equation generated by the ReduceLogic function,
+  or of the product-of-sums, like (A + B')C, from ReduceLogicPOS
 *************************************************************************/
 
 shrinquemStatus GenerateEquationString(
     SumOfProducts* sumOfProducts,
     const char** const varNames)
+{
+    const char* separator = (sumOfProducts->polarity == POLARITY_PRODUCT_OF_SUMS) ? "" : " + ";
+    return GenerateTermsString(sumOfProducts, varNames, separator);
+}
+
+/*************************************************************************
+GenerateTermsString
+Purpose - generates the equation string of the terms joined by separator,
+  which is " + " for a sum-of-products and " ^ " for an exclusive one. For a
+  product-of-sums the literals of each term are complemented and joined by
+  " + ", with parentheses when the product has more than one sum.
+*************************************************************************/
+
+shrinquemStatus GenerateTermsString(
+    SumOfProducts* sumOfProducts,
+    const char** const varNames,
+    const char* separator)
 {
     unsigned long iVar;
     unsigned long iTerm;
-    unsigned long bitMask;
+    cube64 bitMask;
     char** varNamesAuto = NULL;
     const char** varNamesToUse = NULL;
     size_t* varNameSizes = NULL;
 
+    // a product-of-sums describes the complement, so its constants and literals are inverted
+    const char isProductOfSums = (sumOfProducts->polarity == POLARITY_PRODUCT_OF_SUMS);
+    const char noTermsConstant = isProductOfSums ? '1' : '0';
+    const char noLiteralsConstant = isProductOfSums ? '0' : '1';
+    const char* literalSeparator = isProductOfSums ? " + " : "";
+    const size_t literalSeparatorSize = strlen(literalSeparator);
+    const char isParenthesized = isProductOfSums && (sumOfProducts->numTerms > 1);
+
     // the caller should not have allocated any memory for the equation
     sumOfProducts->equation = NULL;
 
     // first check for the case where the equation is '0'
     if (sumOfProducts->numTerms <= 0)
     {
-        sumOfProducts->equation = (char*)malloc(2 * sizeof(char));
+        sumOfProducts->equation = (char*)AllocateMemory(2 * sizeof(char));
         if (sumOfProducts->equation == NULL)
             return STATUS_OUT_OF_MEMORY;
 
-        sumOfProducts->equation[0] = '0';
+        sumOfProducts->equation[0] = noTermsConstant;
         sumOfProducts->equation[1] = 0;
         return STATUS_OKAY;
     }
@@ -319,7 +888,7 @@ shrinquemStatus GenerateEquationString(
     {
         for (iVar = 0; iVar < sumOfProducts->numVars; iVar++)
         {
-            bitMask = 1 << iVar;
+            bitMask = CUBE64_BIT(iVar);
             if ((sumOfProducts->dontCares[0] & bitMask) == 0)
             {
                 break;
@@ -328,10 +897,10 @@ shrinquemStatus GenerateEquationString(
 
         if (iVar == sumOfProducts->numVars)
         {
-            sumOfProducts->equation = (char*)malloc(2 * sizeof(char));
+            sumOfProducts->equation = (char*)AllocateMemory(2 * sizeof(char));
             if (sumOfProducts->equation == NULL)
                 return STATUS_OUT_OF_MEMORY;
-            sumOfProducts->equation[0] = '1';
+            sumOfProducts->equation[0] = noLiteralsConstant;
             sumOfProducts->equation[1] = 0;
             return STATUS_OKAY;
         }
@@ -344,7 +913,7 @@ shrinquemStatus GenerateEquationString(
     }
     else
     {
-        varNamesAuto = (char**)malloc(sumOfProducts->numVars * sizeof(char*));
+        varNamesAuto = (char**)AllocateMemory(sumOfProducts->numVars * sizeof(char*));
         varNamesToUse = varNamesAuto;
         if (varNamesAuto == NULL)
             return STATUS_OUT_OF_MEMORY;
@@ -358,7 +927,7 @@ shrinquemStatus GenerateEquationString(
         {
             if (varNamesAuto[iVar] == NULL)
             {
-                varNamesAuto[iVar] = (char*)malloc(2 * sizeof(char));
+                varNamesAuto[iVar] = (char*)AllocateMemory(2 * sizeof(char));
                 if (varNamesAuto[iVar] == 0)
                     return STATUS_OUT_OF_MEMORY;
                 (varNamesAuto[iVar])[0] = 'A' + (char)iVar;
@@ -368,7 +937,7 @@ shrinquemStatus GenerateEquationString(
     }
 
     // first calculate the size of the string names for the variables
-    varNameSizes = (size_t*)malloc(sizeof(long*) * sumOfProducts->numVars);
+    varNameSizes = (size_t*)AllocateMemory(sizeof(long*) * sumOfProducts->numVars);
     if (varNameSizes == NULL)
         return STATUS_OUT_OF_MEMORY;
 
@@ -379,25 +948,40 @@ shrinquemStatus GenerateEquationString(
 
     // now run through the equation to determine the length of the output string
     size_t outputSize = 0;
+    size_t separatorSize = strlen(separator);
 
     for (iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
     {
+        size_t termSize = 0;
+        unsigned long numLiterals = 0;
         for (iVar = 0; iVar < sumOfProducts->numVars; iVar++)
         {
-            bitMask = 1 << (sumOfProducts->numVars - iVar - 1);
+            bitMask = CUBE64_BIT(sumOfProducts->numVars - iVar - 1);
             if ((sumOfProducts->dontCares[iTerm] & bitMask) == 0)
             {
-                outputSize += varNameSizes[iVar];
-                if ((sumOfProducts->terms[iTerm] & bitMask) == 0)
+                termSize += varNameSizes[iVar];
+                if (((sumOfProducts->terms[iTerm] & bitMask) == 0) != isProductOfSums)
                 {
-                    outputSize++;
+                    termSize++;
+                }
+                if (numLiterals++ > 0)
+                {
+                    termSize += literalSeparatorSize;
                 }
             }
         }
 
+        if (isParenthesized && numLiterals > 1)
+        {
+            termSize += 2;
+        }
+
+        // a term without literals is a constant, which only an exclusive sum can hold next to other terms
+        outputSize += (termSize > 0) ? termSize : 1;
+
         if (iTerm < (sumOfProducts->numTerms - 1))
         {
-            outputSize += 3; // account for the " + "
+            outputSize += separatorSize; // account for the separator
         }
         else
         {
@@ -406,7 +990,7 @@ shrinquemStatus GenerateEquationString(
     }
 
     // allocate space for the equation
-    sumOfProducts->equation = (char*)malloc(outputSize * sizeof(char*));
+    sumOfProducts->equation = (char*)AllocateMemory(outputSize * sizeof(char*));
     if (sumOfProducts->equation == NULL)
         return STATUS_OUT_OF_MEMORY;
 
@@ -414,30 +998,59 @@ shrinquemStatus GenerateEquationString(
     unsigned long iEquPos = 0;
     for (iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
     {
+        unsigned long iTermStart = iEquPos;
+        unsigned long numLiterals = 0;
+        cube64 careMask = ~sumOfProducts->dontCares[iTerm] & CUBE64_ALL_VARS(sumOfProducts->numVars);
+        char hasParentheses = isParenthesized && (careMask & (careMask - 1));
+
+        if (hasParentheses)
+        {
+            sumOfProducts->equation[iEquPos++] = '(';
+        }
+
         for (iVar = 0; iVar < sumOfProducts->numVars; iVar++)
         {
-            bitMask = 1 << (sumOfProducts->numVars - iVar - 1);
+            bitMask = CUBE64_BIT(sumOfProducts->numVars - iVar - 1);
             if ((sumOfProducts->dontCares[iTerm] & bitMask) == 0)
             {
+                if (numLiterals++ > 0)
+                {
+                    for (size_t iCharPos = 0; iCharPos < literalSeparatorSize; iCharPos++)
+                    {
+                        sumOfProducts->equation[iEquPos++] = literalSeparator[iCharPos];
+                    }
+                }
+
                 // copy the variable name
                 for (unsigned long iCharPos = 0; iCharPos < varNameSizes[iVar]; iCharPos++)
                 {
                     sumOfProducts->equation[iEquPos++] = (varNamesToUse[iVar])[iCharPos];
                 }
 
-                // place the complement sign of false
-                if ((sumOfProducts->terms[iTerm] & bitMask) == 0)
+                // place the complement sign of false, or of true in a sum of the complement
+                if (((sumOfProducts->terms[iTerm] & bitMask) == 0) != isProductOfSums)
                 {
                     sumOfProducts->equation[iEquPos++] = '\'';
                 }
             }
         }
 
+        if (hasParentheses)
+        {
+            sumOfProducts->equation[iEquPos++] = ')';
+        }
+
+        if (iEquPos == iTermStart)
+        {
+            sumOfProducts->equation[iEquPos++] = noLiteralsConstant;
+        }
+
         if (iTerm < (sumOfProducts->numTerms - 1))
         {
-            sumOfProducts->equation[iEquPos++] = ' ';
-            sumOfProducts->equation[iEquPos++] = '+';
-            sumOfProducts->equation[iEquPos++] = ' ';
+            for (size_t iCharPos = 0; iCharPos < separatorSize; iCharPos++)
+            {
+                sumOfProducts->equation[iEquPos++] = separator[iCharPos];
+            }
         }
         else
         {
@@ -451,21 +1064,21 @@ shrinquemStatus GenerateEquationString(
         {
             if (varNamesAuto[iVar] != NULL)
             {
-                free(varNamesAuto[iVar]);
+                FreeMemory(varNamesAuto[iVar]);
                 varNamesAuto[iVar] = NULL;
             }
         }
 
         if (varNamesAuto)
         {
-            free(varNamesAuto);
+            FreeMemory(varNamesAuto);
             varNamesAuto = NULL;
         }
     }
 
     if (varNameSizes)
     {
-        free(varNameSizes);
+        FreeMemory(varNameSizes);
         varNameSizes = NULL;
     }
 
@@ -480,21 +1093,24 @@ Purpose - evaluates the sum-of-products produced by ReduceLogic given
 
 triLogic EvaluateSumOfProducts(
     const SumOfProducts sumOfProducts,
-    const unsigned long input)
+    const cube64 input)
 {
     // clear out bits that might be set in the input which are beyond the number of variables we are evaluating
-    const unsigned long inputMask = (1 << sumOfProducts.numVars) - 1;
-    unsigned long constrainedInput = input & inputMask;
+    const cube64 inputMask = CUBE64_ALL_VARS(sumOfProducts.numVars);
+    cube64 constrainedInput = input & inputMask;
+
+    // a product-of-sums holds the cubes of the complement, so its result is inverted
+    const triLogic covered = (sumOfProducts.polarity == POLARITY_PRODUCT_OF_SUMS) ? LOGIC_FALSE : LOGIC_TRUE;
 
     for (unsigned long iTerm = 0; iTerm < sumOfProducts.numTerms; iTerm++)
     {
         // one TRUE product term makes the whole sum-of-products TRUE
         if ((constrainedInput | sumOfProducts.dontCares[iTerm]) == (sumOfProducts.terms[iTerm] | sumOfProducts.dontCares[iTerm]))
-            return LOGIC_TRUE;
+            return covered;
     }
 
     // no product terms were true, so the whole equation is false
-    return LOGIC_FALSE;
+    return !covered;
 }
 
 void ResetTermCounters()
@@ -514,53 +1130,120 @@ unsigned long GetNumTermsRemoved()
 }
 
 
-static unsigned long EstimateMaxNumOfMinterms(
+// the pass the options pick, which leaves the cover to the caller to free when it fails
+static shrinquemStatus RunIrredundancyPass(
+    const triLogic truthTable[],
+    const triLogic onValue,
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    SumOfProducts* sumOfProducts,
+    unsigned long* numKept,
+    unsigned long* numRemoved)
+{
+    if (UsesRedundantTermsPass(options))
+        return RemoveRedundantTerms(truthTable, onValue, options, deadline, sumOfProducts, numKept, numRemoved);
+
+    return RemoveNonprimeImplicants(options, deadline, sumOfProducts, numKept, numRemoved);
+}
+
+// returns nonzero when the options ask for other orders than the ones of ReduceLogicCore, weights reorder the variables
+static int HasOrderingOptions(
+    const ReduceLogicOptions* options)
+{
+    return options->seeding != SEED_ORDER_ASCENDING || options->expansion != EXPAND_ORDER_FIXED ||
+        options->objective == OBJECTIVE_WEIGHTED;
+}
+
+// returns nonzero when the terms are made irredundant by cost with RemoveRedundantTerms, which any objective
+// other than the number of terms needs, since a term kept for a DON'T CARE entry alone only adds to the cost
+static int UsesRedundantTermsPass(
+    const ReduceLogicOptions* options)
+{
+    return options->irredundancy == IRREDUNDANCY_ON_ENTRIES || options->objective != OBJECTIVE_TERMS;
+}
+
+// a deadline can leave minterms unexpanded, so isExpanded is zero when there is one and the bound is just the ON entries
+static size_t EstimateMaxNumOfMinterms(
     const unsigned long numVars,
-    const triLogic truthTable[])
+    const triLogic truthTable[],
+    const triLogic onValue,
+    const int isExpanded)
 {
     // the maximum possible number of minterms is when the truth table has alternating zeros and ones, like a checkerboard.
-    unsigned long sizeTruthtable = 1 << numVars;
-    unsigned long maximumPossibleNumOfMinterms = sizeTruthtable / 2;
+    cube64 sizeTruthtable = CUBE64_BIT(numVars);
+    cube64 maximumPossibleNumOfMinterms = sizeTruthtable / 2;
 
     // We know the final equation will have less than or equal to the non-zero minterms in the truth table.
     // Count them up so we can see if this is less.
-    unsigned long numTrueMinterms = 0;
-    for (unsigned long iInput = 0; iInput < sizeTruthtable; iInput++)
+    cube64 numTrueMinterms = 0;
+    for (cube64 iInput = 0; iInput < sizeTruthtable; iInput++)
     {
-        if (truthTable[iInput] == LOGIC_TRUE)
+        if (truthTable[iInput] == onValue)
         {
             numTrueMinterms++;
         }
     }
 
-    return min(maximumPossibleNumOfMinterms, numTrueMinterms);
+    return (size_t)((numTrueMinterms < maximumPossibleNumOfMinterms || !isExpanded) ? numTrueMinterms : maximumPossibleNumOfMinterms);
 }
 
 /*************************************************************************
 RemoveNonprimeImplicants
-Purpose - removes terms which are non-prime implicants.
+Purpose - removes terms which are non-prime implicants. The number of terms
+  kept and removed are returned rather than added to the global counters so
+  that two minimizations can run at the same time. Progress is reported
+  over the two passes, the counting one and the removing one. Once the
+  deadline passes, the terms not tried yet are all kept.
 *************************************************************************/
 
-static void RemoveNonprimeImplicants(
-    SumOfProducts* sumOfProducts)
+static shrinquemStatus RemoveNonprimeImplicants(
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    SumOfProducts* sumOfProducts,
+    unsigned long* numKept,
+    unsigned long* numRemoved)
 {
+    ScratchRegion refCntScratch = { 0 };
     unsigned long* refCntTable;
-    unsigned long sizeTruthtable;
+    cube64 sizeTruthtable;
     unsigned long numOldTerms;
     unsigned long iOldTerm;
     unsigned long iNewTerm;
-    unsigned long bitMaskDC;
+    cube64 bitMaskDC;
     char isPrime;
 
     numOldTerms = sumOfProducts->numTerms;
 
-    sizeTruthtable = 1 << sumOfProducts->numVars; // the truth table has 2^numVars elements
+    sizeTruthtable = CUBE64_BIT(sumOfProducts->numVars); // the truth table has 2^numVars elements
+
+    if (IsPastDeadline(deadline))
+    {
+        *numKept += numOldTerms;
+        return STATUS_OKAY;
+    }
 
-    refCntTable = (long*)calloc(sizeTruthtable, sizeof(long));
+    shrinquemStatus status = AllocateScratch(options, (size_t)sizeTruthtable * sizeof(long), 0, &refCntScratch);
+    if (status != STATUS_OKAY)
+        return status;
+    refCntTable = (unsigned long*)refCntScratch.data;
 
     // loop through each term and ref count the minterms that the term covers
     for (iOldTerm = 0; iOldTerm < numOldTerms; iOldTerm++)
     {
+        if ((iOldTerm & (PROGRESS_TERM_INTERVAL - 1)) == 0 &&
+            ReportProgress(options, PROGRESS_PHASE_IRREDUNDANT, iOldTerm, 2 * (cube64)numOldTerms, numOldTerms) != STATUS_OKAY)
+        {
+            FreeScratch(&refCntScratch);
+            return STATUS_CANCELLED;
+        }
+
+        if ((iOldTerm & (DEADLINE_TERM_INTERVAL - 1)) == 0 && IsPastDeadline(deadline))
+        {
+            FreeScratch(&refCntScratch);
+            *numKept += numOldTerms;
+            return STATUS_OKAY;
+        }
+
         // start by clearing all the don't care bits
         sumOfProducts->terms[iOldTerm] &= ~(sumOfProducts->dontCares[iOldTerm]);
 
@@ -572,7 +1255,7 @@ static void RemoveNonprimeImplicants(
             unsigned long iBitDC;
             for (iBitDC = 0; iBitDC < sumOfProducts->numVars; iBitDC++)
             {
-                bitMaskDC = 1 << iBitDC;
+                bitMaskDC = CUBE64_BIT(iBitDC);
                 if (sumOfProducts->dontCares[iOldTerm] & bitMaskDC)
                 {
                     if (sumOfProducts->terms[iOldTerm] & bitMaskDC)
@@ -596,6 +1279,25 @@ static void RemoveNonprimeImplicants(
     // now loop through each term again and remove terms if all its minterms are ref counted more than once
     for (iNewTerm = iOldTerm = 0; iOldTerm < numOldTerms; iOldTerm++)
     {
+        if ((iOldTerm & (PROGRESS_TERM_INTERVAL - 1)) == 0 &&
+            ReportProgress(options, PROGRESS_PHASE_IRREDUNDANT, (cube64)numOldTerms + iOldTerm, 2 * (cube64)numOldTerms, sumOfProducts->numTerms) != STATUS_OKAY)
+        {
+            FreeScratch(&refCntScratch);
+            return STATUS_CANCELLED;
+        }
+
+        if ((iOldTerm & (DEADLINE_TERM_INTERVAL - 1)) == 0 && IsPastDeadline(deadline))
+        {
+            // every term removed so far is covered by the others, so the rest are kept as they are
+            for (; iOldTerm < numOldTerms; iOldTerm++, iNewTerm++)
+            {
+                sumOfProducts->terms[iNewTerm] = sumOfProducts->terms[iOldTerm];
+                sumOfProducts->dontCares[iNewTerm] = sumOfProducts->dontCares[iOldTerm];
+                (*numKept)++;
+            }
+            break;
+        }
+
         isPrime = 0;
         sumOfProducts->terms[iOldTerm] &= ~(sumOfProducts->dontCares[iOldTerm]); // clear all the don't care bits
 
@@ -612,7 +1314,7 @@ static void RemoveNonprimeImplicants(
             unsigned long iBitDC;
             for (iBitDC = 0; iBitDC < sumOfProducts->numVars; iBitDC++)
             {
-                bitMaskDC = 1 << iBitDC;
+                bitMaskDC = CUBE64_BIT(iBitDC);
                 if (sumOfProducts->dontCares[iOldTerm] & bitMaskDC)
                 {
                     if (sumOfProducts->terms[iOldTerm] & bitMaskDC)
@@ -641,13 +1343,13 @@ static void RemoveNonprimeImplicants(
                 sumOfProducts->dontCares[iNewTerm] = sumOfProducts->dontCares[iOldTerm];
             }
             iNewTerm++;
-            numTermsKept++;
+            (*numKept)++;
         }
         else
         {
             // this term is a non-prime implicant and will not be kept
             sumOfProducts->numTerms--;
-            numTermsRemoved++;
+            (*numRemoved)++;
 
             // de-ref count this term's minterms
             sumOfProducts->terms[iOldTerm] &= ~(sumOfProducts->dontCares[iOldTerm]);
@@ -659,7 +1361,7 @@ static void RemoveNonprimeImplicants(
                 unsigned long iBitDC;
                 for (iBitDC = 0; iBitDC < sumOfProducts->numVars; iBitDC++)
                 {
-                    bitMaskDC = 1 << iBitDC;
+                    bitMaskDC = CUBE64_BIT(iBitDC);
                     if (sumOfProducts->dontCares[iOldTerm] & bitMaskDC)
                     {
                         if (sumOfProducts->terms[iOldTerm] & bitMaskDC)
@@ -681,15 +1383,179 @@ static void RemoveNonprimeImplicants(
         }
     }
 
-    free(refCntTable);
+    FreeScratch(&refCntScratch);
 
     if (sumOfProducts->numTerms != numOldTerms)
     {
         // we're just making these buffers smaller so it should never fail, but ignore the case that it does
         void* p;
-        p = realloc(sumOfProducts->terms, sumOfProducts->numTerms * sizeof(long));
+        p = ReallocateMemory(sumOfProducts->terms, sumOfProducts->numTerms * sizeof(cube64));
         sumOfProducts->terms = (p || sumOfProducts->numTerms == 0) ? p : sumOfProducts->terms;
-        p = realloc(sumOfProducts->dontCares, sumOfProducts->numTerms * sizeof(long));
+        p = ReallocateMemory(sumOfProducts->dontCares, sumOfProducts->numTerms * sizeof(cube64));
         sumOfProducts->dontCares = (p || sumOfProducts->numTerms == 0) ? p : sumOfProducts->dontCares;
     }
+
+    return ReportProgress(options, PROGRESS_PHASE_IRREDUNDANT, 2 * (cube64)numOldTerms, 2 * (cube64)numOldTerms, sumOfProducts->numTerms);
+}
+
+/*************************************************************************
+GetSeconds
+Purpose - a monotonic clock in seconds for the deadlines, its start is
+  arbitrary so only differences mean anything
+*************************************************************************/
+
+double GetSeconds(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+// returns nonzero once the deadline has passed, and keeps returning it so a run never goes back to expanding
+int IsPastDeadline(
+    Deadline* deadline)
+{
+    if (deadline == NULL)
+        return 0;
+
+    if (!deadline->isPassed && GetSeconds() >= deadline->seconds)
+        deadline->isPassed = 1;
+
+    return deadline->isPassed;
+}
+
+/*************************************************************************
+ReportProgress
+Purpose - calls the progress callback of the options, if any, and then
+  returns STATUS_CANCELLED when the cancel flag is set, so the callback
+  itself can stop the minimization. The loops call it every
+  PROGRESS_MINTERM_INTERVAL minterms or PROGRESS_TERM_INTERVAL terms.
+*************************************************************************/
+
+shrinquemStatus ReportProgress(
+    const ReduceLogicOptions* options,
+    progressPhase phase,
+    cube64 numProcessed,
+    cube64 numTotal,
+    unsigned long numTerms)
+{
+    if (options->progress != NULL)
+    {
+        ReduceLogicProgress progress = { phase, numProcessed, numTotal, numTerms };
+        options->progress(&progress, options->progressContext);
+    }
+
+    return (options->cancel != NULL && *options->cancel) ? STATUS_CANCELLED : STATUS_OKAY;
+}
+
+/*************************************************************************
+CountLiterals
+Purpose - counts the literals over all terms, used to break ties between
+  the two polarities
+*************************************************************************/
+
+static unsigned long CountLiterals(
+    const SumOfProducts* sumOfProducts)
+{
+    const cube64 varMask = CUBE64_ALL_VARS(sumOfProducts->numVars);
+    unsigned long numLiterals = 0;
+
+    for (unsigned long iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
+    {
+        for (cube64 care = ~sumOfProducts->dontCares[iTerm] & varMask; care; care &= care - 1)
+        {
+            numLiterals++;
+        }
+    }
+
+    return numLiterals;
+}
+
+/*************************************************************************
+RunInParallel
+Purpose - runs each task on its own thread and waits for all of them. If a
+  thread can't be created, that task runs on the calling thread instead, so
+  the results never depend on threads being available.
+*************************************************************************/
+
+#if defined(_WIN32)
+
+static unsigned __stdcall ParallelTaskThread(
+    void* args)
+{
+    void** taskAndArgs = (void**)args;
+    ((parallelTask)taskAndArgs[0])(taskAndArgs[1]);
+    return 0;
+}
+
+static void RunInParallel(
+    parallelTask task,
+    void* taskArgs[],
+    unsigned long numTasks)
+{
+    HANDLE threads[MAX_PARALLEL_TASKS];
+    void* threadArgs[MAX_PARALLEL_TASKS][2];
+
+    for (unsigned long iTask = 0; iTask < numTasks; iTask++)
+    {
+        threadArgs[iTask][0] = (void*)task;
+        threadArgs[iTask][1] = taskArgs[iTask];
+        threads[iTask] = (HANDLE)_beginthreadex(NULL, 0, ParallelTaskThread, threadArgs[iTask], 0, NULL);
+        if (threads[iTask] == 0)
+            task(taskArgs[iTask]);
+    }
+
+    for (unsigned long iTask = 0; iTask < numTasks; iTask++)
+    {
+        if (threads[iTask] != 0)
+        {
+            WaitForSingleObject(threads[iTask], INFINITE);
+            CloseHandle(threads[iTask]);
+        }
+    }
+}
+
+#else
+
+static void* ParallelTaskThread(
+    void* args)
+{
+    void** taskAndArgs = (void**)args;
+    ((parallelTask)taskAndArgs[0])(taskAndArgs[1]);
+    return NULL;
 }
+
+static void RunInParallel(
+    parallelTask task,
+    void* taskArgs[],
+    unsigned long numTasks)
+{
+    pthread_t threads[MAX_PARALLEL_TASKS];
+    char isStarted[MAX_PARALLEL_TASKS];
+    void* threadArgs[MAX_PARALLEL_TASKS][2];
+
+    for (unsigned long iTask = 0; iTask < numTasks; iTask++)
+    {
+        threadArgs[iTask][0] = (void*)task;
+        threadArgs[iTask][1] = taskArgs[iTask];
+        isStarted[iTask] = (pthread_create(&threads[iTask], NULL, ParallelTaskThread, threadArgs[iTask]) == 0);
+        if (!isStarted[iTask])
+            task(taskArgs[iTask]);
+    }
+
+    for (unsigned long iTask = 0; iTask < numTasks; iTask++)
+    {
+        if (isStarted[iTask])
+            pthread_join(threads[iTask], NULL);
+    }
+}
+
+#endif
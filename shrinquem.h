@@ -5,6 +5,9 @@
 #if !defined(INC_SHRINQUEM_H)
 #define INC_SHRINQUEM_H
 
+#include <stddef.h> // used for size_t
+#include "shrinquem_cube.h"
+
 typedef char triLogic;
 
 #define LOGIC_FALSE     (0)
@@ -18,35 +21,664 @@ typedef enum
     STATUS_TOO_MANY_VARIABLES,
     STATUS_OUT_OF_MEMORY,
     STATUS_NULL_ARGUMENT,
+    STATUS_INVALID_ARGUMENT,
+    STATUS_FILE_ERROR,
+    STATUS_PARSE_ERROR,
+    STATUS_CANCELLED,
 } shrinquemStatus;
 
+typedef enum
+{
+    POLARITY_SUM_OF_PRODUCTS = 0,
+    POLARITY_PRODUCT_OF_SUMS,
+} logicPolarity;
+
+// For POLARITY_PRODUCT_OF_SUMS the terms are the cubes of the complement,
+// so each one is a sum of the complemented literals and the result is their product.
 typedef struct SumOfProducts
 {
     unsigned long numVars;
     unsigned long numTerms;
-    unsigned long* terms;
-    unsigned long* dontCares;
+    cube64* terms;
+    cube64* dontCares;
     char* equation;
+    logicPolarity polarity;
+    double cost; // the cost of the cover under the objective of ReduceLogicWithOptions, the number of terms by default
 } SumOfProducts;
 
 void FinalizeSumOfProducts(
     SumOfProducts* sumOfProducts);
 
+// the functions all memory of the library comes from, results included, so those are released with them too
+typedef struct MemoryAllocator
+{
+    void* (*allocate)(size_t size, void* context);            // size is never 0
+    void* (*reallocate)(void* p, size_t size, void* context); // p is never NULL and size is never 0
+    void (*release)(void* p, void* context);                  // p is never NULL
+    void* context;
+} MemoryAllocator;
+
+// process-wide and set before anything is allocated, NULL goes back to malloc and free
+shrinquemStatus SetMemoryAllocator(
+    const MemoryAllocator* allocator);
+
 shrinquemStatus ReduceLogic(
     const triLogic truthTable[],
     SumOfProducts* sumOfProducts);
 
+shrinquemStatus ReduceLogicPOS(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts);
+
+// runs both polarities in parallel and keeps the one with fewer terms, then fewer literals
+shrinquemStatus ReduceLogicAuto(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts);
+
+// the order the minterms are picked to start new terms
+typedef enum
+{
+    SEED_ORDER_ASCENDING = 0,    // by truth table index
+    SEED_ORDER_MOST_CONSTRAINED, // fewest neighbors that are not OFF first, these have the fewest ways to be covered
+} seedOrder;
+
+// the order the literals of a term are tried as "don't cares"
+typedef enum
+{
+    EXPAND_ORDER_FIXED = 0,       // variable 0 first, then 1, ...
+    EXPAND_ORDER_MOST_UNCOVERED,  // the variable whose other half holds the most ON minterms not covered yet
+} expandOrder;
+
+// the entries a term must be the only one to cover to be kept
+typedef enum
+{
+    IRREDUNDANCY_ALL_ENTRIES = 0, // DON'T CARE entries too, earlier terms are dropped first
+    IRREDUNDANCY_ON_ENTRIES,      // only the ON entries, the terms with the most literals are dropped first
+} irredundancyMode;
+
+// what the cost of a cover counts
+typedef enum
+{
+    OBJECTIVE_TERMS = 0,  // one per term
+    OBJECTIVE_LITERALS,   // one per literal
+    OBJECTIVE_WEIGHTED,   // the weight of the variable of each literal
+} costObjective;
+
+// the part of a minimization a progress report comes from
+typedef enum
+{
+    PROGRESS_PHASE_EXPANDING = 0, // making a term from each uncovered minterm, counted in minterms
+    PROGRESS_PHASE_IRREDUNDANT,   // removing the terms the others cover, counted in terms
+} progressPhase;
+
+typedef struct ReduceLogicProgress
+{
+    progressPhase phase;
+    cube64 numProcessed;
+    cube64 numTotal;
+    unsigned long numTerms; // the terms so far
+} ReduceLogicProgress;
+
+// called on the minimizing thread, so the flag of the options can be set from it to stop
+typedef void (*progressCallback)(const ReduceLogicProgress* progress, void* context);
+
+// the pages of the work arrays the size of the truth table, for functions large enough that TLB misses slow the probes
+typedef enum
+{
+    PAGES_TRANSPARENT_HUGE = 0, // huge pages where the kernel has them to spare
+    PAGES_EXPLICIT_HUGE,        // from the reserved huge pages, or transparent ones when none are left
+    PAGES_SMALL,
+} pagePolicy;
+
+// zeroed options minimize the same way as ReduceLogic
+typedef struct ReduceLogicOptions
+{
+    logicPolarity polarity;
+    seedOrder seeding;
+    expandOrder expansion;
+    irredundancyMode irredundancy;
+    costObjective objective;
+    const double* weights; // one per variable for OBJECTIVE_WEIGHTED, variable i being bit i of the input
+    progressCallback progress;  // NULL for no reports, otherwise called every 2^16 minterms or 256 terms and at the end of each phase,
+                                // though functions of six variables or fewer may finish without any
+    void* progressContext;      // passed to progress
+    const volatile int* cancel; // NULL, or a flag set nonzero to stop with STATUS_CANCELLED, read as often as progress is called
+    const char* scratchDirectory; // NULL, or a directory the work arrays the size of the truth table are kept in as files
+    pagePolicy pages;             // the pages those arrays are asked for when they are kept in memory
+} ReduceLogicOptions;
+
+// options may be NULL for the defaults
+shrinquemStatus ReduceLogicWithOptions(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options);
+
+// returns a correct cover within about timeLimit seconds, the more of it expanded the more time there is
+shrinquemStatus ReduceLogicWithDeadline(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options,
+    double timeLimit,
+    int* isComplete);
+
+#define SHRINQUEM_CHECKPOINT_VERSION (1)
+
+// saves the state of the run to checkpointPath about every interval seconds, the file is left for the caller to remove
+shrinquemStatus ReduceLogicWithCheckpoints(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options,
+    const char* checkpointPath,
+    double interval);
+
+// goes on from the checkpoint of a run on the same table and options, with the same result it would have had
+shrinquemStatus ResumeReduceLogic(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options,
+    const char* checkpointPath,
+    double interval);
+
 shrinquemStatus GenerateEquationString(
     SumOfProducts* sumOfProducts,
     const char** const varNames);
 
 triLogic EvaluateSumOfProducts(
     const SumOfProducts sumOfProducts,
-    const unsigned long input);
+    const cube64 input);
+
+// reads the equations of GenerateEquationString back, the parser is made once for a set of variable names
+typedef struct EquationParser EquationParser;
+
+shrinquemStatus CreateEquationParser(
+    unsigned long numVars,
+    const char** const varNames,
+    EquationParser** parser);
+
+void DestroyEquationParser(
+    EquationParser* parser);
+
+shrinquemStatus ParseEquationString(
+    const EquationParser* parser,
+    const char* equation,
+    logicPolarity polarity,
+    SumOfProducts* sumOfProducts);
+
+// compares two covers of the same number of variables as functions, their don't cares are not special
+shrinquemStatus AreSumOfProductsEquivalent(
+    const SumOfProducts* first,
+    const SumOfProducts* second,
+    int* isEquivalent);
+
+// BDD engine for functions too wide for a dense truth table
+
+typedef unsigned long bddNode;
+typedef struct BddManager BddManager;
+
+#define BDD_FALSE   ((bddNode)0)
+#define BDD_TRUE    ((bddNode)1)
+#define BDD_INVALID ((bddNode)-1) // returned when the manager runs out of memory
+
+shrinquemStatus CreateBddManager(
+    unsigned long numVars,
+    BddManager** manager);
+
+void DestroyBddManager(
+    BddManager* manager);
+
+void BddRef(
+    BddManager* manager,
+    bddNode f);
+
+void BddDeref(
+    BddManager* manager,
+    bddNode f);
+
+unsigned long BddNodeCount(
+    const BddManager* manager);
+
+unsigned long BddVariableAtLevel(
+    const BddManager* manager,
+    unsigned long level);
+
+bddNode BddVariable(
+    BddManager* manager,
+    unsigned long var);
+
+bddNode BddNot(
+    BddManager* manager,
+    bddNode f);
+
+bddNode BddAnd(
+    BddManager* manager,
+    bddNode f,
+    bddNode g);
+
+bddNode BddOr(
+    BddManager* manager,
+    bddNode f,
+    bddNode g);
+
+bddNode BddXor(
+    BddManager* manager,
+    bddNode f,
+    bddNode g);
+
+bddNode BddFromTruthTable(
+    BddManager* manager,
+    const triLogic truthTable[],
+    triLogic value);
+
+bddNode BddFromSumOfProducts(
+    BddManager* manager,
+    const SumOfProducts* sumOfProducts);
+
+// value and dontCares hold one word for every 64 variables of the manager, e.g. those of a cube128
+bddNode BddFromWideCube(
+    BddManager* manager,
+    const cube64 value[],
+    const cube64 dontCares[]);
+
+double BddSatisfyingFraction(
+    BddManager* manager,
+    bddNode f);
+
+void BddCollectGarbage(
+    BddManager* manager);
+
+shrinquemStatus BddReorder(
+    BddManager* manager);
+
+bddNode BddPrimeImplicants(
+    BddManager* manager,
+    bddNode f);
+
+// a cover has at most 64 variables, so a wider manager gives STATUS_TOO_MANY_VARIABLES and needs ReduceLogicWideFromBdd
+shrinquemStatus ReduceLogicFromBdd(
+    BddManager* manager,
+    bddNode onSet,
+    bddNode dcSet,
+    SumOfProducts* sumOfProducts);
+
+// the most primes ReduceLogicFromBdd lists to choose its cover from
+#define BDD_DEFAULT_MAX_PRIMES (1 << 16)
+
+// what ReduceLogicFromBddBounded found out about the primes on the way to its cover
+typedef struct BddCoverInfo
+{
+    double numPrimes;           // counted on their ZDD, so it can be far more than would fit in memory
+    double numCorePrimes;       // the primes left to choose from once the essential ones are taken
+    unsigned long numEssential; // primes with an on-set minterm no other prime has, all of them are in the cover
+    int isCoreListed;           // zero when there were more than maxPrimes core primes and the rest of the cover was built on the BDDs
+} BddCoverInfo;
+
+// same as ReduceLogicFromBdd but lists at most maxPrimes primes, info may be NULL
+shrinquemStatus ReduceLogicFromBddBounded(
+    BddManager* manager,
+    bddNode onSet,
+    bddNode dcSet,
+    unsigned long maxPrimes,
+    SumOfProducts* sumOfProducts,
+    BddCoverInfo* info);
+
+// the most variables of a WideSumOfProducts, those of a cube512
+#define WIDE_MAX_VARIABLES (512)
+
+// A sum-of-products of up to WIDE_MAX_VARIABLES variables. Its terms are the
+// narrowest of cube128, cube256 and cube512 holding numVars variables.
+typedef struct WideSumOfProducts
+{
+    unsigned long numVars;
+    unsigned long numWords; // 2, 4 or 8, the words of value and of dontCares in each term
+    unsigned long numTerms;
+    void* terms;            // e.g. an array of cube256 when numWords is 4
+} WideSumOfProducts;
+
+void FinalizeWideSumOfProducts(
+    WideSumOfProducts* wideSumOfProducts);
+
+// input holds numWords words, variable i is bit i % 64 of word i / 64
+triLogic EvaluateWideSumOfProducts(
+    const WideSumOfProducts* wideSumOfProducts,
+    const cube64 input[]);
+
+bddNode BddFromWideSumOfProducts(
+    BddManager* manager,
+    const WideSumOfProducts* wideSumOfProducts);
+
+// same as ReduceLogicFromBddBounded for managers of up to WIDE_MAX_VARIABLES variables
+shrinquemStatus ReduceLogicWideFromBdd(
+    BddManager* manager,
+    bddNode onSet,
+    bddNode dcSet,
+    unsigned long maxPrimes,
+    WideSumOfProducts* wideSumOfProducts,
+    BddCoverInfo* info);
+
+shrinquemStatus ReduceLogicBdd(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts);
+
+// all the prime implicants which contain a TRUE entry, for functions of up to 16 variables
+shrinquemStatus GeneratePrimeImplicants(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts);
+
+// exclusive-sum-of-products (ESOP) mode, the cubes of the result are exclusive-ored instead of ored
+
+shrinquemStatus ReduceLogicEsop(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts);
+
+shrinquemStatus GenerateExclusiveEquationString(
+    SumOfProducts* sumOfProducts,
+    const char** const varNames);
+
+triLogic EvaluateExclusiveSumOfProducts(
+    const SumOfProducts sumOfProducts,
+    const cube64 input);
+
+// incremental mode, keeps a cover up to date while a few truth table entries change at a time
+
+typedef struct IncrementalReduction IncrementalReduction;
+
+shrinquemStatus CreateIncrementalReduction(
+    const triLogic truthTable[],
+    unsigned long numVars,
+    IncrementalReduction** reduction);
+
+void DestroyIncrementalReduction(
+    IncrementalReduction* reduction);
+
+// truthTable is the caller's table after the entries listed in changedInputs were changed
+shrinquemStatus UpdateIncrementalReduction(
+    IncrementalReduction* reduction,
+    const triLogic truthTable[],
+    const cube64 changedInputs[],
+    unsigned long numChanged);
+
+shrinquemStatus GetIncrementalSumOfProducts(
+    const IncrementalReduction* reduction,
+    SumOfProducts* sumOfProducts);
+
+// cube store, the terms of a sum-of-products laid out for vectorized scans
+
+#define CUBE_STORE_ALIGNMENT (64)                                   // bytes, one cache line
+#define CUBE_STORE_LANES     (CUBE_STORE_ALIGNMENT / sizeof(cube64)) // terms per aligned block
+
+typedef struct CubeStore
+{
+    unsigned long numVars;
+    unsigned long numTerms;
+    unsigned long capacity; // numTerms rounded up to whole blocks of CUBE_STORE_LANES
+    cube64* cares;          // ~dontCares of each term, 0 in the padding
+    cube64* values;         // terms & cares, all ones in the padding so it never matches
+    logicPolarity polarity;
+} CubeStore;
+
+shrinquemStatus CubeStoreFromSumOfProducts(
+    const SumOfProducts* sumOfProducts,
+    CubeStore* store);
+
+shrinquemStatus SumOfProductsFromCubeStore(
+    const CubeStore* store,
+    SumOfProducts* sumOfProducts);
+
+void FinalizeCubeStore(
+    CubeStore* store);
+
+triLogic EvaluateCubeStore(
+    const CubeStore* store,
+    const cube64 input);
+
+unsigned long CubeStoreFindContaining(
+    const CubeStore* store,
+    const cube64 value,
+    const cube64 care);
+
+// factored form, a multi-level expression of a cover found by algebraic division
+
+#define FACTOR_FALSE (0UL) // the node of the constant FALSE
+#define FACTOR_TRUE  (1UL) // the node of the constant TRUE
+
+typedef enum
+{
+    FACTOR_KIND_FALSE = 0,
+    FACTOR_KIND_TRUE,
+    FACTOR_KIND_LITERAL,
+    FACTOR_KIND_AND,
+    FACTOR_KIND_OR,
+} factorKind;
+
+typedef struct FactorNode
+{
+    factorKind kind;
+    unsigned long first;  // the variable of a literal, or the first operand
+    unsigned long second; // 1 for a true literal and 0 for a complemented one, or the second operand
+} FactorNode;
+
+// the operands of a node always come before it, and a node used twice is only stored once
+typedef struct FactoredForm
+{
+    unsigned long numVars;
+    unsigned long numNodes;
+    FactorNode* nodes;
+    unsigned long root;
+    logicPolarity polarity; // for POLARITY_PRODUCT_OF_SUMS the nodes are the complement
+    char* equation;
+} FactoredForm;
+
+shrinquemStatus FactorSumOfProducts(
+    const SumOfProducts* sumOfProducts,
+    FactoredForm* factored);
+
+void FinalizeFactoredForm(
+    FactoredForm* factored);
+
+triLogic EvaluateFactoredForm(
+    const FactoredForm* factored,
+    const cube64 input);
+
+unsigned long FactoredFormNumOperations(
+    const FactoredForm* factored);
+
+shrinquemStatus GenerateFactoredEquationString(
+    FactoredForm* factored,
+    const char** const varNames);
+
+// code generation, the C source of a function computing a cover
+
+typedef enum
+{
+    CODEGEN_SCALAR = 0, // int f(uint64_t x), variable i is bit i of x
+    CODEGEN_BITSLICED,  // uint64_t f(const uint64_t in[numVars]), 64 inputs at once, one per bit
+} codegenMode;
+
+// the source is allocated and must be freed by the caller, through the allocator if one was set
+shrinquemStatus GenerateCSource(
+    const SumOfProducts* sumOfProducts,
+    const char* functionName,
+    codegenMode mode,
+    char** source);
+
+// binary files of a cover, little-endian and used in place through a read-only mapping
+
+#define SHRINQUEM_BINARY_VERSION (1)
+
+typedef struct MappedSumOfProducts
+{
+    CubeStore store;             // points into the mapping, it must not be finalized or written to
+    unsigned long numIndexVars;  // the highest variables the index splits the inputs on, 0 without an index
+    const uint32_t* indexStarts; // 2^numIndexVars + 1 start positions in indexTerms, or NULL
+    const uint32_t* indexTerms;  // the terms that can hold each value of the index variables
+    void* mapping;
+    size_t mappingSize;
+} MappedSumOfProducts;
+
+shrinquemStatus WriteSumOfProductsBinary(
+    const char* path,
+    const SumOfProducts* sumOfProducts,
+    int withIndex);
+
+shrinquemStatus MapSumOfProductsBinary(
+    const char* path,
+    MappedSumOfProducts* mapped);
+
+void UnmapSumOfProductsBinary(
+    MappedSumOfProducts* mapped);
+
+triLogic EvaluateMappedSumOfProducts(
+    const MappedSumOfProducts* mapped,
+    const cube64 input);
+
+// truth tables too large for memory, one triLogic per byte and used in place through a read-only mapping
+
+typedef struct MappedTruthTable
+{
+    unsigned long numVars;
+    const triLogic* values; // 2^numVars entries, passed as the truthTable of ReduceLogicWithOptions
+    void* mapping;
+    size_t mappingSize;
+} MappedTruthTable;
+
+shrinquemStatus MapTruthTableFile(
+    const char* path,
+    unsigned long numVars,
+    MappedTruthTable* table);
+
+void UnmapTruthTableFile(
+    MappedTruthTable* table);
+
+// Berkeley PLA files, the format of espresso
+
+// one output of a PLA file, kept as its cubes so no truth table is needed
+typedef struct PlaFunction
+{
+    unsigned long numVars;
+    SumOfProducts onSet;       // the cubes with a 1 output, when the type has f
+    SumOfProducts dontCareSet; // the cubes with a - output, when the type has d
+    SumOfProducts offSet;      // the cubes with a 0 output, when the type has r
+    triLogic unlisted;         // the value of the entries in none of the cubes
+    char** varNames;           // from .ilb or NULL, in the order GenerateEquationString takes them
+    char* outputName;          // from .ob or NULL
+} PlaFunction;
+
+shrinquemStatus ReadPlaFile(
+    const char* path,
+    unsigned long iOutput,
+    PlaFunction* pla);
+
+void FinalizePla(
+    PlaFunction* pla);
+
+// truthTable must hold 2^numVars entries
+shrinquemStatus TruthTableFromPla(
+    const PlaFunction* pla,
+    triLogic truthTable[]);
+
+// varNames and outputName may be NULL
+shrinquemStatus WritePlaFile(
+    const char* path,
+    const SumOfProducts* sumOfProducts,
+    const char** const varNames,
+    const char* outputName);
+
+// truth tables built a word at a time, entry i is bit i % 64 of word i / 64
+typedef struct PackedTruthTable
+{
+    unsigned long numVars;
+    size_t numWords;   // 2^(numVars - 6), at least 1
+    cube64* values;    // the entries that are TRUE
+    cube64* dontCares; // the entries that are DON'T CARE, whatever their value bits
+} PackedTruthTable;
+
+shrinquemStatus AllocatePackedTruthTable(
+    unsigned long numVars,
+    PackedTruthTable* table);
+
+void FinalizePackedTruthTable(
+    PackedTruthTable* table);
+
+// every operation takes tables of the same numVars, the result may be one of the operands
+shrinquemStatus PackedTableConstant(
+    triLogic value,
+    PackedTruthTable* table);
+
+shrinquemStatus PackedTableVariable(
+    unsigned long iVar,
+    PackedTruthTable* table);
+
+// the don't cares of both operands carry over to the result
+shrinquemStatus PackedTableAnd(
+    const PackedTruthTable* first,
+    const PackedTruthTable* second,
+    PackedTruthTable* result);
+
+shrinquemStatus PackedTableOr(
+    const PackedTruthTable* first,
+    const PackedTruthTable* second,
+    PackedTruthTable* result);
+
+shrinquemStatus PackedTableXor(
+    const PackedTruthTable* first,
+    const PackedTruthTable* second,
+    PackedTruthTable* result);
+
+shrinquemStatus PackedTableNot(
+    const PackedTruthTable* table,
+    PackedTruthTable* result);
+
+shrinquemStatus PackedTableMaskDontCares(
+    const PackedTruthTable* table,
+    const PackedTruthTable* mask,
+    PackedTruthTable* result);
+
+shrinquemStatus PackedTableCofactor(
+    const PackedTruthTable* table,
+    unsigned long iVar,
+    int value,
+    PackedTruthTable* result);
+
+shrinquemStatus PackedTableSwapVariables(
+    const PackedTruthTable* table,
+    unsigned long iVar,
+    unsigned long jVar,
+    PackedTruthTable* result);
+
+shrinquemStatus PackedTablePermute(
+    const PackedTruthTable* table,
+    const unsigned long permutation[],
+    PackedTruthTable* result);
+
+// truthTable holds 2^numVars entries
+shrinquemStatus PackedTableFromTriLogic(
+    const triLogic truthTable[],
+    PackedTruthTable* table);
+
+shrinquemStatus PackedTableToTriLogic(
+    const PackedTruthTable* table,
+    triLogic truthTable[]);
+
+shrinquemStatus ReduceLogicPacked(
+    const PackedTruthTable* table,
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options);
 
 // functions used for metrics and testing
 void ResetTermCounters();
 unsigned long GetNumTermsKept();
 unsigned long GetNumTermsRemoved();
 
+// where the resolved entries of the last minimization large enough for AllocatePages ended up
+typedef struct MemoryPlacement
+{
+    size_t size;            // 0 when no minimization was large enough yet
+    pagePolicy pages;       // the pages it got
+    unsigned long numNodes; // the NUMA nodes of the system
+    int isInterleaved;      // its pages are spread over the nodes, done for the arrays parallel runs share
+} MemoryPlacement;
+
+void GetMemoryPlacement(
+    MemoryPlacement* placement);
+
 #endif // !defined(INC_SHRINQUEM_H)
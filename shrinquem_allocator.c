@@ -0,0 +1,128 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for memset
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+static void* AllocateFromHeap(size_t size, void* context);
+static void* ReallocateFromHeap(void* p, size_t size, void* context);
+static void ReleaseToHeap(void* p, void* context);
+
+static const MemoryAllocator HEAP_ALLOCATOR = { AllocateFromHeap, ReallocateFromHeap, ReleaseToHeap, NULL };
+
+static MemoryAllocator allocator = { AllocateFromHeap, ReallocateFromHeap, ReleaseToHeap, NULL };
+
+/*************************************************************************
+SetMemoryAllocator
+Purpose - routes every allocation of the library through the functions
+  given, so its memory can come from an arena or pool, be held to a limit
+  by returning NULL, or be handed on without copying. The covers, strings
+  and other results the library returns come from it too, so the caller
+  releases them with the same functions, directly or through the finalize
+  functions.
+
+The allocator is process-wide. It is set before anything is allocated and
+kept until all of it is released, as memory is always released through
+the allocator set at the time. ReduceLogicAuto calls it from two threads
+at once, so it has to be thread-safe for that. The hooks are never asked
+for 0 bytes or given NULL, so they don't need the corner cases of malloc.
+The scratch files of the out-of-core mode are still files, while the
+arrays that would have been mapped on huge pages come from the allocator
+instead.
+*************************************************************************/
+
+shrinquemStatus SetMemoryAllocator(
+    const MemoryAllocator* newAllocator)
+{
+    if (newAllocator == NULL)
+    {
+        allocator = HEAP_ALLOCATOR;
+        return STATUS_OKAY;
+    }
+    else if (newAllocator->allocate == NULL || newAllocator->reallocate == NULL || newAllocator->release == NULL)
+    {
+        return STATUS_NULL_ARGUMENT;
+    }
+
+    allocator = *newAllocator;
+
+    return STATUS_OKAY;
+}
+
+int IsHeapAllocator(void)
+{
+    return allocator.allocate == AllocateFromHeap;
+}
+
+void* AllocateMemory(
+    size_t size)
+{
+    return allocator.allocate(size > 0 ? size : 1, allocator.context);
+}
+
+// calloc through the allocator, NULL when the product overflows like calloc
+void* AllocateZeroed(
+    size_t count,
+    size_t size)
+{
+    if (size != 0 && count > (size_t)-1 / size)
+        return NULL;
+
+    void* p = AllocateMemory(count * size);
+    if (p != NULL)
+        memset(p, 0, count * size);
+
+    return p;
+}
+
+// realloc through the allocator, where a size of 0 releases the block and returns NULL
+void* ReallocateMemory(
+    void* p,
+    size_t size)
+{
+    if (p == NULL)
+        return AllocateMemory(size);
+
+    if (size == 0)
+    {
+        allocator.release(p, allocator.context);
+        return NULL;
+    }
+
+    return allocator.reallocate(p, size, allocator.context);
+}
+
+void FreeMemory(
+    void* p)
+{
+    if (p != NULL)
+        allocator.release(p, allocator.context);
+}
+
+static void* AllocateFromHeap(
+    size_t size,
+    void* context)
+{
+    (void)context;
+    return malloc(size);
+}
+
+static void* ReallocateFromHeap(
+    void* p,
+    size_t size,
+    void* context)
+{
+    (void)context;
+    return realloc(p, size);
+}
+
+static void ReleaseToHeap(
+    void* p,
+    void* context)
+{
+    (void)context;
+    free(p);
+}
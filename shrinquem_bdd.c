@@ -0,0 +1,2125 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for memset
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define BDD_TERMINAL_VAR ((unsigned long)-1)
+#define BDD_FREE_VAR ((unsigned long)-2)
+
+#define INITIAL_NUM_NODES (1 << 12)
+#define INITIAL_NUM_BUCKETS (1 << 4)
+#define MIN_CACHE_SIZE (1 << 12)
+#define MAX_CACHE_SIZE (1 << 22)
+#define SIFT_MAX_GROWTH (1.2)
+#define MAX_CUBE_WORDS (WIDE_MAX_VARIABLES / CUBE64_MAX_VARIABLES)
+
+typedef enum
+{
+    OP_AND = 1,
+    OP_OR,
+    OP_XOR,
+    OP_ZDD_DIFF,
+    OP_PRIMES,
+    OP_ZDD_COVER,
+    OP_ZDD_COVER_TWICE,
+    OP_ZDD_TOUCHING,
+    OP_ISOP,
+} bddOp;
+
+typedef struct BddNodeData
+{
+    unsigned long var;      // subtable index: BDD variables first, then ZDD literals
+    bddNode lo;
+    bddNode hi;
+    bddNode next;           // hash chain within the subtable, or the free list
+    unsigned long refs;     // external references held through BddRef
+    unsigned long parents;  // references from other nodes, only maintained while reordering
+} BddNodeData;
+
+typedef struct BddSubtable
+{
+    bddNode* buckets;
+    unsigned long numBuckets;
+    unsigned long numNodes;
+} BddSubtable;
+
+typedef struct BddCacheEntry
+{
+    unsigned long op;
+    bddNode f;
+    bddNode g;
+    bddNode result;
+} BddCacheEntry;
+
+typedef struct CubeList
+{
+    unsigned long numCubes;
+    unsigned long capacity;
+    unsigned long numWords; // words of each cube, one for every 64 variables
+    cube64* values;         // numWords words for each cube
+    cube64* dontCares;
+} CubeList;
+
+struct BddManager
+{
+    unsigned long numVars;
+    BddNodeData* nodes;
+    unsigned long capacity;
+    unsigned long highWater;
+    unsigned long numFree;
+    bddNode freeList;
+    BddSubtable* subtables;     // numVars BDD subtables followed by 2 * numVars ZDD subtables
+    unsigned long* var2level;
+    unsigned long* level2var;
+    BddCacheEntry* cache;
+    unsigned long cacheSize;
+    double* satValues;
+    unsigned long* satEpochs;
+    unsigned long satCapacity;
+    unsigned long satEpoch;
+};
+
+static unsigned long BddLevel(const BddManager* manager, bddNode f);
+static unsigned long ZddLevel(const BddManager* manager, bddNode f);
+static unsigned long HashChildren(bddNode lo, bddNode hi, unsigned long numBuckets);
+static int EnsureFreeNodes(BddManager* manager, unsigned long numNeeded);
+static bddNode AllocateNode(BddManager* manager);
+static void ReleaseNode(BddManager* manager, bddNode f);
+static void InsertIntoSubtable(BddManager* manager, bddNode f);
+static void RemoveFromSubtable(BddManager* manager, bddNode f);
+static bddNode FindOrAddNode(BddManager* manager, unsigned long var, bddNode lo, bddNode hi);
+static bddNode MakeBddNode(BddManager* manager, unsigned long var, bddNode lo, bddNode hi);
+static bddNode MakeZddNode(BddManager* manager, unsigned long zddVar, bddNode lo, bddNode hi);
+static int LookupCache(const BddManager* manager, bddOp op, bddNode f, bddNode g, bddNode* result);
+static void InsertCache(BddManager* manager, bddOp op, bddNode f, bddNode g, bddNode result);
+static void ClearCache(BddManager* manager);
+static bddNode BddApply(BddManager* manager, bddOp op, bddNode f, bddNode g);
+static bddNode ZddDifference(BddManager* manager, bddNode p, bddNode q);
+static bddNode ZddCover(BddManager* manager, bddNode zdd);
+static bddNode ZddCoverTwice(BddManager* manager, bddNode zdd);
+static bddNode ZddTouching(BddManager* manager, bddNode zdd, bddNode f);
+static bddNode ZddIsop(BddManager* manager, bddNode lower, bddNode upper);
+static bddNode ZddLiteral(BddManager* manager, unsigned long zddVar);
+static bddNode BuildFromTruthTable(BddManager* manager, const triLogic truthTable[], triLogic value, unsigned long level, cube64 input);
+static bddNode BddFromCube(BddManager* manager, const cube64 value[], const cube64 dontCares[], unsigned long numWords);
+static double BddSatFraction(BddManager* manager, bddNode f);
+static double SatFractionRecursive(BddManager* manager, bddNode f);
+static double ZddCountCubes(BddManager* manager, bddNode zdd);
+static double CountCubesRecursive(BddManager* manager, bddNode zdd);
+static int StartCountMemo(BddManager* manager);
+static void MarkNodes(BddManager* manager, bddNode f);
+static void DerefParent(BddManager* manager, bddNode f);
+static bddNode FindOrAddSwappedNode(BddManager* manager, unsigned long var, bddNode lo, bddNode hi);
+static int SwapAdjacentLevels(BddManager* manager, unsigned long level);
+static shrinquemStatus CoverFromBdd(BddManager* manager, bddNode onSet, bddNode dcSet, unsigned long maxPrimes, CubeList* cover, BddCoverInfo* info);
+static shrinquemStatus ListZddCubes(BddManager* manager, bddNode zdd, CubeList* cubes);
+static shrinquemStatus CollectZddCubes(BddManager* manager, bddNode zdd, cube64 value[], cube64 dontCares[], CubeList* cubes);
+static shrinquemStatus AppendCube(CubeList* cubes, const cube64 value[], const cube64 dontCares[]);
+static void FreeCubeList(CubeList* cubes);
+static shrinquemStatus ExpandToPrime(BddManager* manager, bddNode outside, cube64 value[], cube64 dontCares[], unsigned long numWords);
+static void SiftDownByGain(unsigned long heap[], unsigned long numHeap, unsigned long iHeap, const double gains[]);
+
+/*************************************************************************
+CreateBddManager
+Purpose - creates a node manager holding reduced ordered BDDs over numVars
+  variables along with the ZDDs used for implicit prime implicants. Variable
+  v of the BDD is bit position v of a truth table input, exactly like the
+  terms and dontCares of a SumOfProducts.
+*************************************************************************/
+
+shrinquemStatus CreateBddManager(
+    unsigned long numVars,
+    BddManager** manager)
+{
+    BddManager* newManager = NULL;
+
+    if (manager == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    *manager = NULL;
+
+    if (numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+
+    newManager = (BddManager*)AllocateZeroed(1, sizeof(BddManager));
+    if (newManager == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    newManager->numVars = numVars;
+    newManager->capacity = INITIAL_NUM_NODES;
+    newManager->nodes = (BddNodeData*)AllocateMemory(newManager->capacity * sizeof(BddNodeData));
+    newManager->subtables = (BddSubtable*)AllocateZeroed(3 * numVars, sizeof(BddSubtable));
+    newManager->var2level = (unsigned long*)AllocateMemory(numVars * sizeof(unsigned long));
+    newManager->level2var = (unsigned long*)AllocateMemory(numVars * sizeof(unsigned long));
+    newManager->cacheSize = MIN_CACHE_SIZE;
+    newManager->cache = (BddCacheEntry*)AllocateZeroed(newManager->cacheSize, sizeof(BddCacheEntry));
+
+    if (newManager->nodes == NULL || newManager->subtables == NULL || newManager->var2level == NULL ||
+        newManager->level2var == NULL || newManager->cache == NULL)
+    {
+        DestroyBddManager(newManager);
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    for (unsigned long iSubtable = 0; iSubtable < 3 * numVars; iSubtable++)
+    {
+        BddSubtable* subtable = &newManager->subtables[iSubtable];
+        subtable->numBuckets = INITIAL_NUM_BUCKETS;
+        subtable->buckets = (bddNode*)AllocateMemory(subtable->numBuckets * sizeof(bddNode));
+        if (subtable->buckets == NULL)
+        {
+            DestroyBddManager(newManager);
+            return STATUS_OUT_OF_MEMORY;
+        }
+
+        for (unsigned long iBucket = 0; iBucket < subtable->numBuckets; iBucket++)
+            subtable->buckets[iBucket] = BDD_INVALID;
+    }
+
+    for (unsigned long iVar = 0; iVar < numVars; iVar++)
+    {
+        newManager->var2level[iVar] = iVar;
+        newManager->level2var[iVar] = iVar;
+    }
+
+    // the two terminals double as the ZDD terminals: BDD_FALSE is the empty set and BDD_TRUE is the set holding the empty cube
+    for (bddNode terminal = BDD_FALSE; terminal <= BDD_TRUE; terminal++)
+    {
+        newManager->nodes[terminal].var = BDD_TERMINAL_VAR;
+        newManager->nodes[terminal].lo = terminal;
+        newManager->nodes[terminal].hi = terminal;
+        newManager->nodes[terminal].next = BDD_INVALID;
+        newManager->nodes[terminal].refs = 1;
+        newManager->nodes[terminal].parents = 0;
+    }
+
+    newManager->highWater = 2;
+    newManager->freeList = BDD_INVALID;
+    *manager = newManager;
+
+    return STATUS_OKAY;
+}
+
+void DestroyBddManager(
+    BddManager* manager)
+{
+    if (manager == NULL)
+        return;
+
+    if (manager->subtables)
+    {
+        for (unsigned long iSubtable = 0; iSubtable < 3 * manager->numVars; iSubtable++)
+        {
+            if (manager->subtables[iSubtable].buckets)
+                FreeMemory(manager->subtables[iSubtable].buckets);
+        }
+
+        FreeMemory(manager->subtables);
+    }
+
+    if (manager->nodes)
+        FreeMemory(manager->nodes);
+
+    if (manager->var2level)
+        FreeMemory(manager->var2level);
+
+    if (manager->level2var)
+        FreeMemory(manager->level2var);
+
+    if (manager->cache)
+        FreeMemory(manager->cache);
+
+    if (manager->satValues)
+        FreeMemory(manager->satValues);
+
+    if (manager->satEpochs)
+        FreeMemory(manager->satEpochs);
+
+    FreeMemory(manager);
+}
+
+void BddRef(
+    BddManager* manager,
+    bddNode f)
+{
+    if (f != BDD_INVALID)
+        manager->nodes[f].refs++;
+}
+
+void BddDeref(
+    BddManager* manager,
+    bddNode f)
+{
+    if (f != BDD_INVALID && manager->nodes[f].refs > 0)
+        manager->nodes[f].refs--;
+}
+
+/*************************************************************************
+BddNodeCount
+Purpose - returns the number of BDD nodes currently held in the unique table,
+  which after BddCollectGarbage is the size of all referenced BDDs.
+*************************************************************************/
+
+unsigned long BddNodeCount(
+    const BddManager* manager)
+{
+    unsigned long numNodes = 0;
+
+    for (unsigned long iVar = 0; iVar < manager->numVars; iVar++)
+        numNodes += manager->subtables[iVar].numNodes;
+
+    return numNodes;
+}
+
+unsigned long BddVariableAtLevel(
+    const BddManager* manager,
+    unsigned long level)
+{
+    return manager->level2var[level];
+}
+
+bddNode BddVariable(
+    BddManager* manager,
+    unsigned long var)
+{
+    if (var >= manager->numVars)
+        return BDD_INVALID;
+
+    return MakeBddNode(manager, var, BDD_FALSE, BDD_TRUE);
+}
+
+bddNode BddNot(
+    BddManager* manager,
+    bddNode f)
+{
+    return BddApply(manager, OP_XOR, f, BDD_TRUE);
+}
+
+bddNode BddAnd(
+    BddManager* manager,
+    bddNode f,
+    bddNode g)
+{
+    return BddApply(manager, OP_AND, f, g);
+}
+
+bddNode BddOr(
+    BddManager* manager,
+    bddNode f,
+    bddNode g)
+{
+    return BddApply(manager, OP_OR, f, g);
+}
+
+bddNode BddXor(
+    BddManager* manager,
+    bddNode f,
+    bddNode g)
+{
+    return BddApply(manager, OP_XOR, f, g);
+}
+
+/*************************************************************************
+BddFromTruthTable
+Purpose - builds the BDD of the set of inputs whose truth table entry equals
+  value, e.g. LOGIC_TRUE for the on-set or LOGIC_DONT_CARE for the dc-set.
+*************************************************************************/
+
+bddNode BddFromTruthTable(
+    BddManager* manager,
+    const triLogic truthTable[],
+    triLogic value)
+{
+    if (truthTable == NULL || manager->numVars > CUBE64_MAX_VARIABLES || manager->numVars >= sizeof(size_t) * 8)
+        return BDD_INVALID;
+
+    return BuildFromTruthTable(manager, truthTable, value, 0, 0);
+}
+
+/*************************************************************************
+BddFromSumOfProducts
+Purpose - builds the BDD of a cube list such as the one produced by
+  ReduceLogic or read from an equation. The cover never has to be expanded
+  into a truth table, so it works for covers of any number of variables up
+  to CUBE64_MAX_VARIABLES, in a manager of at least as many.
+*************************************************************************/
+
+bddNode BddFromSumOfProducts(
+    BddManager* manager,
+    const SumOfProducts* sumOfProducts)
+{
+    bddNode result = BDD_FALSE;
+
+    if (sumOfProducts == NULL || sumOfProducts->numVars > manager->numVars)
+        return BDD_INVALID;
+
+    // variables beyond those of the sum-of-products are not part of any term
+    cube64 unusedVars = ~CUBE64_ALL_VARS(sumOfProducts->numVars);
+
+    for (unsigned long iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
+    {
+        cube64 dontCares = sumOfProducts->dontCares[iTerm] | unusedVars;
+        bddNode cube = BddFromCube(manager, &sumOfProducts->terms[iTerm], &dontCares, 1);
+        if (cube == BDD_INVALID)
+            return BDD_INVALID;
+
+        result = BddOr(manager, result, cube);
+        if (result == BDD_INVALID)
+            return BDD_INVALID;
+    }
+
+    // a product-of-sums holds the cubes of the complement
+    if (sumOfProducts->polarity == POLARITY_PRODUCT_OF_SUMS)
+        result = BddNot(manager, result);
+
+    return result;
+}
+
+/*************************************************************************
+BddFromWideCube
+Purpose - builds the BDD of a cube held in words of 64 variables each, so
+  functions wider than 64 variables can be built from cubes such as
+  cube128.value and cube128.dontCares. The arrays must have a word for every
+  64 variables of the manager.
+*************************************************************************/
+
+bddNode BddFromWideCube(
+    BddManager* manager,
+    const cube64 value[],
+    const cube64 dontCares[])
+{
+    if (manager == NULL || value == NULL || dontCares == NULL)
+        return BDD_INVALID;
+
+    return BddFromCube(manager, value, dontCares, (manager->numVars + CUBE64_MAX_VARIABLES - 1) / CUBE64_MAX_VARIABLES);
+}
+
+/*************************************************************************
+BddFromWideSumOfProducts
+Purpose - builds the BDD of a wide cover such as the one produced by
+  ReduceLogicWideFromBdd, in a manager of at least its number of variables.
+*************************************************************************/
+
+bddNode BddFromWideSumOfProducts(
+    BddManager* manager,
+    const WideSumOfProducts* wideSumOfProducts)
+{
+    bddNode result = BDD_FALSE;
+
+    if (wideSumOfProducts == NULL || wideSumOfProducts->numVars > manager->numVars || wideSumOfProducts->numWords > MAX_CUBE_WORDS)
+        return BDD_INVALID;
+
+    const unsigned long numWords = wideSumOfProducts->numWords;
+    const cube64* terms = (const cube64*)wideSumOfProducts->terms;
+
+    for (unsigned long iTerm = 0; iTerm < wideSumOfProducts->numTerms; iTerm++)
+    {
+        const cube64* value = &terms[2 * iTerm * numWords];
+        cube64 dontCares[MAX_CUBE_WORDS];
+
+        // variables beyond those of the sum-of-products are not part of any term
+        for (unsigned long iWord = 0; iWord < numWords; iWord++)
+        {
+            unsigned long firstVar = iWord * CUBE64_MAX_VARIABLES;
+            cube64 usedVars = (wideSumOfProducts->numVars > firstVar) ? CUBE64_ALL_VARS(wideSumOfProducts->numVars - firstVar) : 0;
+            dontCares[iWord] = value[numWords + iWord] | ~usedVars;
+        }
+
+        bddNode cube = BddFromCube(manager, value, dontCares, numWords);
+        if (cube == BDD_INVALID)
+            return BDD_INVALID;
+
+        result = BddOr(manager, result, cube);
+        if (result == BDD_INVALID)
+            return BDD_INVALID;
+    }
+
+    return result;
+}
+
+/*************************************************************************
+BddSatisfyingFraction
+Purpose - returns the fraction of all 2^numVars inputs for which f is true.
+*************************************************************************/
+
+double BddSatisfyingFraction(
+    BddManager* manager,
+    bddNode f)
+{
+    return BddSatFraction(manager, f);
+}
+
+/*************************************************************************
+BddCollectGarbage
+Purpose - frees every BDD and ZDD node that is not reachable from a node
+  referenced through BddRef.
+*************************************************************************/
+
+void BddCollectGarbage(
+    BddManager* manager)
+{
+    for (bddNode f = 2; f < manager->highWater; f++)
+    {
+        if (manager->nodes[f].var != BDD_FREE_VAR && manager->nodes[f].refs > 0)
+            MarkNodes(manager, f);
+    }
+
+    for (bddNode f = 2; f < manager->highWater; f++)
+    {
+        if (manager->nodes[f].var == BDD_FREE_VAR)
+            continue;
+
+        if (manager->nodes[f].parents)
+        {
+            manager->nodes[f].parents = 0; // used as the mark
+        }
+        else
+        {
+            RemoveFromSubtable(manager, f);
+            ReleaseNode(manager, f);
+        }
+    }
+
+    ClearCache(manager);
+}
+
+/*************************************************************************
+BddReorder
+Purpose - dynamically reorders the variables by Rudell's sifting to shrink
+  the referenced BDDs. Each variable is moved through every level by swapping
+  adjacent levels in place, so node handles held by the caller stay valid.
+  ZDD nodes are ordered by the variable order in effect when they were made,
+  so any ZDD handles should be released before reordering.
+*************************************************************************/
+
+shrinquemStatus BddReorder(
+    BddManager* manager)
+{
+    shrinquemStatus status = STATUS_OKAY;
+    unsigned long numVars = manager->numVars;
+    unsigned long* siftOrder = NULL;
+    unsigned long liveNodes;
+
+    if (numVars < 2)
+        return STATUS_OKAY;
+
+    BddCollectGarbage(manager);
+
+    // count the references each node receives from other nodes, plus the external ones
+    for (bddNode f = 0; f < manager->highWater; f++)
+        manager->nodes[f].parents = manager->nodes[f].refs;
+
+    for (bddNode f = 2; f < manager->highWater; f++)
+    {
+        if (manager->nodes[f].var != BDD_FREE_VAR)
+        {
+            manager->nodes[manager->nodes[f].lo].parents++;
+            manager->nodes[manager->nodes[f].hi].parents++;
+        }
+    }
+
+    // sift the variables with the most nodes first
+    siftOrder = (unsigned long*)AllocateMemory(numVars * sizeof(unsigned long));
+    if (siftOrder == NULL)
+    {
+        status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+
+    for (unsigned long iVar = 0; iVar < numVars; iVar++)
+        siftOrder[iVar] = iVar;
+
+    for (unsigned long i = 1; i < numVars; i++)
+    {
+        unsigned long var = siftOrder[i];
+        unsigned long j = i;
+        while (j > 0 && manager->subtables[siftOrder[j - 1]].numNodes < manager->subtables[var].numNodes)
+        {
+            siftOrder[j] = siftOrder[j - 1];
+            j--;
+        }
+        siftOrder[j] = var;
+    }
+
+    liveNodes = BddNodeCount(manager);
+
+    for (unsigned long iSift = 0; iSift < numVars; iSift++)
+    {
+        unsigned long var = siftOrder[iSift];
+        unsigned long level = manager->var2level[var];
+        unsigned long bestLevel = level;
+        unsigned long bestSize = liveNodes;
+
+        // move toward the closer end first, then sweep to the other end
+        int downFirst = (numVars - 1 - level) < level;
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            int moveDown = (pass == 0) ? downFirst : !downFirst;
+
+            while (moveDown ? (level < numVars - 1) : (level > 0))
+            {
+                unsigned long swapLevel = moveDown ? level : level - 1;
+                if (!SwapAdjacentLevels(manager, swapLevel))
+                {
+                    status = STATUS_OUT_OF_MEMORY;
+                    goto cleanupAndExit;
+                }
+
+                level = moveDown ? level + 1 : level - 1;
+                liveNodes = BddNodeCount(manager);
+                if (liveNodes < bestSize)
+                {
+                    bestSize = liveNodes;
+                    bestLevel = level;
+                }
+                else if (liveNodes > SIFT_MAX_GROWTH * bestSize)
+                {
+                    break;
+                }
+            }
+        }
+
+        // return the variable to the best level seen
+        while (level != bestLevel)
+        {
+            unsigned long swapLevel = (level < bestLevel) ? level : level - 1;
+            if (!SwapAdjacentLevels(manager, swapLevel))
+            {
+                status = STATUS_OUT_OF_MEMORY;
+                goto cleanupAndExit;
+            }
+
+            level = (level < bestLevel) ? level + 1 : level - 1;
+        }
+
+        liveNodes = BddNodeCount(manager);
+    }
+
+cleanupAndExit:
+
+    if (siftOrder)
+    {
+        FreeMemory(siftOrder);
+        siftOrder = NULL;
+    }
+
+    for (bddNode f = 0; f < manager->highWater; f++)
+        manager->nodes[f].parents = 0;
+
+    ClearCache(manager);
+
+    return status;
+}
+
+/*************************************************************************
+BddPrimeImplicants
+Purpose - computes the set of prime implicants of f implicitly as a ZDD using
+  the recursion of Coudert and Madre:
+
+  Primes(f) = Primes(f0 f1) + x' (Primes(f0) - Primes(f0 f1)) + x (Primes(f1) - Primes(f0 f1))
+
+  Each BDD variable is represented by two ZDD variables, one for the positive
+  and one for the negative literal, so a path to the 1 terminal is a cube.
+*************************************************************************/
+
+bddNode BddPrimeImplicants(
+    BddManager* manager,
+    bddNode f)
+{
+    bddNode result;
+
+    if (f == BDD_INVALID)
+        return BDD_INVALID;
+
+    if (f == BDD_FALSE || f == BDD_TRUE)
+        return f;
+
+    if (LookupCache(manager, OP_PRIMES, f, 0, &result))
+        return result;
+
+    unsigned long var = manager->nodes[f].var;
+    bddNode f0 = manager->nodes[f].lo;
+    bddNode f1 = manager->nodes[f].hi;
+
+    bddNode both = BddAnd(manager, f0, f1);
+    bddNode primesBoth = BddPrimeImplicants(manager, both);
+    bddNode primes0 = BddPrimeImplicants(manager, f0);
+    bddNode primes1 = BddPrimeImplicants(manager, f1);
+    if (primesBoth == BDD_INVALID || primes0 == BDD_INVALID || primes1 == BDD_INVALID)
+        return BDD_INVALID;
+
+    bddNode withNegative = ZddDifference(manager, primes0, primesBoth);
+    bddNode withPositive = ZddDifference(manager, primes1, primesBoth);
+    if (withNegative == BDD_INVALID || withPositive == BDD_INVALID)
+        return BDD_INVALID;
+
+    bddNode negativeNode = MakeZddNode(manager, 2 * var + 1, primesBoth, withNegative);
+    if (negativeNode == BDD_INVALID)
+        return BDD_INVALID;
+
+    result = MakeZddNode(manager, 2 * var, negativeNode, withPositive);
+    if (result == BDD_INVALID)
+        return BDD_INVALID;
+
+    InsertCache(manager, OP_PRIMES, f, 0, result);
+
+    return result;
+}
+
+
+/*************************************************************************
+ReduceLogicFromBdd
+Purpose - generates a sum-of-products for the function given by its on-set
+  and dc-set BDDs, listing at most BDD_DEFAULT_MAX_PRIMES primes. See
+  CoverFromBdd. The dense truth table is never built.
+
+The terms of a cover are single cube64 words, so a manager of more than
+CUBE64_MAX_VARIABLES variables gives STATUS_TOO_MANY_VARIABLES. Those are
+minimized by ReduceLogicWideFromBdd instead.
+*************************************************************************/
+
+shrinquemStatus ReduceLogicFromBdd(
+    BddManager* manager,
+    bddNode onSet,
+    bddNode dcSet,
+    SumOfProducts* sumOfProducts)
+{
+    return ReduceLogicFromBddBounded(manager, onSet, dcSet, BDD_DEFAULT_MAX_PRIMES, sumOfProducts, NULL);
+}
+
+shrinquemStatus ReduceLogicFromBddBounded(
+    BddManager* manager,
+    bddNode onSet,
+    bddNode dcSet,
+    unsigned long maxPrimes,
+    SumOfProducts* sumOfProducts,
+    BddCoverInfo* info)
+{
+    shrinquemStatus status;
+    CubeList cover = { 0 };
+
+    if (manager == NULL || sumOfProducts == NULL || onSet == BDD_INVALID || dcSet == BDD_INVALID)
+        return STATUS_NULL_ARGUMENT;
+
+    sumOfProducts->numVars = manager->numVars;
+    sumOfProducts->numTerms = 0;
+    sumOfProducts->polarity = POLARITY_SUM_OF_PRODUCTS;
+    sumOfProducts->terms = NULL; // the caller should not have allocated any memory
+    sumOfProducts->dontCares = NULL; // the caller should not have allocated any memory
+
+    if (manager->numVars > CUBE64_MAX_VARIABLES)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    cover.numWords = 1;
+    status = CoverFromBdd(manager, onSet, dcSet, maxPrimes, &cover, info);
+
+    // the list holds its cubes in words of their own, which are the terms as they are
+    if (status == STATUS_OKAY && cover.numCubes > 0)
+    {
+        cube64 varMask = CUBE64_ALL_VARS(manager->numVars);
+        for (unsigned long iTerm = 0; iTerm < cover.numCubes; iTerm++)
+            cover.dontCares[iTerm] &= varMask;
+
+        sumOfProducts->numTerms = cover.numCubes;
+        sumOfProducts->terms = cover.values;
+        sumOfProducts->dontCares = cover.dontCares;
+        cover.values = NULL;
+        cover.dontCares = NULL;
+    }
+
+    FreeCubeList(&cover);
+
+    return status;
+}
+
+/*************************************************************************
+ReduceLogicWideFromBdd
+Purpose - same as ReduceLogicFromBddBounded for functions of up to
+  WIDE_MAX_VARIABLES variables. The terms are the cube128, cube256 or
+  cube512 the number of variables of the manager fits in.
+*************************************************************************/
+
+shrinquemStatus ReduceLogicWideFromBdd(
+    BddManager* manager,
+    bddNode onSet,
+    bddNode dcSet,
+    unsigned long maxPrimes,
+    WideSumOfProducts* wideSumOfProducts,
+    BddCoverInfo* info)
+{
+    shrinquemStatus status;
+    CubeList cover = { 0 };
+
+    if (manager == NULL || wideSumOfProducts == NULL || onSet == BDD_INVALID || dcSet == BDD_INVALID)
+        return STATUS_NULL_ARGUMENT;
+
+    wideSumOfProducts->numVars = manager->numVars;
+    wideSumOfProducts->numWords = WideCubeWords(manager->numVars);
+    wideSumOfProducts->numTerms = 0;
+    wideSumOfProducts->terms = NULL; // the caller should not have allocated any memory
+
+    if (wideSumOfProducts->numWords == 0)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    cover.numWords = wideSumOfProducts->numWords;
+    status = CoverFromBdd(manager, onSet, dcSet, maxPrimes, &cover, info);
+
+    if (status == STATUS_OKAY && cover.numCubes > 0)
+    {
+        const unsigned long numWords = cover.numWords;
+        cube64* terms = (cube64*)AllocateMemory(cover.numCubes * 2 * numWords * sizeof(cube64));
+        if (terms == NULL)
+        {
+            status = STATUS_OUT_OF_MEMORY;
+        }
+        else
+        {
+            // each term is laid out like a wide cube, the value words and then the dontCares words
+            for (unsigned long iTerm = 0; iTerm < cover.numCubes; iTerm++)
+            {
+                for (unsigned long iWord = 0; iWord < numWords; iWord++)
+                {
+                    terms[(2 * iTerm) * numWords + iWord] = cover.values[iTerm * numWords + iWord];
+                    terms[(2 * iTerm + 1) * numWords + iWord] = cover.dontCares[iTerm * numWords + iWord];
+                }
+            }
+
+            wideSumOfProducts->numTerms = cover.numCubes;
+            wideSumOfProducts->terms = terms;
+        }
+    }
+
+    FreeCubeList(&cover);
+
+    return status;
+}
+
+/*************************************************************************
+ReduceLogicBdd
+Purpose - same as ReduceLogic but goes through the BDD engine: the on-set
+  and dc-set are built from the truth table, the variables are sifted and
+  the cover is taken from the implicit prime implicants.
+*************************************************************************/
+
+shrinquemStatus ReduceLogicBdd(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts)
+{
+    shrinquemStatus status;
+    BddManager* manager = NULL;
+
+    if (truthTable == NULL || sumOfProducts == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (sumOfProducts->numVars > CUBE64_MAX_VARIABLES || sumOfProducts->numVars >= sizeof(size_t) * 8)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    status = CreateBddManager(sumOfProducts->numVars, &manager);
+    if (status != STATUS_OKAY)
+        return status;
+
+    bddNode onSet = BddFromTruthTable(manager, truthTable, LOGIC_TRUE);
+    bddNode dcSet = BddFromTruthTable(manager, truthTable, LOGIC_DONT_CARE);
+    if (onSet == BDD_INVALID || dcSet == BDD_INVALID)
+    {
+        status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+
+    BddRef(manager, onSet);
+    BddRef(manager, dcSet);
+
+    status = BddReorder(manager);
+    if (status == STATUS_OKAY)
+        status = ReduceLogicFromBdd(manager, onSet, dcSet, sumOfProducts);
+
+cleanupAndExit:
+
+    DestroyBddManager(manager);
+
+    return status;
+}
+
+/*************************************************************************
+CoverFromBdd
+Purpose - covers the function given by its on-set and dc-set BDDs with
+  primes, in cubes of cover->numWords words, without listing all the primes.
+  The prime implicants of on + dc are computed as a ZDD and the covering
+  starts on it:
+
+  1. the on-set minterms inside exactly one prime are found from the BDDs of
+     the minterms inside one and inside two of the primes, and the primes
+     touching them are the essential ones,
+  2. the primes touching the on-set the essential ones leave uncovered are
+     the cyclic core, which is counted on its ZDD,
+  3. a core of at most maxPrimes primes is listed and picked from greedily
+     by the number of uncovered on-set minterms, keeping the candidates in a
+     heap by their gains,
+  4. a larger core is never listed. The uncovered on-set is covered by an
+     irredundant sum-of-products of Minato and Morreale, built on the BDDs,
+     and each of its cubes is expanded into a prime,
+
+  and the picks are then made irredundant against each other and the
+  essential primes. info, when given, says which way the cover was made.
+*************************************************************************/
+
+static shrinquemStatus CoverFromBdd(
+    BddManager* manager,
+    bddNode onSet,
+    bddNode dcSet,
+    unsigned long maxPrimes,
+    CubeList* cover,
+    BddCoverInfo* info)
+{
+    shrinquemStatus status = STATUS_OKAY;
+    CubeList candidates = { 0 };
+    CubeList picks = { 0 };
+    bddNode* candidateBdds = NULL;
+    bddNode* pickBdds = NULL;
+    bddNode* prefixCovers = NULL;
+    double* gains = NULL;
+    unsigned long* heap = NULL;
+    unsigned char* isKept = NULL;
+
+    const unsigned long numWords = cover->numWords;
+    candidates.numWords = numWords;
+    picks.numWords = numWords;
+
+    bddNode upperBound = BddOr(manager, onSet, dcSet);
+    bddNode primesZdd = BddPrimeImplicants(manager, upperBound);
+    double numPrimes = ZddCountCubes(manager, primesZdd);
+    if (upperBound == BDD_INVALID || primesZdd == BDD_INVALID || numPrimes < 0.0)
+    {
+        status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+
+    // an on-set minterm that only one prime contains can't be covered without that prime
+    bddNode coveredTwice = ZddCoverTwice(manager, primesZdd);
+    bddNode lonely = BddAnd(manager, onSet, BddNot(manager, coveredTwice));
+    bddNode essentialZdd = ZddTouching(manager, primesZdd, lonely);
+    bddNode essentialCover = ZddCover(manager, essentialZdd);
+    bddNode uncovered = BddAnd(manager, onSet, BddNot(manager, essentialCover));
+    bddNode coreZdd = ZddTouching(manager, ZddDifference(manager, primesZdd, essentialZdd), uncovered);
+    double numCorePrimes = ZddCountCubes(manager, coreZdd);
+    if (coveredTwice == BDD_INVALID || lonely == BDD_INVALID || essentialZdd == BDD_INVALID || essentialCover == BDD_INVALID ||
+        uncovered == BDD_INVALID || coreZdd == BDD_INVALID || numCorePrimes < 0.0)
+    {
+        status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+
+    // the essential primes go first, the picks that turn out to be needed are added after them
+    status = ListZddCubes(manager, essentialZdd, cover);
+    if (status != STATUS_OKAY)
+        goto cleanupAndExit;
+
+    if (info)
+    {
+        info->numPrimes = numPrimes;
+        info->numCorePrimes = numCorePrimes;
+        info->numEssential = cover->numCubes;
+        info->isCoreListed = (numCorePrimes <= (double)maxPrimes);
+    }
+
+    if (numCorePrimes <= (double)maxPrimes)
+    {
+        status = ListZddCubes(manager, coreZdd, &candidates);
+        if (status != STATUS_OKAY)
+            goto cleanupAndExit;
+
+        candidateBdds = (bddNode*)AllocateMemory((candidates.numCubes + 1) * sizeof(bddNode));
+        gains = (double*)AllocateMemory((candidates.numCubes + 1) * sizeof(double));
+        heap = (unsigned long*)AllocateMemory((candidates.numCubes + 1) * sizeof(unsigned long));
+        if (candidateBdds == NULL || gains == NULL || heap == NULL)
+        {
+            status = STATUS_OUT_OF_MEMORY;
+            goto cleanupAndExit;
+        }
+
+        for (unsigned long iCandidate = 0; iCandidate < candidates.numCubes; iCandidate++)
+        {
+            candidateBdds[iCandidate] = BddFromCube(manager, &candidates.values[iCandidate * numWords], &candidates.dontCares[iCandidate * numWords], numWords);
+            gains[iCandidate] = BddSatFraction(manager, BddAnd(manager, uncovered, candidateBdds[iCandidate]));
+            if (candidateBdds[iCandidate] == BDD_INVALID || gains[iCandidate] < 0.0)
+            {
+                status = STATUS_OUT_OF_MEMORY;
+                goto cleanupAndExit;
+            }
+
+            heap[iCandidate] = iCandidate;
+        }
+
+        unsigned long numHeap = candidates.numCubes;
+        for (unsigned long iHeap = numHeap / 2; iHeap-- > 0;)
+            SiftDownByGain(heap, numHeap, iHeap, gains);
+
+        // Greedily pick the prime covering the most uncovered on-set minterms. The uncovered set only
+        // shrinks, so a stale gain is an upper bound and only the top of the heap has to be recounted.
+        while (uncovered != BDD_FALSE && numHeap > 0)
+        {
+            unsigned long best = heap[0];
+            double fraction = BddSatFraction(manager, BddAnd(manager, uncovered, candidateBdds[best]));
+            if (fraction < 0.0)
+            {
+                status = STATUS_OUT_OF_MEMORY;
+                goto cleanupAndExit;
+            }
+
+            gains[best] = fraction;
+            int isPicked = fraction > 0.0 && (numHeap < 2 || gains[heap[1]] <= fraction) && (numHeap < 3 || gains[heap[2]] <= fraction);
+            if (isPicked)
+            {
+                status = AppendCube(&picks, &candidates.values[best * numWords], &candidates.dontCares[best * numWords]);
+                if (status != STATUS_OKAY)
+                    goto cleanupAndExit;
+
+                uncovered = BddAnd(manager, uncovered, BddNot(manager, candidateBdds[best]));
+                if (uncovered == BDD_INVALID)
+                {
+                    status = STATUS_OUT_OF_MEMORY;
+                    goto cleanupAndExit;
+                }
+            }
+
+            // a picked or emptied prime leaves the heap, one that only lost ground sinks to its place
+            if (isPicked || fraction == 0.0)
+                heap[0] = heap[--numHeap];
+            SiftDownByGain(heap, numHeap, 0, gains);
+        }
+    }
+    else
+    {
+        bddNode isopZdd = ZddIsop(manager, uncovered, upperBound);
+        bddNode notUpperBound = BddNot(manager, upperBound);
+        if (isopZdd == BDD_INVALID || notUpperBound == BDD_INVALID)
+        {
+            status = STATUS_OUT_OF_MEMORY;
+            goto cleanupAndExit;
+        }
+
+        status = ListZddCubes(manager, isopZdd, &picks);
+        for (unsigned long iPick = 0; iPick < picks.numCubes && status == STATUS_OKAY; iPick++)
+            status = ExpandToPrime(manager, notUpperBound, &picks.values[iPick * numWords], &picks.dontCares[iPick * numWords], numWords);
+        if (status != STATUS_OKAY)
+            goto cleanupAndExit;
+    }
+
+    // A prime picked early may be covered by the ones picked after it, so check them in reverse order
+    // against the union of the essential primes and the picks before it (prefix) and the ones kept after it (suffix).
+    pickBdds = (bddNode*)AllocateMemory((picks.numCubes + 1) * sizeof(bddNode));
+    prefixCovers = (bddNode*)AllocateMemory((picks.numCubes + 1) * sizeof(bddNode));
+    isKept = (unsigned char*)AllocateZeroed(picks.numCubes + 1, sizeof(unsigned char));
+    if (pickBdds == NULL || prefixCovers == NULL || isKept == NULL)
+    {
+        status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+
+    prefixCovers[0] = essentialCover;
+    for (unsigned long iPick = 0; iPick < picks.numCubes; iPick++)
+    {
+        pickBdds[iPick] = BddFromCube(manager, &picks.values[iPick * numWords], &picks.dontCares[iPick * numWords], numWords);
+        prefixCovers[iPick + 1] = BddOr(manager, prefixCovers[iPick], pickBdds[iPick]);
+        if (prefixCovers[iPick + 1] == BDD_INVALID)
+        {
+            status = STATUS_OUT_OF_MEMORY;
+            goto cleanupAndExit;
+        }
+    }
+
+    bddNode suffixCover = BDD_FALSE;
+    for (unsigned long iPick = picks.numCubes; iPick-- > 0;)
+    {
+        bddNode others = BddOr(manager, prefixCovers[iPick], suffixCover);
+        bddNode onPart = BddAnd(manager, onSet, pickBdds[iPick]);
+        bddNode missed = BddAnd(manager, onPart, BddNot(manager, others));
+        if (others == BDD_INVALID || onPart == BDD_INVALID || missed == BDD_INVALID)
+        {
+            status = STATUS_OUT_OF_MEMORY;
+            goto cleanupAndExit;
+        }
+
+        if (missed != BDD_FALSE)
+        {
+            isKept[iPick] = 1;
+            suffixCover = BddOr(manager, suffixCover, pickBdds[iPick]);
+            if (suffixCover == BDD_INVALID)
+            {
+                status = STATUS_OUT_OF_MEMORY;
+                goto cleanupAndExit;
+            }
+        }
+    }
+
+    for (unsigned long iPick = 0; iPick < picks.numCubes && status == STATUS_OKAY; iPick++)
+    {
+        if (isKept[iPick])
+            status = AppendCube(cover, &picks.values[iPick * numWords], &picks.dontCares[iPick * numWords]);
+    }
+
+cleanupAndExit:
+
+    if (candidateBdds)
+    {
+        FreeMemory(candidateBdds);
+        candidateBdds = NULL;
+    }
+
+    if (pickBdds)
+    {
+        FreeMemory(pickBdds);
+        pickBdds = NULL;
+    }
+
+    if (prefixCovers)
+    {
+        FreeMemory(prefixCovers);
+        prefixCovers = NULL;
+    }
+
+    if (gains)
+    {
+        FreeMemory(gains);
+        gains = NULL;
+    }
+
+    if (heap)
+    {
+        FreeMemory(heap);
+        heap = NULL;
+    }
+
+    if (isKept)
+    {
+        FreeMemory(isKept);
+        isKept = NULL;
+    }
+
+    FreeCubeList(&candidates);
+    FreeCubeList(&picks);
+
+    if (status != STATUS_OKAY)
+        FreeCubeList(cover);
+
+    return status;
+}
+
+static unsigned long BddLevel(
+    const BddManager* manager,
+    bddNode f)
+{
+    unsigned long var = manager->nodes[f].var;
+
+    return (var == BDD_TERMINAL_VAR) ? manager->numVars : manager->var2level[var];
+}
+
+static unsigned long ZddLevel(
+    const BddManager* manager,
+    bddNode f)
+{
+    unsigned long var = manager->nodes[f].var;
+
+    if (var == BDD_TERMINAL_VAR)
+        return 2 * manager->numVars;
+
+    unsigned long zddVar = var - manager->numVars;
+    return 2 * manager->var2level[zddVar >> 1] + (zddVar & 1);
+}
+
+static unsigned long HashChildren(
+    bddNode lo,
+    bddNode hi,
+    unsigned long numBuckets)
+{
+    unsigned long hash = (lo * 0x9E3779B1UL) ^ (hi * 0x85EBCA77UL);
+    hash ^= hash >> 15;
+
+    return hash & (numBuckets - 1);
+}
+
+static int EnsureFreeNodes(
+    BddManager* manager,
+    unsigned long numNeeded)
+{
+    unsigned long newCapacity = manager->capacity;
+
+    while (manager->numFree + (newCapacity - manager->highWater) < numNeeded)
+        newCapacity *= 2;
+
+    if (newCapacity == manager->capacity)
+        return 1;
+
+    BddNodeData* newNodes = (BddNodeData*)ReallocateMemory(manager->nodes, newCapacity * sizeof(BddNodeData));
+    if (newNodes == NULL)
+        return 0;
+
+    manager->nodes = newNodes;
+    manager->capacity = newCapacity;
+
+    // let the computed cache grow along with the nodes, a failure just keeps the smaller cache
+    if (manager->cacheSize < MAX_CACHE_SIZE && manager->cacheSize < newCapacity / 2)
+    {
+        BddCacheEntry* newCache = (BddCacheEntry*)AllocateZeroed(2 * manager->cacheSize, sizeof(BddCacheEntry));
+        if (newCache)
+        {
+            FreeMemory(manager->cache);
+            manager->cache = newCache;
+            manager->cacheSize *= 2;
+        }
+    }
+
+    return 1;
+}
+
+static bddNode AllocateNode(
+    BddManager* manager)
+{
+    bddNode f;
+
+    if (manager->freeList != BDD_INVALID)
+    {
+        f = manager->freeList;
+        manager->freeList = manager->nodes[f].next;
+        manager->numFree--;
+        return f;
+    }
+
+    if (!EnsureFreeNodes(manager, 1))
+        return BDD_INVALID;
+
+    return manager->highWater++;
+}
+
+static void ReleaseNode(
+    BddManager* manager,
+    bddNode f)
+{
+    manager->nodes[f].var = BDD_FREE_VAR;
+    manager->nodes[f].refs = 0;
+    manager->nodes[f].parents = 0;
+    manager->nodes[f].next = manager->freeList;
+    manager->freeList = f;
+    manager->numFree++;
+}
+
+static void InsertIntoSubtable(
+    BddManager* manager,
+    bddNode f)
+{
+    BddSubtable* subtable = &manager->subtables[manager->nodes[f].var];
+
+    // keep the chains short, but a failure to grow only makes them longer
+    if (subtable->numNodes >= 2 * subtable->numBuckets)
+    {
+        unsigned long newNumBuckets = 2 * subtable->numBuckets;
+        bddNode* newBuckets = (bddNode*)AllocateMemory(newNumBuckets * sizeof(bddNode));
+        if (newBuckets)
+        {
+            for (unsigned long iBucket = 0; iBucket < newNumBuckets; iBucket++)
+                newBuckets[iBucket] = BDD_INVALID;
+
+            for (unsigned long iBucket = 0; iBucket < subtable->numBuckets; iBucket++)
+            {
+                bddNode g = subtable->buckets[iBucket];
+                while (g != BDD_INVALID)
+                {
+                    bddNode next = manager->nodes[g].next;
+                    unsigned long hash = HashChildren(manager->nodes[g].lo, manager->nodes[g].hi, newNumBuckets);
+                    manager->nodes[g].next = newBuckets[hash];
+                    newBuckets[hash] = g;
+                    g = next;
+                }
+            }
+
+            FreeMemory(subtable->buckets);
+            subtable->buckets = newBuckets;
+            subtable->numBuckets = newNumBuckets;
+        }
+    }
+
+    unsigned long hash = HashChildren(manager->nodes[f].lo, manager->nodes[f].hi, subtable->numBuckets);
+    manager->nodes[f].next = subtable->buckets[hash];
+    subtable->buckets[hash] = f;
+    subtable->numNodes++;
+}
+
+static void RemoveFromSubtable(
+    BddManager* manager,
+    bddNode f)
+{
+    BddSubtable* subtable = &manager->subtables[manager->nodes[f].var];
+    unsigned long hash = HashChildren(manager->nodes[f].lo, manager->nodes[f].hi, subtable->numBuckets);
+    bddNode* link = &subtable->buckets[hash];
+
+    while (*link != BDD_INVALID)
+    {
+        if (*link == f)
+        {
+            *link = manager->nodes[f].next;
+            subtable->numNodes--;
+            return;
+        }
+
+        link = &manager->nodes[*link].next;
+    }
+}
+
+static bddNode FindOrAddNode(
+    BddManager* manager,
+    unsigned long var,
+    bddNode lo,
+    bddNode hi)
+{
+    BddSubtable* subtable = &manager->subtables[var];
+    unsigned long hash = HashChildren(lo, hi, subtable->numBuckets);
+
+    for (bddNode f = subtable->buckets[hash]; f != BDD_INVALID; f = manager->nodes[f].next)
+    {
+        if (manager->nodes[f].lo == lo && manager->nodes[f].hi == hi)
+            return f;
+    }
+
+    bddNode f = AllocateNode(manager);
+    if (f == BDD_INVALID)
+        return BDD_INVALID;
+
+    manager->nodes[f].var = var;
+    manager->nodes[f].lo = lo;
+    manager->nodes[f].hi = hi;
+    manager->nodes[f].refs = 0;
+    manager->nodes[f].parents = 0;
+    InsertIntoSubtable(manager, f);
+
+    return f;
+}
+
+static bddNode MakeBddNode(
+    BddManager* manager,
+    unsigned long var,
+    bddNode lo,
+    bddNode hi)
+{
+    if (lo == BDD_INVALID || hi == BDD_INVALID)
+        return BDD_INVALID;
+
+    // a node whose children are the same does not depend on its variable
+    if (lo == hi)
+        return lo;
+
+    return FindOrAddNode(manager, var, lo, hi);
+}
+
+static bddNode MakeZddNode(
+    BddManager* manager,
+    unsigned long zddVar,
+    bddNode lo,
+    bddNode hi)
+{
+    if (lo == BDD_INVALID || hi == BDD_INVALID)
+        return BDD_INVALID;
+
+    // a ZDD node whose high child is the empty set does not contain its literal
+    if (hi == BDD_FALSE)
+        return lo;
+
+    return FindOrAddNode(manager, manager->numVars + zddVar, lo, hi);
+}
+
+static int LookupCache(
+    const BddManager* manager,
+    bddOp op,
+    bddNode f,
+    bddNode g,
+    bddNode* result)
+{
+    unsigned long hash = (HashChildren(f, g, manager->cacheSize) + op) & (manager->cacheSize - 1);
+    const BddCacheEntry* entry = &manager->cache[hash];
+
+    if (entry->op == (unsigned long)op && entry->f == f && entry->g == g)
+    {
+        *result = entry->result;
+        return 1;
+    }
+
+    return 0;
+}
+
+static void InsertCache(
+    BddManager* manager,
+    bddOp op,
+    bddNode f,
+    bddNode g,
+    bddNode result)
+{
+    unsigned long hash = (HashChildren(f, g, manager->cacheSize) + op) & (manager->cacheSize - 1);
+    BddCacheEntry* entry = &manager->cache[hash];
+
+    entry->op = op;
+    entry->f = f;
+    entry->g = g;
+    entry->result = result;
+}
+
+static void ClearCache(
+    BddManager* manager)
+{
+    memset(manager->cache, 0, manager->cacheSize * sizeof(BddCacheEntry));
+}
+
+static bddNode BddApply(
+    BddManager* manager,
+    bddOp op,
+    bddNode f,
+    bddNode g)
+{
+    bddNode result;
+
+    if (f == BDD_INVALID || g == BDD_INVALID)
+        return BDD_INVALID;
+
+    // terminal cases
+    switch (op)
+    {
+    case OP_AND:
+        if (f == BDD_FALSE || g == BDD_FALSE)
+            return BDD_FALSE;
+        if (f == BDD_TRUE || f == g)
+            return g;
+        if (g == BDD_TRUE)
+            return f;
+        break;
+    case OP_OR:
+        if (f == BDD_TRUE || g == BDD_TRUE)
+            return BDD_TRUE;
+        if (f == BDD_FALSE || f == g)
+            return g;
+        if (g == BDD_FALSE)
+            return f;
+        break;
+    default: // OP_XOR
+        if (f == g)
+            return BDD_FALSE;
+        if (f == BDD_FALSE)
+            return g;
+        if (g == BDD_FALSE)
+            return f;
+        break;
+    }
+
+    // all the operations are commutative
+    if (f > g)
+    {
+        bddNode swap = f;
+        f = g;
+        g = swap;
+    }
+
+    if (LookupCache(manager, op, f, g, &result))
+        return result;
+
+    unsigned long levelF = BddLevel(manager, f);
+    unsigned long levelG = BddLevel(manager, g);
+    unsigned long level = (levelF < levelG) ? levelF : levelG;
+    unsigned long var = manager->level2var[level];
+    bddNode f0 = (levelF == level) ? manager->nodes[f].lo : f;
+    bddNode f1 = (levelF == level) ? manager->nodes[f].hi : f;
+    bddNode g0 = (levelG == level) ? manager->nodes[g].lo : g;
+    bddNode g1 = (levelG == level) ? manager->nodes[g].hi : g;
+
+    bddNode lo = BddApply(manager, op, f0, g0);
+    bddNode hi = BddApply(manager, op, f1, g1);
+    result = MakeBddNode(manager, var, lo, hi);
+    if (result == BDD_INVALID)
+        return BDD_INVALID;
+
+    InsertCache(manager, op, f, g, result);
+
+    return result;
+}
+
+static bddNode ZddDifference(
+    BddManager* manager,
+    bddNode p,
+    bddNode q)
+{
+    bddNode result;
+
+    if (p == BDD_INVALID || q == BDD_INVALID)
+        return BDD_INVALID;
+
+    if (p == BDD_FALSE || p == q)
+        return BDD_FALSE;
+
+    if (q == BDD_FALSE)
+        return p;
+
+    if (LookupCache(manager, OP_ZDD_DIFF, p, q, &result))
+        return result;
+
+    unsigned long levelP = ZddLevel(manager, p);
+    unsigned long levelQ = ZddLevel(manager, q);
+
+    if (levelP < levelQ)
+    {
+        bddNode lo = ZddDifference(manager, manager->nodes[p].lo, q);
+        result = MakeZddNode(manager, manager->nodes[p].var - manager->numVars, lo, manager->nodes[p].hi);
+    }
+    else if (levelP > levelQ)
+    {
+        result = ZddDifference(manager, p, manager->nodes[q].lo);
+    }
+    else
+    {
+        bddNode lo = ZddDifference(manager, manager->nodes[p].lo, manager->nodes[q].lo);
+        bddNode hi = ZddDifference(manager, manager->nodes[p].hi, manager->nodes[q].hi);
+        result = MakeZddNode(manager, manager->nodes[p].var - manager->numVars, lo, hi);
+    }
+
+    if (result == BDD_INVALID)
+        return BDD_INVALID;
+
+    InsertCache(manager, OP_ZDD_DIFF, p, q, result);
+
+    return result;
+}
+
+// the BDD of the minterms inside at least one cube of the ZDD
+static bddNode ZddCover(
+    BddManager* manager,
+    bddNode zdd)
+{
+    bddNode result;
+
+    if (zdd == BDD_INVALID || zdd == BDD_FALSE || zdd == BDD_TRUE)
+        return zdd;
+
+    if (LookupCache(manager, OP_ZDD_COVER, zdd, 0, &result))
+        return result;
+
+    unsigned long zddVar = manager->nodes[zdd].var - manager->numVars;
+    bddNode literal = ZddLiteral(manager, zddVar);
+    bddNode lo = ZddCover(manager, manager->nodes[zdd].lo);
+    bddNode hi = ZddCover(manager, manager->nodes[zdd].hi);
+
+    result = BddOr(manager, lo, BddAnd(manager, literal, hi));
+    if (result == BDD_INVALID)
+        return BDD_INVALID;
+
+    InsertCache(manager, OP_ZDD_COVER, zdd, 0, result);
+
+    return result;
+}
+
+// the BDD of the minterms inside at least two cubes of the ZDD
+static bddNode ZddCoverTwice(
+    BddManager* manager,
+    bddNode zdd)
+{
+    bddNode result;
+
+    if (zdd == BDD_INVALID)
+        return BDD_INVALID;
+
+    if (zdd == BDD_FALSE || zdd == BDD_TRUE)
+        return BDD_FALSE;
+
+    if (LookupCache(manager, OP_ZDD_COVER_TWICE, zdd, 0, &result))
+        return result;
+
+    // twice in the cubes without the literal, twice in the ones with it, or once in each
+    unsigned long zddVar = manager->nodes[zdd].var - manager->numVars;
+    bddNode literal = ZddLiteral(manager, zddVar);
+    bddNode lo = manager->nodes[zdd].lo;
+    bddNode hi = manager->nodes[zdd].hi;
+    bddNode withLiteral = BddOr(manager, ZddCoverTwice(manager, hi), BddAnd(manager, ZddCover(manager, lo), ZddCover(manager, hi)));
+
+    result = BddOr(manager, ZddCoverTwice(manager, lo), BddAnd(manager, literal, withLiteral));
+    if (result == BDD_INVALID)
+        return BDD_INVALID;
+
+    InsertCache(manager, OP_ZDD_COVER_TWICE, zdd, 0, result);
+
+    return result;
+}
+
+/*************************************************************************
+ZddTouching
+Purpose - returns the ZDD of the cubes of zdd which share a minterm with the
+  BDD f. Both are split on their top variable x into the cubes without it,
+  with x' and with x, and the cofactors f0 and f1:
+
+  Touching(none + x' neg + x pos, f) = Touching(none, f0 + f1) + x' Touching(neg, f0) + x Touching(pos, f1)
+*************************************************************************/
+
+static bddNode ZddTouching(
+    BddManager* manager,
+    bddNode zdd,
+    bddNode f)
+{
+    bddNode result;
+
+    if (zdd == BDD_INVALID || f == BDD_INVALID)
+        return BDD_INVALID;
+
+    if (zdd == BDD_FALSE || f == BDD_FALSE)
+        return BDD_FALSE;
+
+    // every cube shares a minterm with the constant true, and the empty cube with anything else
+    if (f == BDD_TRUE || zdd == BDD_TRUE)
+        return zdd;
+
+    if (LookupCache(manager, OP_ZDD_TOUCHING, zdd, f, &result))
+        return result;
+
+    unsigned long levelZdd = ZddLevel(manager, zdd) / 2;
+    unsigned long levelF = BddLevel(manager, f);
+    unsigned long level = (levelZdd < levelF) ? levelZdd : levelF;
+    unsigned long var = manager->level2var[level];
+    bddNode f0 = (levelF == level) ? manager->nodes[f].lo : f;
+    bddNode f1 = (levelF == level) ? manager->nodes[f].hi : f;
+    bddNode none = zdd;
+    bddNode neg = BDD_FALSE;
+    bddNode pos = BDD_FALSE;
+
+    if (levelZdd == level && manager->nodes[none].var == manager->numVars + 2 * var)
+    {
+        pos = manager->nodes[none].hi;
+        none = manager->nodes[none].lo;
+    }
+
+    if (none != BDD_FALSE && none != BDD_TRUE && manager->nodes[none].var == manager->numVars + 2 * var + 1)
+    {
+        neg = manager->nodes[none].hi;
+        none = manager->nodes[none].lo;
+    }
+
+    none = ZddTouching(manager, none, BddOr(manager, f0, f1));
+    neg = ZddTouching(manager, neg, f0);
+    pos = ZddTouching(manager, pos, f1);
+
+    result = MakeZddNode(manager, 2 * var, MakeZddNode(manager, 2 * var + 1, none, neg), pos);
+    if (result == BDD_INVALID)
+        return BDD_INVALID;
+
+    InsertCache(manager, OP_ZDD_TOUCHING, zdd, f, result);
+
+    return result;
+}
+
+/*************************************************************************
+ZddIsop
+Purpose - returns the ZDD of an irredundant sum-of-products covering every
+  minterm of the BDD lower and none outside the BDD upper, which holds lower.
+  It is the recursion of Minato and Morreale on the top variable x:
+
+  x' Isop(lower0 upper1', upper0) + x Isop(lower1 upper0', upper1) + Isop(rest, upper0 upper1)
+
+  where rest is the part of lower0 + lower1 the first two covers leave out.
+*************************************************************************/
+
+static bddNode ZddIsop(
+    BddManager* manager,
+    bddNode lower,
+    bddNode upper)
+{
+    bddNode result;
+
+    if (lower == BDD_INVALID || upper == BDD_INVALID)
+        return BDD_INVALID;
+
+    if (lower == BDD_FALSE)
+        return BDD_FALSE;
+
+    if (upper == BDD_TRUE)
+        return BDD_TRUE;
+
+    if (LookupCache(manager, OP_ISOP, lower, upper, &result))
+        return result;
+
+    unsigned long levelLower = BddLevel(manager, lower);
+    unsigned long levelUpper = BddLevel(manager, upper);
+    unsigned long level = (levelLower < levelUpper) ? levelLower : levelUpper;
+    unsigned long var = manager->level2var[level];
+    bddNode lower0 = (levelLower == level) ? manager->nodes[lower].lo : lower;
+    bddNode lower1 = (levelLower == level) ? manager->nodes[lower].hi : lower;
+    bddNode upper0 = (levelUpper == level) ? manager->nodes[upper].lo : upper;
+    bddNode upper1 = (levelUpper == level) ? manager->nodes[upper].hi : upper;
+
+    bddNode neg = ZddIsop(manager, BddAnd(manager, lower0, BddNot(manager, upper1)), upper0);
+    bddNode pos = ZddIsop(manager, BddAnd(manager, lower1, BddNot(manager, upper0)), upper1);
+    bddNode rest0 = BddAnd(manager, lower0, BddNot(manager, ZddCover(manager, neg)));
+    bddNode rest1 = BddAnd(manager, lower1, BddNot(manager, ZddCover(manager, pos)));
+    bddNode none = ZddIsop(manager, BddOr(manager, rest0, rest1), BddAnd(manager, upper0, upper1));
+
+    result = MakeZddNode(manager, 2 * var, MakeZddNode(manager, 2 * var + 1, none, neg), pos);
+    if (result == BDD_INVALID)
+        return BDD_INVALID;
+
+    InsertCache(manager, OP_ISOP, lower, upper, result);
+
+    return result;
+}
+
+// the BDD of the single literal of a ZDD variable
+static bddNode ZddLiteral(
+    BddManager* manager,
+    unsigned long zddVar)
+{
+    if (zddVar & 1)
+        return MakeBddNode(manager, zddVar >> 1, BDD_TRUE, BDD_FALSE);
+
+    return MakeBddNode(manager, zddVar >> 1, BDD_FALSE, BDD_TRUE);
+}
+
+static bddNode BuildFromTruthTable(
+    BddManager* manager,
+    const triLogic truthTable[],
+    triLogic value,
+    unsigned long level,
+    cube64 input)
+{
+    if (level == manager->numVars)
+        return (truthTable[input] == value) ? BDD_TRUE : BDD_FALSE;
+
+    unsigned long var = manager->level2var[level];
+    bddNode lo = BuildFromTruthTable(manager, truthTable, value, level + 1, input);
+    bddNode hi = BuildFromTruthTable(manager, truthTable, value, level + 1, input | CUBE64_BIT(var));
+
+    return MakeBddNode(manager, var, lo, hi);
+}
+
+// the variables of the words past numWords are not part of the cube
+static bddNode BddFromCube(
+    BddManager* manager,
+    const cube64 value[],
+    const cube64 dontCares[],
+    unsigned long numWords)
+{
+    bddNode cube = BDD_TRUE;
+
+    // build from the bottom level up so every node is made over its children
+    for (unsigned long level = manager->numVars; level-- > 0;)
+    {
+        unsigned long var = manager->level2var[level];
+        unsigned long iWord = var / CUBE64_MAX_VARIABLES;
+        cube64 bitMask = CUBE64_BIT(var % CUBE64_MAX_VARIABLES);
+
+        if (iWord >= numWords || (dontCares[iWord] & bitMask))
+            continue;
+
+        if (value[iWord] & bitMask)
+            cube = MakeBddNode(manager, var, BDD_FALSE, cube);
+        else
+            cube = MakeBddNode(manager, var, cube, BDD_FALSE);
+
+        if (cube == BDD_INVALID)
+            return BDD_INVALID;
+    }
+
+    return cube;
+}
+
+static double BddSatFraction(
+    BddManager* manager,
+    bddNode f)
+{
+    if (f == BDD_INVALID || !StartCountMemo(manager))
+        return -1.0;
+
+    return SatFractionRecursive(manager, f);
+}
+
+static double SatFractionRecursive(
+    BddManager* manager,
+    bddNode f)
+{
+    if (f == BDD_FALSE)
+        return 0.0;
+
+    if (f == BDD_TRUE)
+        return 1.0;
+
+    if (manager->satEpochs[f] == manager->satEpoch)
+        return manager->satValues[f];
+
+    double fraction = 0.5 * (SatFractionRecursive(manager, manager->nodes[f].lo) +
+        SatFractionRecursive(manager, manager->nodes[f].hi));
+
+    manager->satEpochs[f] = manager->satEpoch;
+    manager->satValues[f] = fraction;
+
+    return fraction;
+}
+
+// the number of cubes of a ZDD, which for the primes of a wide function can be far too many to list
+static double ZddCountCubes(
+    BddManager* manager,
+    bddNode zdd)
+{
+    if (zdd == BDD_INVALID || !StartCountMemo(manager))
+        return -1.0;
+
+    return CountCubesRecursive(manager, zdd);
+}
+
+static double CountCubesRecursive(
+    BddManager* manager,
+    bddNode zdd)
+{
+    if (zdd == BDD_FALSE)
+        return 0.0;
+
+    if (zdd == BDD_TRUE)
+        return 1.0;
+
+    if (manager->satEpochs[zdd] == manager->satEpoch)
+        return manager->satValues[zdd];
+
+    double numCubes = CountCubesRecursive(manager, manager->nodes[zdd].lo) + CountCubesRecursive(manager, manager->nodes[zdd].hi);
+
+    manager->satEpochs[zdd] = manager->satEpoch;
+    manager->satValues[zdd] = numCubes;
+
+    return numCubes;
+}
+
+// makes room for a value per node and forgets the ones of the last count
+static int StartCountMemo(
+    BddManager* manager)
+{
+    if (manager->satCapacity < manager->highWater)
+    {
+        double* newValues = (double*)ReallocateMemory(manager->satValues, manager->capacity * sizeof(double));
+        if (newValues == NULL)
+            return 0;
+        manager->satValues = newValues;
+
+        unsigned long* newEpochs = (unsigned long*)ReallocateMemory(manager->satEpochs, manager->capacity * sizeof(unsigned long));
+        if (newEpochs == NULL)
+            return 0;
+        manager->satEpochs = newEpochs;
+
+        for (unsigned long iNode = manager->satCapacity; iNode < manager->capacity; iNode++)
+            manager->satEpochs[iNode] = 0;
+
+        manager->satCapacity = manager->capacity;
+    }
+
+    // epochs save clearing the memo between calls
+    manager->satEpoch++;
+    if (manager->satEpoch == 0)
+    {
+        memset(manager->satEpochs, 0, manager->satCapacity * sizeof(unsigned long));
+        manager->satEpoch = 1;
+    }
+
+    return 1;
+}
+
+static void MarkNodes(
+    BddManager* manager,
+    bddNode f)
+{
+    if (f == BDD_FALSE || f == BDD_TRUE || manager->nodes[f].parents)
+        return;
+
+    manager->nodes[f].parents = 1;
+    MarkNodes(manager, manager->nodes[f].lo);
+    MarkNodes(manager, manager->nodes[f].hi);
+}
+
+static void DerefParent(
+    BddManager* manager,
+    bddNode f)
+{
+    if (f == BDD_FALSE || f == BDD_TRUE)
+        return;
+
+    if (--manager->nodes[f].parents > 0)
+        return;
+
+    // nothing refers to this node anymore
+    bddNode lo = manager->nodes[f].lo;
+    bddNode hi = manager->nodes[f].hi;
+    RemoveFromSubtable(manager, f);
+    ReleaseNode(manager, f);
+    DerefParent(manager, lo);
+    DerefParent(manager, hi);
+}
+
+static bddNode FindOrAddSwappedNode(
+    BddManager* manager,
+    unsigned long var,
+    bddNode lo,
+    bddNode hi)
+{
+    if (lo == hi)
+    {
+        manager->nodes[lo].parents++;
+        return lo;
+    }
+
+    unsigned long numNodes = manager->subtables[var].numNodes;
+    bddNode f = FindOrAddNode(manager, var, lo, hi);
+
+    if (manager->subtables[var].numNodes != numNodes)
+    {
+        // a new node holds references to its children
+        manager->nodes[lo].parents++;
+        manager->nodes[hi].parents++;
+    }
+
+    manager->nodes[f].parents++;
+
+    return f;
+}
+
+/*************************************************************************
+SwapAdjacentLevels
+Purpose - swaps the variables at level and level + 1. A node F of the upper
+  variable x that depends on the lower variable y is rewritten in place as
+
+  F = y' (x' F00 + x F10) + y (x' F01 + x F11)
+
+  so every handle to F keeps denoting the same function. Nodes of y that lose
+  their last parent are freed right away, which keeps BddNodeCount exact.
+*************************************************************************/
+
+static int SwapAdjacentLevels(
+    BddManager* manager,
+    unsigned long level)
+{
+    unsigned long x = manager->level2var[level];
+    unsigned long y = manager->level2var[level + 1];
+    BddSubtable* subtableX = &manager->subtables[x];
+    unsigned long numX = subtableX->numNodes;
+    unsigned long numDependent = 0;
+    bddNode* nodesX = NULL;
+
+    // each rewritten node makes at most two new nodes, so allocate them up front
+    if (!EnsureFreeNodes(manager, 2 * numX))
+        return 0;
+
+    nodesX = (bddNode*)AllocateMemory((numX + 1) * sizeof(bddNode));
+    if (nodesX == NULL)
+        return 0;
+
+    unsigned long iNode = 0;
+    for (unsigned long iBucket = 0; iBucket < subtableX->numBuckets; iBucket++)
+    {
+        for (bddNode f = subtableX->buckets[iBucket]; f != BDD_INVALID; f = manager->nodes[f].next)
+            nodesX[iNode++] = f;
+        subtableX->buckets[iBucket] = BDD_INVALID;
+    }
+    subtableX->numNodes = 0;
+
+    // nodes independent of y just move down a level, and they go back first so the rewrites below can share them
+    for (iNode = 0; iNode < numX; iNode++)
+    {
+        bddNode f = nodesX[iNode];
+        if (manager->nodes[manager->nodes[f].lo].var != y && manager->nodes[manager->nodes[f].hi].var != y)
+            InsertIntoSubtable(manager, f);
+        else
+            nodesX[numDependent++] = f;
+    }
+
+    for (iNode = 0; iNode < numDependent; iNode++)
+    {
+        bddNode f = nodesX[iNode];
+        bddNode f0 = manager->nodes[f].lo;
+        bddNode f1 = manager->nodes[f].hi;
+        int f0DependsOnY = (manager->nodes[f0].var == y);
+        int f1DependsOnY = (manager->nodes[f1].var == y);
+        bddNode f00 = f0DependsOnY ? manager->nodes[f0].lo : f0;
+        bddNode f01 = f0DependsOnY ? manager->nodes[f0].hi : f0;
+        bddNode f10 = f1DependsOnY ? manager->nodes[f1].lo : f1;
+        bddNode f11 = f1DependsOnY ? manager->nodes[f1].hi : f1;
+
+        bddNode lo = FindOrAddSwappedNode(manager, x, f00, f10);
+        bddNode hi = FindOrAddSwappedNode(manager, x, f01, f11);
+
+        manager->nodes[f].var = y;
+        manager->nodes[f].lo = lo;
+        manager->nodes[f].hi = hi;
+        InsertIntoSubtable(manager, f);
+
+        DerefParent(manager, f0);
+        DerefParent(manager, f1);
+    }
+
+    FreeMemory(nodesX);
+
+    manager->level2var[level] = y;
+    manager->level2var[level + 1] = x;
+    manager->var2level[x] = level + 1;
+    manager->var2level[y] = level;
+
+    return 1;
+}
+
+// lists the cubes of a ZDD in words of cubes->numWords each
+static shrinquemStatus ListZddCubes(
+    BddManager* manager,
+    bddNode zdd,
+    CubeList* cubes)
+{
+    cube64 value[MAX_CUBE_WORDS];
+    cube64 dontCares[MAX_CUBE_WORDS];
+
+    for (unsigned long iWord = 0; iWord < cubes->numWords; iWord++)
+    {
+        value[iWord] = 0;
+        dontCares[iWord] = ~(cube64)0;
+    }
+
+    return CollectZddCubes(manager, zdd, value, dontCares, cubes);
+}
+
+static shrinquemStatus CollectZddCubes(
+    BddManager* manager,
+    bddNode zdd,
+    cube64 value[],
+    cube64 dontCares[],
+    CubeList* cubes)
+{
+    shrinquemStatus status;
+
+    if (zdd == BDD_FALSE)
+        return STATUS_OKAY;
+
+    if (zdd == BDD_TRUE)
+        return AppendCube(cubes, value, dontCares);
+
+    unsigned long zddVar = manager->nodes[zdd].var - manager->numVars;
+    unsigned long iWord = (zddVar >> 1) / CUBE64_MAX_VARIABLES;
+    cube64 bitMask = CUBE64_BIT((zddVar >> 1) % CUBE64_MAX_VARIABLES);
+
+    status = CollectZddCubes(manager, manager->nodes[zdd].lo, value, dontCares, cubes);
+    if (status != STATUS_OKAY)
+        return status;
+
+    // the high branch adds the literal, positive for even ZDD variables and negative for odd ones
+    dontCares[iWord] &= ~bitMask;
+    if (!(zddVar & 1))
+        value[iWord] |= bitMask;
+
+    status = CollectZddCubes(manager, manager->nodes[zdd].hi, value, dontCares, cubes);
+
+    dontCares[iWord] |= bitMask;
+    value[iWord] &= ~bitMask;
+
+    return status;
+}
+
+static shrinquemStatus AppendCube(
+    CubeList* cubes,
+    const cube64 value[],
+    const cube64 dontCares[])
+{
+    if (cubes->numCubes == cubes->capacity)
+    {
+        unsigned long newCapacity = cubes->capacity ? 2 * cubes->capacity : 64;
+        void* p;
+
+        p = ReallocateMemory(cubes->values, newCapacity * cubes->numWords * sizeof(cube64));
+        if (p == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        cubes->values = p;
+
+        p = ReallocateMemory(cubes->dontCares, newCapacity * cubes->numWords * sizeof(cube64));
+        if (p == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        cubes->dontCares = p;
+
+        cubes->capacity = newCapacity;
+    }
+
+    for (unsigned long iWord = 0; iWord < cubes->numWords; iWord++)
+    {
+        cubes->values[cubes->numCubes * cubes->numWords + iWord] = value[iWord];
+        cubes->dontCares[cubes->numCubes * cubes->numWords + iWord] = dontCares[iWord];
+    }
+    cubes->numCubes++;
+
+    return STATUS_OKAY;
+}
+
+static void FreeCubeList(
+    CubeList* cubes)
+{
+    if (cubes->values)
+        FreeMemory(cubes->values);
+
+    if (cubes->dontCares)
+        FreeMemory(cubes->dontCares);
+
+    cubes->values = NULL;
+    cubes->dontCares = NULL;
+    cubes->numCubes = 0;
+    cubes->capacity = 0;
+}
+
+// drops the literals of a cube one at a time while it stays clear of the BDD outside, which leaves a prime
+static shrinquemStatus ExpandToPrime(
+    BddManager* manager,
+    bddNode outside,
+    cube64 value[],
+    cube64 dontCares[],
+    unsigned long numWords)
+{
+    for (unsigned long level = 0; level < manager->numVars; level++)
+    {
+        unsigned long var = manager->level2var[level];
+        unsigned long iWord = var / CUBE64_MAX_VARIABLES;
+        cube64 bitMask = CUBE64_BIT(var % CUBE64_MAX_VARIABLES);
+        if (dontCares[iWord] & bitMask)
+            continue;
+
+        dontCares[iWord] |= bitMask;
+        bddNode overlap = BddAnd(manager, BddFromCube(manager, value, dontCares, numWords), outside);
+        if (overlap == BDD_INVALID)
+            return STATUS_OUT_OF_MEMORY;
+
+        // put the literal back if the cube would reach outside without it
+        if (overlap == BDD_FALSE)
+            value[iWord] &= ~bitMask;
+        else
+            dontCares[iWord] &= ~bitMask;
+    }
+
+    return STATUS_OKAY;
+}
+
+// restores the order of a max-heap of candidates by their gains below position iHeap
+static void SiftDownByGain(
+    unsigned long heap[],
+    unsigned long numHeap,
+    unsigned long iHeap,
+    const double gains[])
+{
+    while (1)
+    {
+        unsigned long iLargest = iHeap;
+        unsigned long iLeft = 2 * iHeap + 1;
+        unsigned long iRight = iLeft + 1;
+
+        if (iLeft < numHeap && gains[heap[iLeft]] > gains[heap[iLargest]])
+            iLargest = iLeft;
+
+        if (iRight < numHeap && gains[heap[iRight]] > gains[heap[iLargest]])
+            iLargest = iRight;
+
+        if (iLargest == iHeap)
+            return;
+
+        unsigned long swap = heap[iHeap];
+        heap[iHeap] = heap[iLargest];
+        heap[iLargest] = swap;
+        iHeap = iLargest;
+    }
+}
@@ -0,0 +1,452 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <stdio.h> // used for fopen, fwrite
+#include <string.h> // used for memcpy, memset
+#if defined(_WIN32)
+#include <windows.h> // used for CreateFileMapping, MapViewOfFile
+#else
+#include <fcntl.h> // used for open
+#include <sys/mman.h> // used for mmap
+#include <sys/stat.h> // used for fstat
+#include <unistd.h> // used for close
+#endif
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define BINARY_MAGIC "SHQB"
+#define BINARY_HEADER_SIZE (64)
+#define BINARY_INDEX_MAX_VARS (8)
+#define BINARY_INDEX_MAX_GROWTH (16) // index entries allowed per term before fewer variables are used
+#define BINARY_WRITE_WORDS (1024)
+
+static int IsLittleEndianHost(void);
+static cube64 AlignOffset(cube64 offset);
+static unsigned long ChooseIndexVars(const CubeStore* store, cube64* numEntries);
+static cube64 IndexBits(cube64 word, unsigned long numVars, unsigned long numIndexVars);
+
+/*************************************************************************
+WriteSumOfProductsBinary
+Purpose - writes a cover to a binary file that MapSumOfProductsBinary can
+  use in place, without parsing or copying.
+
+All numbers are little-endian. The file is a header of BINARY_HEADER_SIZE
+bytes, then the cares and values arrays of CubeStoreFromSumOfProducts, each
+aligned to CUBE_STORE_ALIGNMENT bytes and padded the same way, then the
+optional index:
+
+  offset  size  field
+       0     4  "SHQB"
+       4     4  SHRINQUEM_BINARY_VERSION
+       8     4  numVars
+      12     4  polarity
+      16     8  numTerms
+      24     8  capacity, numTerms rounded up to whole blocks of CUBE_STORE_LANES
+      32     8  offset of the cares
+      40     8  offset of the values
+      48     8  offset of the index, 0 when there is none
+      56     4  numIndexVars
+      60     4  0
+
+The index splits the inputs on the numIndexVars highest variables. For
+each of their 2^numIndexVars values it lists the terms that can hold an
+input with it, as 2^numIndexVars + 1 uint32 start positions followed by the
+uint32 term indices, so an evaluation only tests the terms of its bucket.
+*************************************************************************/
+
+shrinquemStatus WriteSumOfProductsBinary(
+    const char* path,
+    const SumOfProducts* sumOfProducts,
+    int withIndex)
+{
+    if (path == NULL || sumOfProducts == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (sumOfProducts->numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+    else if (sumOfProducts->numVars > CUBE64_MAX_VARIABLES)
+        return STATUS_TOO_MANY_VARIABLES;
+    else if (sumOfProducts->numTerms > (cube64)UINT32_MAX)
+        return STATUS_INVALID_ARGUMENT;
+
+    CubeStore store = { 0 };
+    unsigned char header[BINARY_HEADER_SIZE];
+    unsigned char zeros[CUBE_STORE_ALIGNMENT] = { 0 };
+    uint32_t* indexStarts = NULL;
+    uint32_t* indexTerms = NULL;
+    unsigned long numIndexVars = 0;
+    cube64 numIndexEntries = 0;
+    shrinquemStatus status = CubeStoreFromSumOfProducts(sumOfProducts, &store);
+    if (status != STATUS_OKAY)
+        return status;
+
+    if (withIndex)
+    {
+        numIndexVars = ChooseIndexVars(&store, &numIndexEntries);
+        const unsigned long numBuckets = 1UL << numIndexVars;
+
+        indexStarts = AllocateZeroed(numBuckets + 1, sizeof(uint32_t));
+        indexTerms = AllocateMemory((size_t)(numIndexEntries + 1) * sizeof(uint32_t));
+        if (indexStarts == NULL || indexTerms == NULL)
+        {
+            status = STATUS_OUT_OF_MEMORY;
+            goto cleanupAndExit;
+        }
+
+        // count the terms of each bucket, then fill them in
+        for (int isFilling = 0; isFilling < 2; isFilling++)
+        {
+            for (unsigned long iTerm = 0; iTerm < store.numTerms; iTerm++)
+            {
+                cube64 care = IndexBits(store.cares[iTerm], store.numVars, numIndexVars);
+                cube64 value = IndexBits(store.values[iTerm], store.numVars, numIndexVars);
+                for (cube64 iBucket = 0; iBucket < numBuckets; iBucket++)
+                {
+                    if (((iBucket ^ value) & care) != 0)
+                        continue;
+                    if (isFilling)
+                        indexTerms[indexStarts[iBucket]++] = (uint32_t)iTerm;
+                    else
+                        indexStarts[iBucket + 1]++;
+                }
+            }
+
+            if (!isFilling)
+            {
+                for (unsigned long iBucket = 0; iBucket < numBuckets; iBucket++)
+                    indexStarts[iBucket + 1] += indexStarts[iBucket];
+            }
+            else
+            {
+                // filling moved each start to the next one's, so shift them back
+                for (unsigned long iBucket = numBuckets; iBucket > 0; iBucket--)
+                    indexStarts[iBucket] = indexStarts[iBucket - 1];
+                indexStarts[0] = 0;
+            }
+        }
+    }
+
+    const cube64 caresOffset = BINARY_HEADER_SIZE;
+    const cube64 valuesOffset = AlignOffset(caresOffset + (cube64)store.capacity * sizeof(cube64));
+    const cube64 indexOffset = withIndex ? AlignOffset(valuesOffset + (cube64)store.capacity * sizeof(cube64)) : 0;
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, BINARY_MAGIC, 4);
+    PutLittleEndian(header + 4, SHRINQUEM_BINARY_VERSION, 4);
+    PutLittleEndian(header + 8, store.numVars, 4);
+    PutLittleEndian(header + 12, store.polarity, 4);
+    PutLittleEndian(header + 16, store.numTerms, 8);
+    PutLittleEndian(header + 24, store.capacity, 8);
+    PutLittleEndian(header + 32, caresOffset, 8);
+    PutLittleEndian(header + 40, valuesOffset, 8);
+    PutLittleEndian(header + 48, indexOffset, 8);
+    PutLittleEndian(header + 56, numIndexVars, 4);
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        status = STATUS_FILE_ERROR;
+        goto cleanupAndExit;
+    }
+
+    // the arrays are a whole number of aligned blocks, so only the index needs padding in front
+    cube64 end = valuesOffset + (cube64)store.capacity * sizeof(cube64);
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header))
+        status = STATUS_FILE_ERROR;
+    if (status == STATUS_OKAY)
+        status = WriteLittleEndianWords(file, store.cares, store.capacity);
+    if (status == STATUS_OKAY)
+        status = WriteLittleEndianWords(file, store.values, store.capacity);
+    if (status == STATUS_OKAY && withIndex && fwrite(zeros, 1, (size_t)(indexOffset - end), file) != (size_t)(indexOffset - end))
+        status = STATUS_FILE_ERROR;
+
+    if (status == STATUS_OKAY && withIndex)
+    {
+        const unsigned long numBuckets = 1UL << numIndexVars;
+        unsigned char bytes[4];
+        for (unsigned long iStart = 0; iStart <= numBuckets && status == STATUS_OKAY; iStart++)
+        {
+            PutLittleEndian(bytes, indexStarts[iStart], 4);
+            if (fwrite(bytes, 1, 4, file) != 4)
+                status = STATUS_FILE_ERROR;
+        }
+        for (cube64 iEntry = 0; iEntry < numIndexEntries && status == STATUS_OKAY; iEntry++)
+        {
+            PutLittleEndian(bytes, indexTerms[iEntry], 4);
+            if (fwrite(bytes, 1, 4, file) != 4)
+                status = STATUS_FILE_ERROR;
+        }
+    }
+
+    if (fclose(file) != 0)
+        status = STATUS_FILE_ERROR;
+
+cleanupAndExit:
+
+    FinalizeCubeStore(&store);
+    FreeMemory(indexStarts);
+    FreeMemory(indexTerms);
+
+    return status;
+}
+
+/*************************************************************************
+MapSumOfProductsBinary
+Purpose - maps a file of WriteSumOfProductsBinary read-only and points a
+  cube store at its arrays, so it is evaluated straight from the mapping
+  with nothing copied or allocated. Processes mapping the same file share
+  its pages.
+
+The header, the offsets and every index entry are checked against the size
+of the file first, and STATUS_PARSE_ERROR is returned when any is wrong.
+The file is little-endian, so on a big-endian host it can't be used in
+place and STATUS_INVALID_ARGUMENT is returned. The store must not be
+finalized or written to, UnmapSumOfProductsBinary releases it.
+*************************************************************************/
+
+shrinquemStatus MapSumOfProductsBinary(
+    const char* path,
+    MappedSumOfProducts* mapped)
+{
+    if (path == NULL || mapped == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    memset(mapped, 0, sizeof(MappedSumOfProducts));
+
+    if (!IsLittleEndianHost())
+        return STATUS_INVALID_ARGUMENT;
+
+    size_t size = 0;
+    void* mapping = NULL;
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return STATUS_FILE_ERROR;
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= BINARY_HEADER_SIZE)
+    {
+        HANDLE fileMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (fileMapping != NULL)
+        {
+            mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(fileMapping); // the view keeps the mapping open
+        }
+        size = (size_t)fileSize.QuadPart;
+    }
+    CloseHandle(file);
+#else
+    int file = open(path, O_RDONLY);
+    if (file < 0)
+        return STATUS_FILE_ERROR;
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) == 0 && fileStat.st_size >= BINARY_HEADER_SIZE)
+    {
+        size = (size_t)fileStat.st_size;
+        mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, file, 0);
+        if (mapping == MAP_FAILED)
+            mapping = NULL;
+    }
+    close(file); // the mapping stays valid
+#endif
+
+    if (mapping == NULL)
+        return (size >= BINARY_HEADER_SIZE) ? STATUS_FILE_ERROR : STATUS_PARSE_ERROR;
+
+    const unsigned char* bytes = mapping;
+    const cube64 numVars = GetLittleEndian(bytes + 8, 4);
+    const cube64 polarity = GetLittleEndian(bytes + 12, 4);
+    const cube64 numTerms = GetLittleEndian(bytes + 16, 8);
+    const cube64 capacity = GetLittleEndian(bytes + 24, 8);
+    const cube64 caresOffset = GetLittleEndian(bytes + 32, 8);
+    const cube64 valuesOffset = GetLittleEndian(bytes + 40, 8);
+    const cube64 indexOffset = GetLittleEndian(bytes + 48, 8);
+    const cube64 numIndexVars = GetLittleEndian(bytes + 56, 4);
+    const cube64 arraySize = capacity * sizeof(cube64);
+
+    // the checks are ordered so no sum below can overflow
+    int isValid = memcmp(bytes, BINARY_MAGIC, 4) == 0 &&
+        GetLittleEndian(bytes + 4, 4) == SHRINQUEM_BINARY_VERSION &&
+        numVars >= 1 && numVars <= CUBE64_MAX_VARIABLES &&
+        polarity <= POLARITY_PRODUCT_OF_SUMS &&
+        numTerms <= capacity && capacity % CUBE_STORE_LANES == 0 && capacity < size &&
+        capacity - numTerms < CUBE_STORE_LANES &&
+        caresOffset % CUBE_STORE_ALIGNMENT == 0 && valuesOffset % CUBE_STORE_ALIGNMENT == 0 &&
+        caresOffset >= BINARY_HEADER_SIZE && caresOffset <= size && arraySize <= size - caresOffset &&
+        valuesOffset >= BINARY_HEADER_SIZE && valuesOffset <= size && arraySize <= size - valuesOffset &&
+        numIndexVars <= BINARY_INDEX_MAX_VARS && numIndexVars <= numVars;
+
+    if (isValid && indexOffset != 0)
+    {
+        const cube64 numBuckets = (cube64)1 << numIndexVars;
+        const cube64 startsSize = (numBuckets + 1) * sizeof(uint32_t);
+        isValid = indexOffset % sizeof(uint32_t) == 0 && indexOffset >= BINARY_HEADER_SIZE &&
+            indexOffset <= size && startsSize <= size - indexOffset;
+
+        if (isValid)
+        {
+            const uint32_t* indexStarts = (const uint32_t*)(bytes + indexOffset);
+            const uint32_t* indexTerms = indexStarts + numBuckets + 1;
+            const cube64 maxEntries = (size - indexOffset - startsSize) / sizeof(uint32_t);
+
+            isValid = (indexStarts[0] == 0);
+            for (cube64 iBucket = 0; iBucket < numBuckets && isValid; iBucket++)
+                isValid = indexStarts[iBucket] <= indexStarts[iBucket + 1];
+            isValid = isValid && indexStarts[numBuckets] <= maxEntries;
+            for (cube64 iEntry = 0; isValid && iEntry < indexStarts[numBuckets]; iEntry++)
+                isValid = indexTerms[iEntry] < numTerms;
+
+            mapped->numIndexVars = (unsigned long)numIndexVars;
+            mapped->indexStarts = indexStarts;
+            mapped->indexTerms = indexTerms;
+        }
+    }
+
+    if (!isValid)
+    {
+        UnmapFile(mapping, size);
+        memset(mapped, 0, sizeof(MappedSumOfProducts));
+        return STATUS_PARSE_ERROR;
+    }
+
+    mapped->store.numVars = (unsigned long)numVars;
+    mapped->store.numTerms = (unsigned long)numTerms;
+    mapped->store.capacity = (unsigned long)capacity;
+    mapped->store.cares = (cube64*)(bytes + caresOffset);
+    mapped->store.values = (cube64*)(bytes + valuesOffset);
+    mapped->store.polarity = (logicPolarity)polarity;
+    mapped->mapping = mapping;
+    mapped->mappingSize = size;
+
+    return STATUS_OKAY;
+}
+
+void UnmapSumOfProductsBinary(
+    MappedSumOfProducts* mapped)
+{
+    if (mapped == NULL || mapped->mapping == NULL)
+        return;
+
+    UnmapFile(mapped->mapping, mapped->mappingSize);
+    memset(mapped, 0, sizeof(MappedSumOfProducts));
+}
+
+// evaluates with the index when the file has one, otherwise with EvaluateCubeStore
+triLogic EvaluateMappedSumOfProducts(
+    const MappedSumOfProducts* mapped,
+    const cube64 input)
+{
+    const CubeStore* store = &mapped->store;
+
+    if (mapped->indexStarts == NULL)
+        return EvaluateCubeStore(store, input);
+
+    const triLogic covered = (store->polarity == POLARITY_PRODUCT_OF_SUMS) ? LOGIC_FALSE : LOGIC_TRUE;
+    const cube64 iBucket = IndexBits(input, store->numVars, mapped->numIndexVars);
+
+    for (uint32_t iEntry = mapped->indexStarts[iBucket]; iEntry < mapped->indexStarts[iBucket + 1]; iEntry++)
+    {
+        uint32_t iTerm = mapped->indexTerms[iEntry];
+        if ((input & store->cares[iTerm]) == store->values[iTerm])
+            return covered;
+    }
+
+    return !covered;
+}
+
+// writes the words little-endian, a block at a time
+shrinquemStatus WriteLittleEndianWords(
+    FILE* file,
+    const cube64 words[],
+    cube64 numWords)
+{
+    unsigned char bytes[BINARY_WRITE_WORDS * sizeof(cube64)];
+
+    for (cube64 iWord = 0; iWord < numWords; iWord += BINARY_WRITE_WORDS)
+    {
+        cube64 numBlockWords = (numWords - iWord < BINARY_WRITE_WORDS) ? numWords - iWord : BINARY_WRITE_WORDS;
+        for (cube64 iBlockWord = 0; iBlockWord < numBlockWords; iBlockWord++)
+            PutLittleEndian(bytes + iBlockWord * sizeof(cube64), words[iWord + iBlockWord], sizeof(cube64));
+
+        if (fwrite(bytes, sizeof(cube64), (size_t)numBlockWords, file) != (size_t)numBlockWords)
+            return STATUS_FILE_ERROR;
+    }
+
+    return STATUS_OKAY;
+}
+
+void PutLittleEndian(
+    unsigned char bytes[],
+    cube64 value,
+    unsigned long numBytes)
+{
+    for (unsigned long iByte = 0; iByte < numBytes; iByte++)
+        bytes[iByte] = (unsigned char)(value >> (8 * iByte));
+}
+
+cube64 GetLittleEndian(
+    const unsigned char bytes[],
+    unsigned long numBytes)
+{
+    cube64 value = 0;
+    for (unsigned long iByte = 0; iByte < numBytes; iByte++)
+        value |= (cube64)bytes[iByte] << (8 * iByte);
+    return value;
+}
+
+static int IsLittleEndianHost(void)
+{
+    const uint16_t probe = 1;
+    return *(const unsigned char*)&probe == 1;
+}
+
+static cube64 AlignOffset(
+    cube64 offset)
+{
+    return (offset + CUBE_STORE_ALIGNMENT - 1) & ~(cube64)(CUBE_STORE_ALIGNMENT - 1);
+}
+
+// returns the most variables, up to BINARY_INDEX_MAX_VARS, whose index stays within BINARY_INDEX_MAX_GROWTH entries per term
+static unsigned long ChooseIndexVars(
+    const CubeStore* store,
+    cube64* numEntries)
+{
+    unsigned long numIndexVars = (store->numVars < BINARY_INDEX_MAX_VARS) ? store->numVars : BINARY_INDEX_MAX_VARS;
+
+    for (; ; numIndexVars--)
+    {
+        // a term is in one bucket for each value of its don't cares among the index variables
+        *numEntries = 0;
+        for (unsigned long iTerm = 0; iTerm < store->numTerms; iTerm++)
+            *numEntries += CUBE64_BIT(numIndexVars - PopCount64(IndexBits(store->cares[iTerm], store->numVars, numIndexVars)));
+
+        if (numIndexVars == 0 || *numEntries <= BINARY_INDEX_MAX_GROWTH * (cube64)store->numTerms)
+            return numIndexVars;
+    }
+}
+
+// returns the bits of the index variables, the highest numIndexVars of the numVars
+static cube64 IndexBits(
+    cube64 word,
+    unsigned long numVars,
+    unsigned long numIndexVars)
+{
+    if (numIndexVars == 0)
+        return 0;
+    return (word >> (numVars - numIndexVars)) & CUBE64_ALL_VARS(numIndexVars);
+}
+
+void UnmapFile(
+    void* mapping,
+    size_t size)
+{
+#if defined(_WIN32)
+    (void)size;
+    UnmapViewOfFile(mapping);
+#else
+    munmap(mapping, size);
+#endif
+}
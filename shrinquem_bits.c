@@ -0,0 +1,22 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+unsigned long PopCount64(
+    cube64 bits)
+{
+    bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+    bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+    bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (unsigned long)((bits * 0x0101010101010101ULL) >> 56);
+}
+
+// the lowest bit alone, less one, has as many bits set as its index
+unsigned long LowestBitIndex(
+    cube64 bits)
+{
+    return PopCount64((bits & (~bits + 1)) - 1);
+}
@@ -0,0 +1,244 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <stdio.h> // used for fopen, fwrite, rename
+#include <string.h> // used for memcpy, memcmp, strlen
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define CHECKPOINT_MAGIC "SHQC"
+#define CHECKPOINT_HEADER_SIZE (64)
+#define CHECKPOINT_BLOCK_WORDS (1024)
+#define CHECKPOINT_TEMP_SUFFIX ".tmp"
+
+static shrinquemStatus ReadWords(FILE* file, cube64 words[], cube64 numWords);
+static shrinquemStatus WriteResolvedBits(FILE* file, const triLogic resolved[], unsigned long numVars);
+static shrinquemStatus ReadResolvedBits(FILE* file, triLogic resolved[], unsigned long numVars);
+
+/*************************************************************************
+SaveCheckpoint
+Purpose - writes the state of the expansion loop of ReduceLogicCore, the
+  terms so far and the resolved entries, with the input the loop goes on
+  from. LoadCheckpoint puts the same state back, so the resumed loop makes
+  the same terms an uninterrupted one would have.
+
+The file is written next to the path and renamed over it once complete,
+so a run stopped while saving leaves the previous checkpoint whole. All
+numbers are little-endian:
+
+  offset  size  field
+       0     4  "SHQC"
+       4     4  SHRINQUEM_CHECKPOINT_VERSION
+       8     4  numVars
+      12     4  onValue
+      16     8  nextInput
+      24     8  numTerms
+      32     8  the hash of the truth table from HashTruthTable
+      40    24  0
+
+Then the numTerms terms, the numTerms dontCares, and the resolved entries
+as a bit set of 2^numVars bits in whole words.
+*************************************************************************/
+
+shrinquemStatus SaveCheckpoint(
+    Checkpoint* checkpoint,
+    const SumOfProducts* sumOfProducts,
+    triLogic onValue,
+    const triLogic resolved[],
+    cube64 nextInput)
+{
+    unsigned char header[CHECKPOINT_HEADER_SIZE];
+    shrinquemStatus status = STATUS_OKAY;
+
+    char* tempPath = AllocateMemory(strlen(checkpoint->path) + sizeof(CHECKPOINT_TEMP_SUFFIX));
+    if (tempPath == NULL)
+        return STATUS_OUT_OF_MEMORY;
+    memcpy(tempPath, checkpoint->path, strlen(checkpoint->path));
+    memcpy(tempPath + strlen(checkpoint->path), CHECKPOINT_TEMP_SUFFIX, sizeof(CHECKPOINT_TEMP_SUFFIX));
+
+    FILE* file = fopen(tempPath, "wb");
+    if (file == NULL)
+    {
+        FreeMemory(tempPath);
+        return STATUS_FILE_ERROR;
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, CHECKPOINT_MAGIC, 4);
+    PutLittleEndian(header + 4, SHRINQUEM_CHECKPOINT_VERSION, 4);
+    PutLittleEndian(header + 8, sumOfProducts->numVars, 4);
+    PutLittleEndian(header + 12, (cube64)onValue, 4);
+    PutLittleEndian(header + 16, nextInput, 8);
+    PutLittleEndian(header + 24, sumOfProducts->numTerms, 8);
+    PutLittleEndian(header + 32, checkpoint->tableHash, 8);
+
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header))
+        status = STATUS_FILE_ERROR;
+    if (status == STATUS_OKAY)
+        status = WriteLittleEndianWords(file, sumOfProducts->terms, sumOfProducts->numTerms);
+    if (status == STATUS_OKAY)
+        status = WriteLittleEndianWords(file, sumOfProducts->dontCares, sumOfProducts->numTerms);
+    if (status == STATUS_OKAY)
+        status = WriteResolvedBits(file, resolved, sumOfProducts->numVars);
+
+    if (fclose(file) != 0 && status == STATUS_OKAY)
+        status = STATUS_FILE_ERROR;
+
+    if (status == STATUS_OKAY)
+    {
+#if defined(_WIN32)
+        remove(checkpoint->path); // rename doesn't replace a file here
+#endif
+        if (rename(tempPath, checkpoint->path) != 0)
+            status = STATUS_FILE_ERROR;
+    }
+
+    if (status != STATUS_OKAY)
+        remove(tempPath);
+    else
+        checkpoint->lastSaved = GetSeconds();
+
+    FreeMemory(tempPath);
+
+    return status;
+}
+
+// reads the terms and resolved entries of a checkpoint into the buffers of a new run, the terms buffer holds maxNumTerms
+shrinquemStatus LoadCheckpoint(
+    const Checkpoint* checkpoint,
+    SumOfProducts* sumOfProducts,
+    size_t maxNumTerms,
+    triLogic onValue,
+    triLogic resolved[],
+    cube64* nextInput)
+{
+    unsigned char header[CHECKPOINT_HEADER_SIZE];
+    shrinquemStatus status = STATUS_OKAY;
+
+    FILE* file = fopen(checkpoint->path, "rb");
+    if (file == NULL)
+        return STATUS_FILE_ERROR;
+
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) || memcmp(header, CHECKPOINT_MAGIC, 4) != 0 ||
+        GetLittleEndian(header + 4, 4) != SHRINQUEM_CHECKPOINT_VERSION)
+    {
+        status = STATUS_FILE_ERROR;
+        goto cleanupAndExit;
+    }
+
+    // a checkpoint of another table or polarity can't be continued
+    const cube64 numTerms = GetLittleEndian(header + 24, 8);
+    *nextInput = GetLittleEndian(header + 16, 8);
+    if (GetLittleEndian(header + 8, 4) != sumOfProducts->numVars ||
+        GetLittleEndian(header + 12, 4) != (cube64)onValue ||
+        GetLittleEndian(header + 32, 8) != checkpoint->tableHash ||
+        *nextInput > CUBE64_BIT(sumOfProducts->numVars) ||
+        numTerms > maxNumTerms)
+    {
+        status = STATUS_INVALID_ARGUMENT;
+        goto cleanupAndExit;
+    }
+
+    sumOfProducts->numTerms = (unsigned long)numTerms;
+    status = ReadWords(file, sumOfProducts->terms, numTerms);
+    if (status == STATUS_OKAY)
+        status = ReadWords(file, sumOfProducts->dontCares, numTerms);
+    if (status == STATUS_OKAY)
+        status = ReadResolvedBits(file, resolved, sumOfProducts->numVars);
+
+cleanupAndExit:
+
+    fclose(file);
+
+    if (status != STATUS_OKAY)
+        sumOfProducts->numTerms = 0;
+
+    return status;
+}
+
+// a 64-bit FNV-1a hash of the entries, 8 at a time, so a checkpoint is never resumed on the wrong table
+cube64 HashTruthTable(
+    const triLogic truthTable[],
+    unsigned long numVars)
+{
+    const cube64 numEntries = CUBE64_BIT(numVars);
+    cube64 hash = 0xCBF29CE484222325ULL;
+    cube64 iEntry = 0;
+
+    for (; iEntry + sizeof(cube64) <= numEntries; iEntry += sizeof(cube64))
+        hash = (hash ^ GetLittleEndian((const unsigned char*)&truthTable[iEntry], sizeof(cube64))) * 0x100000001B3ULL;
+    for (; iEntry < numEntries; iEntry++)
+        hash = (hash ^ (unsigned char)truthTable[iEntry]) * 0x100000001B3ULL;
+
+    return hash;
+}
+
+static shrinquemStatus ReadWords(
+    FILE* file,
+    cube64 words[],
+    cube64 numWords)
+{
+    unsigned char bytes[CHECKPOINT_BLOCK_WORDS * sizeof(cube64)];
+
+    for (cube64 iWord = 0; iWord < numWords; iWord += CHECKPOINT_BLOCK_WORDS)
+    {
+        cube64 numBlockWords = (numWords - iWord < CHECKPOINT_BLOCK_WORDS) ? numWords - iWord : CHECKPOINT_BLOCK_WORDS;
+        if (fread(bytes, sizeof(cube64), (size_t)numBlockWords, file) != (size_t)numBlockWords)
+            return STATUS_FILE_ERROR;
+
+        for (cube64 iBlockWord = 0; iBlockWord < numBlockWords; iBlockWord++)
+            words[iWord + iBlockWord] = GetLittleEndian(bytes + iBlockWord * sizeof(cube64), sizeof(cube64));
+    }
+
+    return STATUS_OKAY;
+}
+
+// packs the resolved entries a bit each, in as many words as the table needs
+static shrinquemStatus WriteResolvedBits(
+    FILE* file,
+    const triLogic resolved[],
+    unsigned long numVars)
+{
+    const cube64 numEntries = CUBE64_BIT(numVars);
+    cube64 words[CHECKPOINT_BLOCK_WORDS];
+
+    for (cube64 iEntry = 0; iEntry < numEntries; iEntry += CHECKPOINT_BLOCK_WORDS * BITS_PER_WORD)
+    {
+        cube64 numBlockEntries = (numEntries - iEntry < CHECKPOINT_BLOCK_WORDS * BITS_PER_WORD) ? numEntries - iEntry : CHECKPOINT_BLOCK_WORDS * BITS_PER_WORD;
+        cube64 numBlockWords = (numBlockEntries + BITS_PER_WORD - 1) / BITS_PER_WORD;
+        memset(words, 0, sizeof(words));
+        for (cube64 iBlockEntry = 0; iBlockEntry < numBlockEntries; iBlockEntry++)
+            words[iBlockEntry / BITS_PER_WORD] |= (cube64)(resolved[iEntry + iBlockEntry] != 0) << (iBlockEntry % BITS_PER_WORD);
+
+        shrinquemStatus status = WriteLittleEndianWords(file, words, numBlockWords);
+        if (status != STATUS_OKAY)
+            return status;
+    }
+
+    return STATUS_OKAY;
+}
+
+static shrinquemStatus ReadResolvedBits(
+    FILE* file,
+    triLogic resolved[],
+    unsigned long numVars)
+{
+    const cube64 numEntries = CUBE64_BIT(numVars);
+    cube64 words[CHECKPOINT_BLOCK_WORDS];
+
+    for (cube64 iEntry = 0; iEntry < numEntries; iEntry += CHECKPOINT_BLOCK_WORDS * BITS_PER_WORD)
+    {
+        cube64 numBlockEntries = (numEntries - iEntry < CHECKPOINT_BLOCK_WORDS * BITS_PER_WORD) ? numEntries - iEntry : CHECKPOINT_BLOCK_WORDS * BITS_PER_WORD;
+        cube64 numBlockWords = (numBlockEntries + BITS_PER_WORD - 1) / BITS_PER_WORD;
+        shrinquemStatus status = ReadWords(file, words, numBlockWords);
+        if (status != STATUS_OKAY)
+            return status;
+
+        for (cube64 iBlockEntry = 0; iBlockEntry < numBlockEntries; iBlockEntry++)
+            resolved[iEntry + iBlockEntry] = (triLogic)((words[iBlockEntry / BITS_PER_WORD] >> (iBlockEntry % BITS_PER_WORD)) & 1);
+    }
+
+    return STATUS_OKAY;
+}
@@ -0,0 +1,314 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <stdio.h> // used for vsnprintf
+#include <stdarg.h>
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define BITSLICED_EXIT_INTERVAL (8) // terms between the checks for all 64 lanes being true
+
+typedef struct SourceBuffer
+{
+    char* text;
+    size_t length;
+    size_t capacity;
+} SourceBuffer;
+
+typedef struct CoverageOrder
+{
+    unsigned long numDontCares;
+    unsigned long iTerm;
+} CoverageOrder;
+
+static int CompareCoverage(const void* a, const void* b);
+static int UsesInput(const SumOfProducts* sumOfProducts);
+static shrinquemStatus AppendScalar(SourceBuffer* buffer, const SumOfProducts* sumOfProducts, const char* functionName, const CoverageOrder order[], cube64 commonCare, cube64 commonValue);
+static shrinquemStatus AppendBitsliced(SourceBuffer* buffer, const SumOfProducts* sumOfProducts, const char* functionName, const CoverageOrder order[], cube64 commonCare, cube64 commonValue);
+static shrinquemStatus AppendLanes(SourceBuffer* buffer, unsigned long numVars, cube64 care, cube64 value);
+static shrinquemStatus AppendFormat(SourceBuffer* buffer, const char* format, ...);
+
+/*************************************************************************
+GenerateCSource
+Purpose - generates the source of a C function computing the cover, with
+  no branches in CODEGEN_SCALAR mode, so it can be compiled into the code
+  that needs it instead of evaluating the terms at run time.
+
+In CODEGEN_SCALAR mode the function takes the input as a uint64_t, variable
+i being bit i as for EvaluateSumOfProducts, and returns 1 or 0. Each term
+is a mask and a compare. In CODEGEN_BITSLICED mode it takes an array of a
+uint64_t per variable, each bit being one of 64 inputs, and returns the 64
+results the same way. The complemented variables are computed once, and
+every BITSLICED_EXIT_INTERVAL terms it returns early when all 64 lanes are
+already true. In both modes the literals common to all the terms are hoisted
+out of them and the terms covering the most inputs come first. The function
+name isn't checked, it must be a valid C identifier. The source is
+allocated and must be freed by the caller.
+*************************************************************************/
+
+shrinquemStatus GenerateCSource(
+    const SumOfProducts* sumOfProducts,
+    const char* functionName,
+    codegenMode mode,
+    char** source)
+{
+    if (sumOfProducts == NULL || functionName == NULL || source == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (sumOfProducts->numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+    else if (sumOfProducts->numVars > CUBE64_MAX_VARIABLES)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    const unsigned long numTerms = sumOfProducts->numTerms;
+    const cube64 allVars = CUBE64_ALL_VARS(sumOfProducts->numVars);
+    SourceBuffer buffer = { NULL, 0, 0 };
+    shrinquemStatus status;
+
+    *source = NULL;
+
+    CoverageOrder* order = AllocateMemory((numTerms + 1) * sizeof(CoverageOrder));
+    if (order == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    for (unsigned long iTerm = 0; iTerm < numTerms; iTerm++)
+    {
+        order[iTerm].numDontCares = PopCount64(sumOfProducts->dontCares[iTerm] & allVars);
+        order[iTerm].iTerm = iTerm;
+    }
+    qsort(order, numTerms, sizeof(CoverageOrder), CompareCoverage);
+
+    // the literals of the same variable and value in every term
+    cube64 commonCare = 0;
+    cube64 commonValue = 0;
+    if (numTerms > 0)
+    {
+        cube64 allTrue = allVars;
+        cube64 anyTrue = 0;
+        commonCare = allVars;
+        for (unsigned long iTerm = 0; iTerm < numTerms; iTerm++)
+        {
+            cube64 care = ~sumOfProducts->dontCares[iTerm] & allVars;
+            commonCare &= care;
+            allTrue &= sumOfProducts->terms[iTerm] & care;
+            anyTrue |= sumOfProducts->terms[iTerm] & care;
+        }
+        commonCare &= ~(allTrue ^ anyTrue);
+        commonValue = allTrue & commonCare;
+    }
+
+    status = AppendFormat(&buffer, "// generated by shrinquem from a %s of %lu terms over %lu variables\n#include <stdint.h>\n\n",
+        (sumOfProducts->polarity == POLARITY_PRODUCT_OF_SUMS) ? "product-of-sums" : "sum-of-products", numTerms, sumOfProducts->numVars);
+
+    if (status == STATUS_OKAY && mode == CODEGEN_BITSLICED)
+        status = AppendBitsliced(&buffer, sumOfProducts, functionName, order, commonCare, commonValue);
+    else if (status == STATUS_OKAY)
+        status = AppendScalar(&buffer, sumOfProducts, functionName, order, commonCare, commonValue);
+
+    if (status == STATUS_OKAY)
+        *source = buffer.text;
+    else
+        FreeMemory(buffer.text);
+
+    FreeMemory(order);
+
+    return status;
+}
+
+// sorts the terms with the most don't cares first, then in their order
+static int CompareCoverage(
+    const void* a,
+    const void* b)
+{
+    const CoverageOrder* first = (const CoverageOrder*)a;
+    const CoverageOrder* second = (const CoverageOrder*)b;
+
+    if (first->numDontCares != second->numDontCares)
+        return (first->numDontCares > second->numDontCares) ? -1 : 1;
+    return (first->iTerm < second->iTerm) ? -1 : 1;
+}
+
+// returns nonzero when some term has a literal, otherwise the function is a constant
+static int UsesInput(
+    const SumOfProducts* sumOfProducts)
+{
+    const cube64 allVars = CUBE64_ALL_VARS(sumOfProducts->numVars);
+
+    for (unsigned long iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
+    {
+        if ((~sumOfProducts->dontCares[iTerm] & allVars) != 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+static shrinquemStatus AppendScalar(
+    SourceBuffer* buffer,
+    const SumOfProducts* sumOfProducts,
+    const char* functionName,
+    const CoverageOrder order[],
+    cube64 commonCare,
+    cube64 commonValue)
+{
+    const cube64 allVars = CUBE64_ALL_VARS(sumOfProducts->numVars);
+    shrinquemStatus status;
+
+    status = AppendFormat(buffer, "int %s(uint64_t x)\n{\n    int result = 0;\n", functionName);
+    if (status == STATUS_OKAY && !UsesInput(sumOfProducts))
+        status = AppendFormat(buffer, "    (void)x;\n");
+
+    for (unsigned long iOrder = 0; iOrder < sumOfProducts->numTerms && status == STATUS_OKAY; iOrder++)
+    {
+        unsigned long iTerm = order[iOrder].iTerm;
+        cube64 care = ~sumOfProducts->dontCares[iTerm] & allVars & ~commonCare;
+        cube64 value = sumOfProducts->terms[iTerm] & care;
+
+        if (care == 0)
+            status = AppendFormat(buffer, "    result |= 1;\n");
+        else
+            status = AppendFormat(buffer, "    result |= (x & 0x%llXULL) == 0x%llXULL;\n", (unsigned long long)care, (unsigned long long)value);
+    }
+
+    if (status == STATUS_OKAY && commonCare != 0)
+        status = AppendFormat(buffer, "    result &= (x & 0x%llXULL) == 0x%llXULL;\n", (unsigned long long)commonCare, (unsigned long long)commonValue);
+
+    if (status == STATUS_OKAY)
+        status = AppendFormat(buffer, (sumOfProducts->polarity == POLARITY_PRODUCT_OF_SUMS) ? "    return result ^ 1;\n}\n" : "    return result;\n}\n");
+
+    return status;
+}
+
+static shrinquemStatus AppendBitsliced(
+    SourceBuffer* buffer,
+    const SumOfProducts* sumOfProducts,
+    const char* functionName,
+    const CoverageOrder order[],
+    cube64 commonCare,
+    cube64 commonValue)
+{
+    const unsigned long numVars = sumOfProducts->numVars;
+    const cube64 allVars = CUBE64_ALL_VARS(numVars);
+    const char* returnFormat = (sumOfProducts->polarity == POLARITY_PRODUCT_OF_SUMS) ? "return ~(%s);\n" : "return %s;\n";
+    const char* resultName = (commonCare != 0) ? "common & result" : "result";
+    shrinquemStatus status;
+
+    // the variables used as complemented literals, each complemented once
+    cube64 complemented = ~commonValue & commonCare;
+    for (unsigned long iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
+        complemented |= ~sumOfProducts->terms[iTerm] & ~sumOfProducts->dontCares[iTerm] & allVars;
+
+    status = AppendFormat(buffer, "uint64_t %s(const uint64_t in[%lu])\n{\n", functionName, numVars);
+    if (status == STATUS_OKAY && !UsesInput(sumOfProducts))
+        status = AppendFormat(buffer, "    (void)in;\n");
+
+    for (unsigned long iVar = 0; iVar < numVars && status == STATUS_OKAY; iVar++)
+    {
+        if (complemented & CUBE64_BIT(iVar))
+            status = AppendFormat(buffer, "    const uint64_t n%lu = ~in[%lu];\n", iVar, iVar);
+    }
+
+    if (status == STATUS_OKAY && commonCare != 0)
+    {
+        status = AppendFormat(buffer, "    const uint64_t common = ");
+        if (status == STATUS_OKAY)
+            status = AppendLanes(buffer, numVars, commonCare, commonValue);
+        if (status == STATUS_OKAY)
+            status = AppendFormat(buffer, ";\n");
+    }
+
+    if (status == STATUS_OKAY)
+        status = AppendFormat(buffer, "    uint64_t result = 0;\n");
+
+    for (unsigned long iOrder = 0; iOrder < sumOfProducts->numTerms && status == STATUS_OKAY; iOrder++)
+    {
+        unsigned long iTerm = order[iOrder].iTerm;
+        cube64 care = ~sumOfProducts->dontCares[iTerm] & allVars & ~commonCare;
+
+        if (iOrder > 0 && iOrder % BITSLICED_EXIT_INTERVAL == 0)
+        {
+            status = AppendFormat(buffer, "    if (result == ~(uint64_t)0)\n        ");
+            if (status == STATUS_OKAY)
+                status = AppendFormat(buffer, returnFormat, resultName);
+        }
+
+        if (status == STATUS_OKAY)
+            status = AppendFormat(buffer, "    result |= ");
+        if (status == STATUS_OKAY)
+            status = AppendLanes(buffer, numVars, care, sumOfProducts->terms[iTerm] & care);
+        if (status == STATUS_OKAY)
+            status = AppendFormat(buffer, ";\n");
+    }
+
+    if (status == STATUS_OKAY)
+        status = AppendFormat(buffer, "    ");
+    if (status == STATUS_OKAY)
+        status = AppendFormat(buffer, returnFormat, resultName);
+    if (status == STATUS_OKAY)
+        status = AppendFormat(buffer, "}\n");
+
+    return status;
+}
+
+// appends the AND of the lanes of the literals, or all ones when there are none
+static shrinquemStatus AppendLanes(
+    SourceBuffer* buffer,
+    unsigned long numVars,
+    cube64 care,
+    cube64 value)
+{
+    shrinquemStatus status = STATUS_OKAY;
+    unsigned long numLiterals = 0;
+
+    if (care == 0)
+        return AppendFormat(buffer, "~(uint64_t)0");
+
+    for (unsigned long iVar = 0; iVar < numVars && status == STATUS_OKAY; iVar++)
+    {
+        cube64 bitMask = CUBE64_BIT(iVar);
+        if ((care & bitMask) == 0)
+            continue;
+
+        if (numLiterals++ > 0)
+            status = AppendFormat(buffer, " & ");
+        if (status == STATUS_OKAY)
+            status = AppendFormat(buffer, (value & bitMask) ? "in[%lu]" : "n%lu", iVar);
+    }
+
+    return status;
+}
+
+static shrinquemStatus AppendFormat(
+    SourceBuffer* buffer,
+    const char* format,
+    ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    if (length < 0)
+        return STATUS_OUT_OF_MEMORY;
+
+    if (buffer->length + length + 1 > buffer->capacity)
+    {
+        size_t newCapacity = (buffer->capacity == 0) ? 256 : 2 * buffer->capacity;
+        while (newCapacity < buffer->length + length + 1)
+            newCapacity *= 2;
+
+        char* newText = ReallocateMemory(buffer->text, newCapacity);
+        if (newText == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        buffer->text = newText;
+        buffer->capacity = newCapacity;
+    }
+
+    va_start(args, format);
+    vsnprintf(buffer->text + buffer->length, length + 1, format, args);
+    va_end(args);
+    buffer->length += length;
+
+    return STATUS_OKAY;
+}
@@ -0,0 +1,264 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+// Tests of the C that GenerateCSource writes, built in two steps. Built with
+// SHRINQUEM_WRITE_GENERATED_CODE, this writes the functions of a fixed set
+// of covers to the file given. Built with that file, it runs them on every
+// input and compares them with EvaluateSumOfProducts of the same covers.
+
+#include <stdlib.h>
+#include <stdio.h> // used for printf, fopen
+#include <stdint.h>
+#include "shrinquem.h"
+
+#define NUM_RANDOM_VARS (12)
+#define COVERS_PER_SIZE (4)
+#define NUM_FIXED_COVERS (2)
+#define NUM_COVERS (NUM_FIXED_COVERS + NUM_RANDOM_VARS * COVERS_PER_SIZE)
+#define NUM_LANES (64)
+
+static shrinquemStatus MakeCover(unsigned long iCover, SumOfProducts* sumOfProducts);
+static shrinquemStatus CopyCover(unsigned long numVars, unsigned long numTerms, const cube64 terms[], const cube64 dontCares[], SumOfProducts* sumOfProducts);
+static cube64 NextRandom(cube64* state);
+
+#if defined(SHRINQUEM_WRITE_GENERATED_CODE)
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        printf("usage: %s generated.c\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[1], "w");
+    if (file == NULL)
+    {
+        printf("can't write %s\n", argv[1]);
+        return 1;
+    }
+
+    int isWritten = 1;
+    for (unsigned long iCover = 0; iCover < NUM_COVERS && isWritten; iCover++)
+    {
+        SumOfProducts sumOfProducts = { 0 };
+        char scalarName[32];
+        char bitslicedName[32];
+        char* scalar = NULL;
+        char* bitsliced = NULL;
+        sprintf(scalarName, "generatedScalar%lu", iCover);
+        sprintf(bitslicedName, "generatedBitsliced%lu", iCover);
+
+        isWritten = MakeCover(iCover, &sumOfProducts) == STATUS_OKAY &&
+            GenerateCSource(&sumOfProducts, scalarName, CODEGEN_SCALAR, &scalar) == STATUS_OKAY &&
+            GenerateCSource(&sumOfProducts, bitslicedName, CODEGEN_BITSLICED, &bitsliced) == STATUS_OKAY &&
+            fprintf(file, "%s\n%s\n", scalar, bitsliced) > 0;
+
+        FinalizeSumOfProducts(&sumOfProducts);
+        free(scalar);
+        free(bitsliced);
+    }
+
+    // the tables the tests call the functions through
+    if (isWritten)
+        fprintf(file, "const unsigned long numGeneratedCovers = %lu;\n\nint (*const generatedScalar[])(uint64_t) =\n{\n", (unsigned long)NUM_COVERS);
+    for (unsigned long iCover = 0; iCover < NUM_COVERS && isWritten; iCover++)
+        fprintf(file, "    generatedScalar%lu,\n", iCover);
+    if (isWritten)
+        fprintf(file, "};\n\nuint64_t (*const generatedBitsliced[])(const uint64_t*) =\n{\n");
+    for (unsigned long iCover = 0; iCover < NUM_COVERS && isWritten; iCover++)
+        fprintf(file, "    generatedBitsliced%lu,\n", iCover);
+    if (isWritten)
+        fprintf(file, "};\n");
+
+    if (fclose(file) != 0 || !isWritten)
+    {
+        printf("can't write %s\n", argv[1]);
+        remove(argv[1]);
+        return 1;
+    }
+
+    return 0;
+}
+
+#else
+
+extern const unsigned long numGeneratedCovers;
+extern int (*const generatedScalar[])(uint64_t);
+extern uint64_t (*const generatedBitsliced[])(const uint64_t*);
+
+static int CheckBitslicedLanes(uint64_t (*bitsliced)(const uint64_t*), const SumOfProducts sumOfProducts, const cube64 inputs[NUM_LANES]);
+
+int main(void)
+{
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestGeneratedCode test...\n\n");
+
+    if (numGeneratedCovers != NUM_COVERS)
+        numFailures++;
+
+    for (unsigned long iCover = 0; iCover < NUM_COVERS && numFailures == 0; iCover++)
+    {
+        SumOfProducts sumOfProducts = { 0 };
+        if (MakeCover(iCover, &sumOfProducts) != STATUS_OKAY)
+        {
+            numFailures++;
+            break;
+        }
+
+        const cube64 numOfPossibleInputs = (cube64)1 << sumOfProducts.numVars;
+
+        // the scalar function gives the value of the cover for every input
+        int isScalarRight = 1;
+        for (cube64 iInput = 0; iInput < numOfPossibleInputs && isScalarRight; iInput++)
+            isScalarRight = generatedScalar[iCover](iInput) == (EvaluateSumOfProducts(sumOfProducts, iInput) == LOGIC_TRUE);
+
+        if (isScalarRight)
+            numRight++;
+        else
+            numWrong++;
+
+        // the bitsliced one takes 64 inputs a call, wrapping around when there are fewer
+        cube64 inputs[NUM_LANES];
+        int isBitslicedRight = 1;
+        for (cube64 iFirst = 0; iFirst < numOfPossibleInputs && isBitslicedRight; iFirst += NUM_LANES)
+        {
+            for (unsigned long iLane = 0; iLane < NUM_LANES; iLane++)
+                inputs[iLane] = (iFirst + iLane) % numOfPossibleInputs;
+            isBitslicedRight = CheckBitslicedLanes(generatedBitsliced[iCover], sumOfProducts, inputs);
+        }
+
+        // and inputs in no order, so no lane holds its own index
+        cube64 state = iCover;
+        for (unsigned long iLane = 0; iLane < NUM_LANES; iLane++)
+            inputs[iLane] = NextRandom(&state) % numOfPossibleInputs;
+        if (isBitslicedRight)
+            isBitslicedRight = CheckBitslicedLanes(generatedBitsliced[iCover], sumOfProducts, inputs);
+
+        if (isBitslicedRight)
+            numRight++;
+        else
+            numWrong++;
+
+        FinalizeSumOfProducts(&sumOfProducts);
+    }
+
+    printf("\nNumber right    : %lu", numRight);
+    printf("\nNumber wrong    : %lu", numWrong);
+    printf("\nNumber failures : %lu", numFailures);
+    printf("\n");
+
+    return (numWrong == 0 && numFailures == 0) ? 0 : 1;
+}
+
+// packs an input in each lane and checks every lane of the bitsliced function against the cover
+static int CheckBitslicedLanes(
+    uint64_t (*bitsliced)(const uint64_t*),
+    const SumOfProducts sumOfProducts,
+    const cube64 inputs[NUM_LANES])
+{
+    uint64_t in[CUBE64_MAX_VARIABLES] = { 0 };
+
+    for (unsigned long iLane = 0; iLane < NUM_LANES; iLane++)
+    {
+        for (unsigned long iVar = 0; iVar < sumOfProducts.numVars; iVar++)
+        {
+            if (inputs[iLane] & CUBE64_BIT(iVar))
+                in[iVar] |= CUBE64_BIT(iLane);
+        }
+    }
+
+    uint64_t output = bitsliced(in);
+    for (unsigned long iLane = 0; iLane < NUM_LANES; iLane++)
+    {
+        if (((output >> iLane) & 1) != (EvaluateSumOfProducts(sumOfProducts, inputs[iLane]) == LOGIC_TRUE))
+            return 0;
+    }
+
+    return 1;
+}
+
+#endif
+
+/*************************************************************************
+MakeCover
+Purpose - makes cover iCover of the tests, the same one every time so the
+  two builds agree. The first ones are picked by hand: AB + AC', whose A is
+  hoisted out of both terms, and 1 + A'B'C'D + ..., which is all true after
+  its first term so the bitsliced function returns at its first check. The
+  rest are minimized from random tables of 1 to NUM_RANDOM_VARS variables,
+  alternating the sum-of-products and the product-of-sums.
+*************************************************************************/
+
+static shrinquemStatus MakeCover(
+    unsigned long iCover,
+    SumOfProducts* sumOfProducts)
+{
+    if (iCover == 0)
+    {
+        const cube64 terms[] = { 0x6, 0x4 };
+        const cube64 dontCares[] = { 0x1, 0x2 };
+        return CopyCover(3, 2, terms, dontCares, sumOfProducts);
+    }
+    else if (iCover == 1)
+    {
+        const cube64 terms[] = { 0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8 };
+        const cube64 dontCares[] = { 0xF, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0 };
+        return CopyCover(4, 9, terms, dontCares, sumOfProducts);
+    }
+
+    const unsigned long iRandom = iCover - NUM_FIXED_COVERS;
+    const unsigned long numVars = 1 + iRandom / COVERS_PER_SIZE;
+    const cube64 numOfPossibleInputs = CUBE64_BIT(numVars);
+
+    triLogic* truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+    if (truthTable == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    cube64 state = iCover;
+    for (cube64 iInput = 0; iInput < numOfPossibleInputs; iInput++)
+        truthTable[iInput] = (triLogic)(NextRandom(&state) % 3);
+
+    sumOfProducts->numVars = numVars;
+    shrinquemStatus status = (iRandom % 2) ? ReduceLogicPOS(truthTable, sumOfProducts) : ReduceLogic(truthTable, sumOfProducts);
+    free(truthTable);
+
+    return status;
+}
+
+static shrinquemStatus CopyCover(
+    unsigned long numVars,
+    unsigned long numTerms,
+    const cube64 terms[],
+    const cube64 dontCares[],
+    SumOfProducts* sumOfProducts)
+{
+    sumOfProducts->numVars = numVars;
+    sumOfProducts->numTerms = numTerms;
+    sumOfProducts->polarity = POLARITY_SUM_OF_PRODUCTS;
+    sumOfProducts->terms = malloc(numTerms * sizeof(cube64));
+    sumOfProducts->dontCares = malloc(numTerms * sizeof(cube64));
+    if (sumOfProducts->terms == NULL || sumOfProducts->dontCares == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    for (unsigned long iTerm = 0; iTerm < numTerms; iTerm++)
+    {
+        sumOfProducts->terms[iTerm] = terms[iTerm];
+        sumOfProducts->dontCares[iTerm] = dontCares[iTerm];
+    }
+
+    return STATUS_OKAY;
+}
+
+// a 64-bit linear congruential step, so the covers don't depend on the rand of the platform
+static cube64 NextRandom(
+    cube64* state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state >> 33;
+}
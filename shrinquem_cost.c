@@ -0,0 +1,82 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+// returns the cost of one term under the objective of the options, a term with no literals costing 1 or 0
+double TermCost(
+    const ReduceLogicOptions* options,
+    unsigned long numVars,
+    cube64 dontCares)
+{
+    const cube64 literals = ~dontCares & CUBE64_ALL_VARS(numVars);
+
+    switch (options->objective)
+    {
+    case OBJECTIVE_LITERALS:
+        return (double)PopCount64(literals);
+
+    case OBJECTIVE_WEIGHTED:
+    {
+        double cost = 0.0;
+        for (unsigned long iVar = 0; iVar < numVars; iVar++)
+        {
+            if (literals & CUBE64_BIT(iVar))
+                cost += options->weights[iVar];
+        }
+        return cost;
+    }
+
+    default:
+        return 1.0;
+    }
+}
+
+// returns the cost of all the terms, which for a product-of-sums counts the literals of its sums
+double CoverCost(
+    const ReduceLogicOptions* options,
+    const SumOfProducts* sumOfProducts)
+{
+    double cost = 0.0;
+
+    for (unsigned long iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
+        cost += TermCost(options, sumOfProducts->numVars, sumOfProducts->dontCares[iTerm]);
+
+    return cost;
+}
+
+/*************************************************************************
+GetVariableOrder
+Purpose - fills order with the variables in the order their literals are
+  tried as "don't cares". The heaviest variables come first for
+  OBJECTIVE_WEIGHTED, since dropping them lowers the cost of a term the
+  most, and variable 0 up is used otherwise. Equal weights keep the lower
+  variable first.
+*************************************************************************/
+
+void GetVariableOrder(
+    const ReduceLogicOptions* options,
+    unsigned long numVars,
+    unsigned long order[])
+{
+    for (unsigned long iVar = 0; iVar < numVars; iVar++)
+        order[iVar] = iVar;
+
+    if (options->objective != OBJECTIVE_WEIGHTED)
+        return;
+
+    // an insertion sort keeps equal weights in place and there are at most 64 variables
+    for (unsigned long iVar = 1; iVar < numVars; iVar++)
+    {
+        unsigned long var = order[iVar];
+        unsigned long iPos = iVar;
+        while (iPos > 0 && options->weights[order[iPos - 1]] < options->weights[var])
+        {
+            order[iPos] = order[iPos - 1];
+            iPos--;
+        }
+        order[iPos] = var;
+    }
+}
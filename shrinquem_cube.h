@@ -0,0 +1,91 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+// Cube types. A cube is a product term stored as a value and a mask of the
+// variables that are "don't cares". Variable i is bit i of the value, which
+// is also bit i of the truth table index.
+
+#if !defined(INC_SHRINQUEM_CUBE_H)
+#define INC_SHRINQUEM_CUBE_H
+
+#include <stdint.h>
+
+// one word holds a cube of up to 64 variables on every platform
+typedef uint64_t cube64;
+
+#define CUBE64_MAX_VARIABLES (64)
+#define CUBE64_BIT(iVar) ((cube64)1 << (iVar))
+#define CUBE64_ALL_VARS(numVars) (((numVars) >= CUBE64_MAX_VARIABLES) ? ~(cube64)0 : CUBE64_BIT(numVars) - 1)
+
+#if defined(_MSC_VER)
+#define SHRINQUEM_INLINE static __inline
+#else
+#define SHRINQUEM_INLINE static inline
+#endif
+
+/*************************************************************************
+DEFINE_WIDE_CUBE
+Purpose - defines a multi-word cube type for functions wider than 64
+  variables along with its operations, like a template instantiated for a
+  number of 64-bit words. The loops have a constant trip count and no
+  branches, so compilers unroll and vectorize them.
+
+For DEFINE_WIDE_CUBE(128, 2) it defines:
+  cube128                 - the value and dontCares words, variable i is bit i % 64 of word i / 64
+  Cube128SetLiteral       - makes variable iVar a literal of the given polarity
+  Cube128Contains         - nonzero when every minterm of inner is also in outer
+  Cube128Intersects       - nonzero when the two cubes share a minterm
+  Cube128ContainsMinterm  - nonzero when the input, one bit per variable, is in the cube
+*************************************************************************/
+
+#define DEFINE_WIDE_CUBE(numBits, numWords)                                                         \
+typedef struct cube##numBits                                                                        \
+{                                                                                                   \
+    cube64 value[numWords];                                                                         \
+    cube64 dontCares[numWords];                                                                     \
+} cube##numBits;                                                                                    \
+                                                                                                    \
+SHRINQUEM_INLINE void Cube##numBits##SetLiteral(cube##numBits* cube, unsigned long iVar, int isTrue) \
+{                                                                                                   \
+    cube64 bit = CUBE64_BIT(iVar % CUBE64_MAX_VARIABLES);                                           \
+    cube->dontCares[iVar / CUBE64_MAX_VARIABLES] &= ~bit;                                           \
+    if (isTrue)                                                                                     \
+        cube->value[iVar / CUBE64_MAX_VARIABLES] |= bit;                                            \
+    else                                                                                            \
+        cube->value[iVar / CUBE64_MAX_VARIABLES] &= ~bit;                                           \
+}                                                                                                   \
+                                                                                                    \
+SHRINQUEM_INLINE int Cube##numBits##Contains(const cube##numBits* outer, const cube##numBits* inner) \
+{                                                                                                   \
+    cube64 conflicts = 0;                                                                           \
+    for (unsigned long iWord = 0; iWord < (numWords); iWord++)                                      \
+    {                                                                                               \
+        cube64 outerCares = ~outer->dontCares[iWord];                                               \
+        conflicts |= (inner->dontCares[iWord] & outerCares) |                                       \
+            ((outer->value[iWord] ^ inner->value[iWord]) & outerCares);                             \
+    }                                                                                               \
+    return conflicts == 0;                                                                          \
+}                                                                                                   \
+                                                                                                    \
+SHRINQUEM_INLINE int Cube##numBits##Intersects(const cube##numBits* a, const cube##numBits* b)     \
+{                                                                                                   \
+    cube64 conflicts = 0;                                                                           \
+    for (unsigned long iWord = 0; iWord < (numWords); iWord++)                                      \
+        conflicts |= (a->value[iWord] ^ b->value[iWord]) & ~(a->dontCares[iWord] | b->dontCares[iWord]); \
+    return conflicts == 0;                                                                          \
+}                                                                                                   \
+                                                                                                    \
+SHRINQUEM_INLINE int Cube##numBits##ContainsMinterm(const cube##numBits* cube, const cube64 input[numWords]) \
+{                                                                                                   \
+    cube64 conflicts = 0;                                                                           \
+    for (unsigned long iWord = 0; iWord < (numWords); iWord++)                                      \
+        conflicts |= (cube->value[iWord] ^ input[iWord]) & ~cube->dontCares[iWord];                 \
+    return conflicts == 0;                                                                          \
+}
+
+DEFINE_WIDE_CUBE(128, 2)
+DEFINE_WIDE_CUBE(256, 4)
+DEFINE_WIDE_CUBE(512, 8)
+
+#endif // !defined(INC_SHRINQUEM_CUBE_H)
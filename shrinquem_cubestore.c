@@ -0,0 +1,251 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for memcpy
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+static void PadCubeStore(CubeStore* store);
+
+/*************************************************************************
+CubeStoreFromSumOfProducts
+Purpose - copies the terms of a sum-of-products into a cube store.
+
+The store keeps the terms as two arrays, the care mask (the complement of
+the don't cares) and the value with its don't care bits cleared, so testing
+whether a term holds an input is one AND and one compare. Both arrays are
+aligned to CUBE_STORE_ALIGNMENT bytes and padded to a multiple of
+CUBE_STORE_LANES terms with entries that never match, so loops over the
+store can run whole vectors without a remainder.
+*************************************************************************/
+
+shrinquemStatus CubeStoreFromSumOfProducts(
+    const SumOfProducts* sumOfProducts,
+    CubeStore* store)
+{
+    if (sumOfProducts == NULL || store == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    const cube64 allVars = CUBE64_ALL_VARS(sumOfProducts->numVars);
+    shrinquemStatus status = AllocateCubeStore(sumOfProducts->numVars, sumOfProducts->numTerms, store);
+    if (status != STATUS_OKAY)
+        return status;
+
+    for (unsigned long iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
+    {
+        cube64 care = ~sumOfProducts->dontCares[iTerm] & allVars;
+        store->cares[iTerm] = care;
+        store->values[iTerm] = sumOfProducts->terms[iTerm] & care;
+    }
+
+    store->numTerms = sumOfProducts->numTerms;
+    store->polarity = sumOfProducts->polarity;
+
+    return STATUS_OKAY;
+}
+
+/*************************************************************************
+SumOfProductsFromCubeStore
+Purpose - copies the terms of a cube store back into the terms and
+  dontCares arrays of a sum-of-products, which is then released with
+  FinalizeSumOfProducts
+*************************************************************************/
+
+shrinquemStatus SumOfProductsFromCubeStore(
+    const CubeStore* store,
+    SumOfProducts* sumOfProducts)
+{
+    if (store == NULL || sumOfProducts == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    const cube64 allVars = CUBE64_ALL_VARS(store->numVars);
+    sumOfProducts->numVars = store->numVars;
+    sumOfProducts->numTerms = 0;
+    sumOfProducts->polarity = store->polarity;
+    sumOfProducts->terms = NULL; // the caller should not have allocated any memory
+    sumOfProducts->dontCares = NULL; // the caller should not have allocated any memory
+
+    if (store->numTerms == 0)
+        return STATUS_OKAY;
+
+    sumOfProducts->terms = AllocateMemory(store->numTerms * sizeof(cube64));
+    sumOfProducts->dontCares = AllocateMemory(store->numTerms * sizeof(cube64));
+    if (sumOfProducts->terms == NULL || sumOfProducts->dontCares == NULL)
+    {
+        FreeMemory(sumOfProducts->terms);
+        FreeMemory(sumOfProducts->dontCares);
+        sumOfProducts->terms = NULL;
+        sumOfProducts->dontCares = NULL;
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    memcpy(sumOfProducts->terms, store->values, store->numTerms * sizeof(cube64));
+    for (unsigned long iTerm = 0; iTerm < store->numTerms; iTerm++)
+    {
+        sumOfProducts->dontCares[iTerm] = ~store->cares[iTerm] & allVars;
+    }
+    sumOfProducts->numTerms = store->numTerms;
+
+    return STATUS_OKAY;
+}
+
+void FinalizeCubeStore(
+    CubeStore* store)
+{
+    if (store == NULL)
+        return;
+
+    FreeAligned(store->cares);
+    FreeAligned(store->values);
+    store->cares = NULL;
+    store->values = NULL;
+    store->numVars = 0;
+    store->numTerms = 0;
+    store->capacity = 0;
+    store->polarity = POLARITY_SUM_OF_PRODUCTS;
+}
+
+/*************************************************************************
+EvaluateCubeStore
+Purpose - evaluates the terms of the store for one input. Each block of
+  CUBE_STORE_LANES terms is tested without branches so the compiler can
+  vectorize it, and the loop only stops between blocks.
+*************************************************************************/
+
+triLogic EvaluateCubeStore(
+    const CubeStore* store,
+    const cube64 input)
+{
+    const cube64* cares = store->cares;
+    const cube64* values = store->values;
+    const triLogic covered = (store->polarity == POLARITY_PRODUCT_OF_SUMS) ? LOGIC_FALSE : LOGIC_TRUE;
+
+    for (unsigned long iBlock = 0; iBlock < store->capacity; iBlock += CUBE_STORE_LANES)
+    {
+        int isHit = 0;
+        for (unsigned long iLane = iBlock; iLane < iBlock + CUBE_STORE_LANES; iLane++)
+        {
+            isHit |= ((input & cares[iLane]) == values[iLane]);
+        }
+
+        if (isHit)
+            return covered;
+    }
+
+    return !covered;
+}
+
+/*************************************************************************
+CubeStoreFindContaining
+Purpose - returns the index of the first term that contains the cube given
+  by value and care (care being the complement of its don't cares), or
+  numTerms when no term does. Term i contains the cube when the cube cares
+  about every variable term i cares about and they agree on all of them.
+*************************************************************************/
+
+unsigned long CubeStoreFindContaining(
+    const CubeStore* store,
+    const cube64 value,
+    const cube64 care)
+{
+    const cube64* cares = store->cares;
+    const cube64* values = store->values;
+
+    for (unsigned long iBlock = 0; iBlock < store->capacity; iBlock += CUBE_STORE_LANES)
+    {
+        int isHit = 0;
+        for (unsigned long iLane = iBlock; iLane < iBlock + CUBE_STORE_LANES; iLane++)
+        {
+            isHit |= ((care & cares[iLane]) == cares[iLane]) & ((value & cares[iLane]) == values[iLane]);
+        }
+
+        if (isHit)
+        {
+            for (unsigned long iLane = iBlock; iLane < iBlock + CUBE_STORE_LANES; iLane++)
+            {
+                if ((care & cares[iLane]) == cares[iLane] && (value & cares[iLane]) == values[iLane])
+                    return iLane;
+            }
+        }
+    }
+
+    return store->numTerms;
+}
+
+/*************************************************************************
+AllocateCubeStore
+Purpose - allocates aligned, padded room for numTerms terms. The padding
+  lanes have no care bits and a value that no input can produce.
+*************************************************************************/
+
+shrinquemStatus AllocateCubeStore(
+    unsigned long numVars,
+    unsigned long numTerms,
+    CubeStore* store)
+{
+    unsigned long capacity = (numTerms + CUBE_STORE_LANES - 1) / CUBE_STORE_LANES * CUBE_STORE_LANES;
+
+    store->numVars = numVars;
+    store->numTerms = 0;
+    store->capacity = capacity;
+    store->polarity = POLARITY_SUM_OF_PRODUCTS;
+    store->cares = NULL;
+    store->values = NULL;
+
+    if (capacity == 0)
+        return STATUS_OKAY;
+
+    store->cares = AllocateAligned(capacity * sizeof(cube64), CUBE_STORE_ALIGNMENT);
+    store->values = AllocateAligned(capacity * sizeof(cube64), CUBE_STORE_ALIGNMENT);
+    if (store->cares == NULL || store->values == NULL)
+    {
+        FinalizeCubeStore(store);
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    PadCubeStore(store);
+
+    return STATUS_OKAY;
+}
+
+static void PadCubeStore(
+    CubeStore* store)
+{
+    for (unsigned long iLane = 0; iLane < store->capacity; iLane++)
+    {
+        store->cares[iLane] = 0;
+        store->values[iLane] = ~(cube64)0;
+    }
+}
+
+// the block from the allocator is kept in the pointer just before the aligned one, as the allocator only aligns for the basic types
+void* AllocateAligned(
+    size_t size,
+    size_t alignment)
+{
+    if (size > (size_t)-1 - alignment - sizeof(void*))
+        return NULL;
+
+    char* block = AllocateMemory(size + alignment + sizeof(void*));
+    if (block == NULL)
+        return NULL;
+
+    char* p = block + sizeof(void*);
+    p += (alignment - (size_t)p % alignment) % alignment;
+    memcpy(p - sizeof(void*), &block, sizeof(void*));
+
+    return p;
+}
+
+void FreeAligned(
+    void* p)
+{
+    if (p == NULL)
+        return;
+
+    void* block;
+    memcpy(&block, (char*)p - sizeof(void*), sizeof(void*));
+    FreeMemory(block);
+}
@@ -0,0 +1,510 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for memcpy, memcmp
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define EQUIVALENCE_TABLE_MAX_VARS (16) // up to here both covers are compared as bit tables
+#define MEMO_MAX_CUBES (64) // larger cofactors aren't remembered
+#define MEMO_MAX_ENTRIES ((unsigned long)1 << 16)
+#define INITIAL_MEMO_CAPACITY (256)
+
+typedef struct TautologyCube
+{
+    cube64 care;
+    cube64 value; // zero outside care
+} TautologyCube;
+
+typedef struct TautologyMemo
+{
+    cube64 hash;
+    unsigned long numCubes;
+    TautologyCube* cubes; // NULL for an empty slot
+    int isTautology;
+} TautologyMemo;
+
+typedef struct TautologyChecker
+{
+    TautologyMemo* memos;
+    unsigned long numMemos;
+    unsigned long capacity; // a power of 2
+    shrinquemStatus status; // set when memory runs out, the answers are then meaningless
+} TautologyChecker;
+
+static shrinquemStatus CompareTables(const SumOfProducts* first, const SumOfProducts* second, int* isEquivalent);
+static void PaintCover(const SumOfProducts* sumOfProducts, cube64 bits[]);
+static TautologyCube* CubesOfCover(const SumOfProducts* sumOfProducts);
+static int IsContained(TautologyChecker* checker, const TautologyCube inner[], unsigned long numInner, const TautologyCube outer[], unsigned long numOuter);
+static int IsTautology(TautologyChecker* checker, TautologyCube cubes[], unsigned long numCubes);
+static int IsWordTautology(const TautologyCube cubes[], unsigned long numCubes, cube64 support);
+static TautologyMemo* FindMemo(TautologyChecker* checker, cube64 hash, const TautologyCube cubes[], unsigned long numCubes);
+static void AddMemo(TautologyChecker* checker, cube64 hash, const TautologyCube cubes[], unsigned long numCubes, int isTautology);
+static int CompareTautologyCubes(const void* a, const void* b);
+
+/*************************************************************************
+AreSumOfProductsEquivalent
+Purpose - sets isEquivalent to nonzero when the two covers are the same
+  function, with no truth table for covers too wide to have one.
+
+Covers of up to EQUIVALENCE_TABLE_MAX_VARS variables are painted into bit
+tables, a word per 64 inputs, and compared word by word. Wider ones are
+checked with cubes: F XOR G is 0 exactly when every cube of F is in G and
+every cube of G is in F, and a cube c is in a cover when the cofactor of
+the cover by c is a tautology. When one cover is a product-of-sums the
+other must be its complement instead, so the two covers must share no
+input and together be a tautology.
+
+The tautology check is the unate recursive paradigm. It drops the cubes
+with a literal of a unate variable, gives up when the cubes can't add up
+to the whole space, splits on the most binate variable, and finishes in a
+single word once six variables or fewer are left. Cofactors met before are
+answered from a memo of their sorted cubes.
+*************************************************************************/
+
+shrinquemStatus AreSumOfProductsEquivalent(
+    const SumOfProducts* first,
+    const SumOfProducts* second,
+    int* isEquivalent)
+{
+    if (first == NULL || second == NULL || isEquivalent == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (first->numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+    else if (first->numVars > CUBE64_MAX_VARIABLES)
+        return STATUS_TOO_MANY_VARIABLES;
+    else if (first->numVars != second->numVars)
+        return STATUS_INVALID_ARGUMENT;
+
+    *isEquivalent = 0;
+
+    if (first->numVars <= EQUIVALENCE_TABLE_MAX_VARS)
+        return CompareTables(first, second, isEquivalent);
+
+    TautologyChecker checker = { NULL, 0, INITIAL_MEMO_CAPACITY, STATUS_OKAY };
+    TautologyCube* firstCubes = CubesOfCover(first);
+    TautologyCube* secondCubes = CubesOfCover(second);
+    checker.memos = AllocateZeroed(INITIAL_MEMO_CAPACITY, sizeof(TautologyMemo));
+    if (firstCubes == NULL || secondCubes == NULL || checker.memos == NULL)
+    {
+        checker.status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+
+    if (first->polarity == second->polarity)
+    {
+        *isEquivalent = IsContained(&checker, firstCubes, first->numTerms, secondCubes, second->numTerms) &&
+            IsContained(&checker, secondCubes, second->numTerms, firstCubes, first->numTerms);
+    }
+    else
+    {
+        // one cover is the complement of the function, so the two must split the inputs between them
+        int isDisjoint = 1;
+        for (unsigned long iFirst = 0; iFirst < first->numTerms && isDisjoint; iFirst++)
+        {
+            for (unsigned long iSecond = 0; iSecond < second->numTerms && isDisjoint; iSecond++)
+            {
+                const TautologyCube* a = &firstCubes[iFirst];
+                const TautologyCube* b = &secondCubes[iSecond];
+                isDisjoint = ((a->value ^ b->value) & a->care & b->care) != 0;
+            }
+        }
+
+        TautologyCube* both = isDisjoint ? AllocateMemory((first->numTerms + second->numTerms + 1) * sizeof(TautologyCube)) : NULL;
+        if (isDisjoint && both == NULL)
+        {
+            checker.status = STATUS_OUT_OF_MEMORY;
+        }
+        else if (isDisjoint)
+        {
+            memcpy(both, firstCubes, first->numTerms * sizeof(TautologyCube));
+            memcpy(both + first->numTerms, secondCubes, second->numTerms * sizeof(TautologyCube));
+            *isEquivalent = IsTautology(&checker, both, first->numTerms + second->numTerms);
+            FreeMemory(both);
+        }
+    }
+
+cleanupAndExit:
+
+    if (checker.memos != NULL)
+    {
+        for (unsigned long iMemo = 0; iMemo < checker.capacity; iMemo++)
+            FreeMemory(checker.memos[iMemo].cubes);
+        FreeMemory(checker.memos);
+    }
+    FreeMemory(firstCubes);
+    FreeMemory(secondCubes);
+
+    if (checker.status != STATUS_OKAY)
+        *isEquivalent = 0;
+
+    return checker.status;
+}
+
+static shrinquemStatus CompareTables(
+    const SumOfProducts* first,
+    const SumOfProducts* second,
+    int* isEquivalent)
+{
+    const unsigned long numVars = first->numVars;
+    const size_t numWords = (numVars > WORD_VARS) ? ((size_t)1 << (numVars - WORD_VARS)) : 1;
+    const cube64 lastMask = CUBE64_ALL_VARS(1UL << ((numVars < WORD_VARS) ? numVars : WORD_VARS));
+
+    cube64* firstBits = AllocateZeroed(numWords, sizeof(cube64));
+    cube64* secondBits = AllocateZeroed(numWords, sizeof(cube64));
+    if (firstBits == NULL || secondBits == NULL)
+    {
+        FreeMemory(firstBits);
+        FreeMemory(secondBits);
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    PaintCover(first, firstBits);
+    PaintCover(second, secondBits);
+
+    // a product-of-sums is the complement of its cover
+    const cube64 firstFlip = (first->polarity == POLARITY_PRODUCT_OF_SUMS) ? ~(cube64)0 : 0;
+    const cube64 secondFlip = (second->polarity == POLARITY_PRODUCT_OF_SUMS) ? ~(cube64)0 : 0;
+
+    *isEquivalent = 1;
+    for (size_t iWord = 0; iWord < numWords && *isEquivalent; iWord++)
+        *isEquivalent = (((firstBits[iWord] ^ firstFlip) ^ (secondBits[iWord] ^ secondFlip)) & lastMask) == 0;
+
+    FreeMemory(firstBits);
+    FreeMemory(secondBits);
+
+    return STATUS_OKAY;
+}
+
+// sets the bit of every input in a term, a word at a time
+static void PaintCover(
+    const SumOfProducts* sumOfProducts,
+    cube64 bits[])
+{
+    const unsigned long numVars = sumOfProducts->numVars;
+    const unsigned long numWordVars = (numVars < WORD_VARS) ? numVars : WORD_VARS;
+
+    for (unsigned long iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
+    {
+        const cube64 dontCares = sumOfProducts->dontCares[iTerm] & CUBE64_ALL_VARS(numVars);
+        const cube64 term = sumOfProducts->terms[iTerm] & ~dontCares;
+        cube64 mask = CUBE64_ALL_VARS(1UL << numWordVars);
+        for (unsigned long iVar = 0; iVar < numWordVars; iVar++)
+        {
+            if ((dontCares & CUBE64_BIT(iVar)) == 0)
+                mask &= (term & CUBE64_BIT(iVar)) ? VAR_MASKS[iVar] : ~VAR_MASKS[iVar];
+        }
+
+        const cube64 wordDontCares = dontCares >> WORD_VARS;
+        const cube64 wordBase = term >> WORD_VARS;
+        cube64 wordBits = 0;
+        do
+        {
+            bits[wordBase | wordBits] |= mask;
+            wordBits = (wordBits - wordDontCares) & wordDontCares;
+        } while (wordBits);
+    }
+}
+
+static TautologyCube* CubesOfCover(
+    const SumOfProducts* sumOfProducts)
+{
+    const cube64 allVars = CUBE64_ALL_VARS(sumOfProducts->numVars);
+    TautologyCube* cubes = AllocateMemory((sumOfProducts->numTerms + 1) * sizeof(TautologyCube));
+    if (cubes == NULL)
+        return NULL;
+
+    for (unsigned long iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
+    {
+        cubes[iTerm].care = ~sumOfProducts->dontCares[iTerm] & allVars;
+        cubes[iTerm].value = sumOfProducts->terms[iTerm] & cubes[iTerm].care;
+    }
+
+    return cubes;
+}
+
+// returns nonzero when every cube of inner is covered by the outer cubes
+static int IsContained(
+    TautologyChecker* checker,
+    const TautologyCube inner[],
+    unsigned long numInner,
+    const TautologyCube outer[],
+    unsigned long numOuter)
+{
+    TautologyCube* cofactor = AllocateMemory((numOuter + 1) * sizeof(TautologyCube));
+    if (cofactor == NULL)
+    {
+        checker->status = STATUS_OUT_OF_MEMORY;
+        return 0;
+    }
+
+    int isContained = 1;
+    for (unsigned long iInner = 0; iInner < numInner && isContained; iInner++)
+    {
+        // the cofactor by a cube keeps the outer cubes meeting it, without its variables
+        const TautologyCube* cube = &inner[iInner];
+        unsigned long numCofactor = 0;
+        for (unsigned long iOuter = 0; iOuter < numOuter; iOuter++)
+        {
+            if (((outer[iOuter].value ^ cube->value) & outer[iOuter].care & cube->care) != 0)
+                continue;
+            cofactor[numCofactor].care = outer[iOuter].care & ~cube->care;
+            cofactor[numCofactor].value = outer[iOuter].value & ~cube->care;
+            numCofactor++;
+        }
+
+        isContained = IsTautology(checker, cofactor, numCofactor);
+    }
+
+    FreeMemory(cofactor);
+
+    return isContained && checker->status == STATUS_OKAY;
+}
+
+// returns nonzero when the cubes cover every input, the cubes are reordered and their array reused
+static int IsTautology(
+    TautologyChecker* checker,
+    TautologyCube cubes[],
+    unsigned long numCubes)
+{
+    if (checker->status != STATUS_OKAY)
+        return 0;
+
+    // drop the cubes with a literal of a unate variable, the cover is a tautology only if the rest is
+    for (; ; )
+    {
+        cube64 trueVars = 0;
+        cube64 falseVars = 0;
+        for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+        {
+            if (cubes[iCube].care == 0)
+                return 1; // a cube without literals covers everything
+            trueVars |= cubes[iCube].value;
+            falseVars |= cubes[iCube].care & ~cubes[iCube].value;
+        }
+
+        cube64 unateVars = trueVars ^ falseVars;
+        if (unateVars == 0)
+            break;
+
+        unsigned long numKept = 0;
+        for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+        {
+            if ((cubes[iCube].care & unateVars) == 0)
+                cubes[numKept++] = cubes[iCube];
+        }
+        numCubes = numKept;
+    }
+
+    if (numCubes == 0)
+        return 0;
+
+    // the cubes can't cover the space when their sizes add up to less than it
+    double volume = 0.0;
+    cube64 support = 0;
+    for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+    {
+        unsigned long numLiterals = PopCount64(cubes[iCube].care);
+        volume += 1.0 / (double)CUBE64_BIT(numLiterals < CUBE64_MAX_VARIABLES ? numLiterals : CUBE64_MAX_VARIABLES - 1);
+        support |= cubes[iCube].care;
+    }
+    if (volume < 1.0)
+        return 0;
+
+    if (PopCount64(support) <= WORD_VARS)
+        return IsWordTautology(cubes, numCubes, support);
+
+    // the same cofactor is often reached along different paths
+    TautologyMemo* memo = NULL;
+    cube64 hash = 0;
+    if (numCubes <= MEMO_MAX_CUBES)
+    {
+        qsort(cubes, numCubes, sizeof(TautologyCube), CompareTautologyCubes);
+        hash = 0xCBF29CE484222325ULL;
+        for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+        {
+            hash = (hash ^ cubes[iCube].care) * 0x100000001B3ULL;
+            hash = (hash ^ cubes[iCube].value) * 0x100000001B3ULL;
+        }
+        memo = FindMemo(checker, hash, cubes, numCubes);
+        if (memo != NULL)
+            return memo->isTautology;
+    }
+
+    // split on the variable in the most cubes with both polarities, the most even one on ties
+    unsigned long bestVar = 0;
+    unsigned long bestTotal = 0;
+    unsigned long bestDifference = 0;
+    for (unsigned long iVar = 0; iVar < CUBE64_MAX_VARIABLES; iVar++)
+    {
+        cube64 bitMask = CUBE64_BIT(iVar);
+        if ((support & bitMask) == 0)
+            continue;
+
+        unsigned long numTrue = 0;
+        unsigned long numFalse = 0;
+        for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+        {
+            if (cubes[iCube].care & bitMask)
+            {
+                numTrue += (cubes[iCube].value & bitMask) != 0;
+                numFalse += (cubes[iCube].value & bitMask) == 0;
+            }
+        }
+
+        unsigned long difference = (numTrue > numFalse) ? numTrue - numFalse : numFalse - numTrue;
+        if (numTrue > 0 && numFalse > 0 &&
+            (numTrue + numFalse > bestTotal || (numTrue + numFalse == bestTotal && difference < bestDifference)))
+        {
+            bestVar = iVar;
+            bestTotal = numTrue + numFalse;
+            bestDifference = difference;
+        }
+    }
+
+    TautologyCube* cofactor = AllocateMemory(numCubes * sizeof(TautologyCube));
+    if (cofactor == NULL)
+    {
+        checker->status = STATUS_OUT_OF_MEMORY;
+        return 0;
+    }
+
+    const cube64 bestMask = CUBE64_BIT(bestVar);
+    int isTautology = 1;
+    for (int isTrue = 1; isTrue >= 0 && isTautology; isTrue--)
+    {
+        const cube64 bestValue = isTrue ? bestMask : 0;
+        unsigned long numCofactor = 0;
+        for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+        {
+            if ((cubes[iCube].care & bestMask) && (cubes[iCube].value & bestMask) != bestValue)
+                continue;
+            cofactor[numCofactor].care = cubes[iCube].care & ~bestMask;
+            cofactor[numCofactor].value = cubes[iCube].value & ~bestMask;
+            numCofactor++;
+        }
+        isTautology = IsTautology(checker, cofactor, numCofactor);
+    }
+
+    FreeMemory(cofactor);
+
+    if (numCubes <= MEMO_MAX_CUBES && checker->status == STATUS_OKAY)
+        AddMemo(checker, hash, cubes, numCubes, isTautology);
+
+    return isTautology;
+}
+
+// builds the cover as a table of its support, at most six variables, in one word
+static int IsWordTautology(
+    const TautologyCube cubes[],
+    unsigned long numCubes,
+    cube64 support)
+{
+    unsigned long supportVars[WORD_VARS];
+    unsigned long numSupportVars = 0;
+    for (unsigned long iVar = 0; iVar < CUBE64_MAX_VARIABLES; iVar++)
+    {
+        if (support & CUBE64_BIT(iVar))
+            supportVars[numSupportVars++] = iVar;
+    }
+
+    const cube64 allBits = CUBE64_ALL_VARS(1UL << numSupportVars);
+    cube64 covered = 0;
+    for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+    {
+        cube64 mask = allBits;
+        for (unsigned long iSupport = 0; iSupport < numSupportVars; iSupport++)
+        {
+            cube64 bitMask = CUBE64_BIT(supportVars[iSupport]);
+            if (cubes[iCube].care & bitMask)
+                mask &= (cubes[iCube].value & bitMask) ? VAR_MASKS[iSupport] : ~VAR_MASKS[iSupport];
+        }
+        covered |= mask;
+    }
+
+    return covered == allBits;
+}
+
+static TautologyMemo* FindMemo(
+    TautologyChecker* checker,
+    cube64 hash,
+    const TautologyCube cubes[],
+    unsigned long numCubes)
+{
+    unsigned long iSlot = (unsigned long)(hash >> 17) & (checker->capacity - 1);
+
+    while (checker->memos[iSlot].cubes != NULL)
+    {
+        const TautologyMemo* memo = &checker->memos[iSlot];
+        if (memo->hash == hash && memo->numCubes == numCubes && memcmp(memo->cubes, cubes, numCubes * sizeof(TautologyCube)) == 0)
+            return &checker->memos[iSlot];
+        iSlot = (iSlot + 1) & (checker->capacity - 1);
+    }
+
+    return NULL;
+}
+
+// remembers the answer for the sorted cubes, when the memo isn't full and memory allows
+static void AddMemo(
+    TautologyChecker* checker,
+    cube64 hash,
+    const TautologyCube cubes[],
+    unsigned long numCubes,
+    int isTautology)
+{
+    if (checker->numMemos >= MEMO_MAX_ENTRIES)
+        return;
+
+    if (2 * (checker->numMemos + 1) > checker->capacity)
+    {
+        unsigned long newCapacity = 2 * checker->capacity;
+        TautologyMemo* newMemos = AllocateZeroed(newCapacity, sizeof(TautologyMemo));
+        if (newMemos == NULL)
+            return;
+
+        for (unsigned long iMemo = 0; iMemo < checker->capacity; iMemo++)
+        {
+            if (checker->memos[iMemo].cubes == NULL)
+                continue;
+            unsigned long iSlot = (unsigned long)(checker->memos[iMemo].hash >> 17) & (newCapacity - 1);
+            while (newMemos[iSlot].cubes != NULL)
+                iSlot = (iSlot + 1) & (newCapacity - 1);
+            newMemos[iSlot] = checker->memos[iMemo];
+        }
+
+        FreeMemory(checker->memos);
+        checker->memos = newMemos;
+        checker->capacity = newCapacity;
+    }
+
+    TautologyCube* copy = AllocateMemory((numCubes + 1) * sizeof(TautologyCube));
+    if (copy == NULL)
+        return;
+    memcpy(copy, cubes, numCubes * sizeof(TautologyCube));
+
+    unsigned long iSlot = (unsigned long)(hash >> 17) & (checker->capacity - 1);
+    while (checker->memos[iSlot].cubes != NULL)
+        iSlot = (iSlot + 1) & (checker->capacity - 1);
+
+    checker->memos[iSlot].hash = hash;
+    checker->memos[iSlot].numCubes = numCubes;
+    checker->memos[iSlot].cubes = copy;
+    checker->memos[iSlot].isTautology = isTautology;
+    checker->numMemos++;
+}
+
+static int CompareTautologyCubes(
+    const void* a,
+    const void* b)
+{
+    const TautologyCube* first = (const TautologyCube*)a;
+    const TautologyCube* second = (const TautologyCube*)b;
+
+    if (first->care != second->care)
+        return (first->care < second->care) ? -1 : 1;
+    if (first->value != second->value)
+        return (first->value < second->value) ? -1 : 1;
+    return 0;
+}
@@ -0,0 +1,479 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for memmove
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+
+// sub-functions of up to this many variables try all three expansions, larger ones pick one heuristically
+#define ESOP_EXACT_VARS (6)
+
+// the pairwise merging of cubes is quadratic, so it is skipped for very large covers
+#define ESOP_MAX_MERGE_TERMS (1 << 14)
+
+static const unsigned long MAX_NUM_VARIABLES = sizeof(cube64) * BITS_PER_BYTE;
+
+typedef enum
+{
+    EXPANSION_SHANNON = 0,      // f = x' f0 ^ x f1
+    EXPANSION_POSITIVE_DAVIO,   // f = f0 ^ x (f0 ^ f1)
+    EXPANSION_NEGATIVE_DAVIO,   // f = f1 ^ x' (f0 ^ f1)
+    NUM_EXPANSIONS,
+} esopExpansion;
+
+typedef struct EsopBuilder
+{
+    unsigned long numTerms;
+    unsigned long capacity;
+    cube64* terms;
+    cube64* dontCares;
+    cube64 allVars;
+} EsopBuilder;
+
+static shrinquemStatus ExpandEsop(EsopBuilder* builder, const triLogic table[], unsigned long numVars, int fixDontCares, triLogic scratch[]);
+static shrinquemStatus ExpandEsopWith(EsopBuilder* builder, esopExpansion expansion, const triLogic table[], unsigned long numVars, int fixDontCares, triLogic scratch[]);
+static esopExpansion ChooseExpansion(const triLogic table[], unsigned long numVars, int fixDontCares);
+static shrinquemStatus AppendEsopCube(EsopBuilder* builder);
+static void AddLiteral(EsopBuilder* builder, unsigned long iFirstTerm, unsigned long var, int isPositive);
+static void MergeEsopCubes(EsopBuilder* builder);
+static void RemoveEsopCube(EsopBuilder* builder, unsigned long iTerm);
+
+/*************************************************************************
+ReduceLogicEsop
+Purpose - generates an exclusive-sum-of-products (ESOP) for the truth table,
+  i.e. a list of cubes whose exclusive-or is the function. The terms and
+  dontCares arrays have the same meaning as for ReduceLogic, but the result
+  must be evaluated with EvaluateExclusiveSumOfProducts and printed with
+  GenerateExclusiveEquationString.
+
+The cover is a pseudo-Kronecker expression: every sub-function is split on
+its highest variable by whichever of the Shannon, positive Davio or negative
+Davio expansions gives the fewest cubes. Parity-like functions, which need
+2^(numVars-1) terms as a sum-of-products, take only numVars cubes this way.
+Cubes at distance zero or one are then merged using x ^ x = 0, x ^ x' = 1,
+x ^ 1 = x' and x' ^ 1 = x.
+
+Don't cares are kept as such by the Shannon expansion. A Davio expansion
+needs the exact value of the cofactor it reuses, so that cofactor has its
+don't cares resolved to 0.
+*************************************************************************/
+
+shrinquemStatus ReduceLogicEsop(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts)
+{
+    shrinquemStatus status = STATUS_OKAY;
+    triLogic* scratch = NULL;
+    EsopBuilder builder = { 0 };
+
+    if (truthTable == NULL || sumOfProducts == NULL)
+    {
+        return STATUS_NULL_ARGUMENT;
+    }
+    else if (sumOfProducts->numVars < 1)
+    {
+        return STATUS_TOO_FEW_VARIABLES;
+    }
+    else if (sumOfProducts->numVars > MAX_NUM_VARIABLES || sumOfProducts->numVars >= sizeof(size_t) * BITS_PER_BYTE)
+    {
+        return STATUS_TOO_MANY_VARIABLES;
+    }
+
+    unsigned long numVars = sumOfProducts->numVars;
+    cube64 sizeTruthtable = CUBE64_BIT(numVars);
+    sumOfProducts->numTerms = 0;
+    sumOfProducts->polarity = POLARITY_SUM_OF_PRODUCTS;
+    sumOfProducts->terms = NULL; // the caller should not have allocated any memory
+    sumOfProducts->dontCares = NULL; // the caller should not have allocated any memory
+
+    builder.allVars = CUBE64_ALL_VARS(numVars);
+
+    // the exclusive-or of the two cofactors at each depth fits in half of the previous one
+    scratch = (triLogic*)AllocateMemory(sizeTruthtable * sizeof(triLogic));
+    if (scratch == NULL)
+    {
+        status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+
+    status = ExpandEsop(&builder, truthTable, numVars, 0, scratch);
+    if (status != STATUS_OKAY)
+        goto cleanupAndExit;
+
+    if (builder.numTerms <= ESOP_MAX_MERGE_TERMS)
+        MergeEsopCubes(&builder);
+
+    sumOfProducts->numTerms = builder.numTerms;
+
+    // we're just making these buffers smaller so it should never fail, but ignore the case that it does
+    void* p;
+    p = ReallocateMemory(builder.terms, builder.numTerms * sizeof(cube64));
+    sumOfProducts->terms = (p || builder.numTerms == 0) ? p : builder.terms;
+    p = ReallocateMemory(builder.dontCares, builder.numTerms * sizeof(cube64));
+    sumOfProducts->dontCares = (p || builder.numTerms == 0) ? p : builder.dontCares;
+    builder.terms = NULL;
+    builder.dontCares = NULL;
+
+cleanupAndExit:
+
+    if (scratch)
+    {
+        FreeMemory(scratch);
+        scratch = NULL;
+    }
+
+    if (builder.terms)
+    {
+        FreeMemory(builder.terms);
+        builder.terms = NULL;
+    }
+
+    if (builder.dontCares)
+    {
+        FreeMemory(builder.dontCares);
+        builder.dontCares = NULL;
+    }
+
+    return status;
+}
+
+/*************************************************************************
+GenerateExclusiveEquationString
+Purpose - generates a null-terminated string representation of the
+  exclusive-sum-of-products generated by the ReduceLogicEsop function,
+  e.g. "A ^ BC' ^ 1"
+*************************************************************************/
+
+shrinquemStatus GenerateExclusiveEquationString(
+    SumOfProducts* sumOfProducts,
+    const char** const varNames)
+{
+    return GenerateTermsString(sumOfProducts, varNames, " ^ ");
+}
+
+/*************************************************************************
+EvaluateExclusiveSumOfProducts
+Purpose - evaluates the exclusive-sum-of-products produced by
+          ReduceLogicEsop given a certain set of boolean inputs.
+*************************************************************************/
+
+triLogic EvaluateExclusiveSumOfProducts(
+    const SumOfProducts sumOfProducts,
+    const cube64 input)
+{
+    // clear out bits that might be set in the input which are beyond the number of variables we are evaluating
+    const cube64 inputMask = CUBE64_ALL_VARS(sumOfProducts.numVars);
+    cube64 constrainedInput = input & inputMask;
+    unsigned long parity = 0;
+
+    // every product term which is TRUE flips the result
+    for (unsigned long iTerm = 0; iTerm < sumOfProducts.numTerms; iTerm++)
+        parity ^= ((constrainedInput | sumOfProducts.dontCares[iTerm]) == (sumOfProducts.terms[iTerm] | sumOfProducts.dontCares[iTerm]));
+
+    return parity ? LOGIC_TRUE : LOGIC_FALSE;
+}
+
+static shrinquemStatus ExpandEsop(
+    EsopBuilder* builder,
+    const triLogic table[],
+    unsigned long numVars,
+    int fixDontCares,
+    triLogic scratch[])
+{
+    shrinquemStatus status = STATUS_OKAY;
+    cube64 size = CUBE64_BIT(numVars);
+    int hasTrue = 0;
+    int hasFalse = 0;
+
+    // constant sub-functions end the recursion, with don't cares taking whichever value makes them constant
+    for (cube64 iInput = 0; iInput < size && !(hasTrue && hasFalse); iInput++)
+    {
+        triLogic value = table[iInput];
+        if (value == LOGIC_TRUE)
+            hasTrue = 1;
+        else if (value == LOGIC_FALSE || fixDontCares)
+            hasFalse = 1;
+    }
+
+    if (!hasTrue)
+        return STATUS_OKAY;
+
+    if (!hasFalse)
+        return AppendEsopCube(builder);
+
+    if (numVars > ESOP_EXACT_VARS)
+        return ExpandEsopWith(builder, ChooseExpansion(table, numVars, fixDontCares), table, numVars, fixDontCares, scratch);
+
+    // try each expansion, keeping the smallest cover at the start of this sub-function's cubes
+    unsigned long iFirstTerm = builder->numTerms;
+    unsigned long bestNumTerms = 0;
+    unsigned long bestNumLiterals = 0;
+
+    for (int expansion = 0; expansion < NUM_EXPANSIONS; expansion++)
+    {
+        unsigned long iOptionStart = builder->numTerms;
+        status = ExpandEsopWith(builder, (esopExpansion)expansion, table, numVars, fixDontCares, scratch);
+        if (status != STATUS_OKAY)
+            return status;
+
+        // fewer cubes win, and fewer literals break a tie
+        unsigned long numOptionTerms = builder->numTerms - iOptionStart;
+        unsigned long numOptionLiterals = 0;
+        for (unsigned long iTerm = iOptionStart; iTerm < builder->numTerms; iTerm++)
+        {
+            for (cube64 literals = ~builder->dontCares[iTerm] & builder->allVars; literals; literals &= literals - 1)
+                numOptionLiterals++;
+        }
+
+        if (expansion == 0)
+        {
+            bestNumTerms = numOptionTerms;
+            bestNumLiterals = numOptionLiterals;
+        }
+        else if (numOptionTerms < bestNumTerms || (numOptionTerms == bestNumTerms && numOptionLiterals < bestNumLiterals))
+        {
+            memmove(&builder->terms[iFirstTerm], &builder->terms[iOptionStart], numOptionTerms * sizeof(cube64));
+            memmove(&builder->dontCares[iFirstTerm], &builder->dontCares[iOptionStart], numOptionTerms * sizeof(cube64));
+            bestNumTerms = numOptionTerms;
+            bestNumLiterals = numOptionLiterals;
+        }
+
+        builder->numTerms = iFirstTerm + bestNumTerms;
+    }
+
+    return STATUS_OKAY;
+}
+
+static shrinquemStatus ExpandEsopWith(
+    EsopBuilder* builder,
+    esopExpansion expansion,
+    const triLogic table[],
+    unsigned long numVars,
+    int fixDontCares,
+    triLogic scratch[])
+{
+    shrinquemStatus status;
+    unsigned long var = numVars - 1; // split on the highest variable so both cofactors are contiguous
+    cube64 half = CUBE64_BIT(var);
+    const triLogic* cofactor0 = table;
+    const triLogic* cofactor1 = table + half;
+    triLogic* difference = scratch;
+    unsigned long iFirstTerm;
+
+    if (expansion == EXPANSION_SHANNON)
+    {
+        iFirstTerm = builder->numTerms;
+        status = ExpandEsop(builder, cofactor0, var, fixDontCares, scratch);
+        if (status != STATUS_OKAY)
+            return status;
+        AddLiteral(builder, iFirstTerm, var, 0);
+
+        iFirstTerm = builder->numTerms;
+        status = ExpandEsop(builder, cofactor1, var, fixDontCares, scratch);
+        if (status != STATUS_OKAY)
+            return status;
+        AddLiteral(builder, iFirstTerm, var, 1);
+
+        return STATUS_OKAY;
+    }
+
+    // the reused cofactor is realized exactly, and the difference is only free where the other cofactor is a don't care
+    const triLogic* reused = (expansion == EXPANSION_POSITIVE_DAVIO) ? cofactor0 : cofactor1;
+    const triLogic* other = (expansion == EXPANSION_POSITIVE_DAVIO) ? cofactor1 : cofactor0;
+
+    status = ExpandEsop(builder, reused, var, 1, scratch);
+    if (status != STATUS_OKAY)
+        return status;
+
+    for (cube64 iInput = 0; iInput < half; iInput++)
+    {
+        if (other[iInput] == LOGIC_DONT_CARE && !fixDontCares)
+            difference[iInput] = LOGIC_DONT_CARE;
+        else
+            difference[iInput] = (triLogic)((reused[iInput] == LOGIC_TRUE) ^ (other[iInput] == LOGIC_TRUE));
+    }
+
+    iFirstTerm = builder->numTerms;
+    status = ExpandEsop(builder, difference, var, fixDontCares, scratch + half);
+    if (status != STATUS_OKAY)
+        return status;
+    AddLiteral(builder, iFirstTerm, var, expansion == EXPANSION_POSITIVE_DAVIO);
+
+    return STATUS_OKAY;
+}
+
+/*************************************************************************
+ChooseExpansion
+Purpose - picks the expansion whose two sub-functions look cheapest. A
+  sub-function is weighed by its TRUE entries, or by its FALSE entries plus
+  one when its complement is cheaper (h = 1 ^ h'), so a constant weighs at
+  most one cube.
+*************************************************************************/
+
+static esopExpansion ChooseExpansion(
+    const triLogic table[],
+    unsigned long numVars,
+    int fixDontCares)
+{
+    cube64 half = CUBE64_BIT(numVars - 1);
+    unsigned long numTrue0 = 0, numFalse0 = 0, numFalseFixed0 = 0;
+    unsigned long numTrue1 = 0, numFalse1 = 0, numFalseFixed1 = 0;
+    unsigned long numTrueDifference0 = 0, numFalseDifference0 = 0; // for the positive Davio expansion
+    unsigned long numTrueDifference1 = 0, numFalseDifference1 = 0; // for the negative Davio expansion
+
+    for (cube64 iInput = 0; iInput < half; iInput++)
+    {
+        triLogic value0 = table[iInput];
+        triLogic value1 = table[iInput + half];
+        int isTrue0 = (value0 == LOGIC_TRUE);
+        int isTrue1 = (value1 == LOGIC_TRUE);
+        int isFree0 = (value0 == LOGIC_DONT_CARE && !fixDontCares);
+        int isFree1 = (value1 == LOGIC_DONT_CARE && !fixDontCares);
+
+        numTrue0 += isTrue0;
+        numTrue1 += isTrue1;
+        numFalse0 += !isTrue0 && !isFree0;
+        numFalse1 += !isTrue1 && !isFree1;
+        numFalseFixed0 += !isTrue0;
+        numFalseFixed1 += !isTrue1;
+        numTrueDifference0 += !isFree1 && (isTrue0 ^ isTrue1);
+        numFalseDifference0 += !isFree1 && !(isTrue0 ^ isTrue1);
+        numTrueDifference1 += !isFree0 && (isTrue0 ^ isTrue1);
+        numFalseDifference1 += !isFree0 && !(isTrue0 ^ isTrue1);
+    }
+
+#define ESOP_WEIGHT(numTrue, numFalse) (((numTrue) < (numFalse) + 1) ? (numTrue) : (numFalse) + 1)
+    unsigned long weightShannon = ESOP_WEIGHT(numTrue0, numFalse0) + ESOP_WEIGHT(numTrue1, numFalse1);
+    unsigned long weightPositiveDavio = ESOP_WEIGHT(numTrue0, numFalseFixed0) + ESOP_WEIGHT(numTrueDifference0, numFalseDifference0);
+    unsigned long weightNegativeDavio = ESOP_WEIGHT(numTrue1, numFalseFixed1) + ESOP_WEIGHT(numTrueDifference1, numFalseDifference1);
+#undef ESOP_WEIGHT
+
+    if (weightPositiveDavio < weightShannon && weightPositiveDavio <= weightNegativeDavio)
+        return EXPANSION_POSITIVE_DAVIO;
+    else if (weightNegativeDavio < weightShannon)
+        return EXPANSION_NEGATIVE_DAVIO;
+    else
+        return EXPANSION_SHANNON;
+}
+
+static shrinquemStatus AppendEsopCube(
+    EsopBuilder* builder)
+{
+    if (builder->numTerms == builder->capacity)
+    {
+        unsigned long newCapacity = builder->capacity ? 2 * builder->capacity : 64;
+        void* p;
+
+        p = ReallocateMemory(builder->terms, newCapacity * sizeof(cube64));
+        if (p == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        builder->terms = p;
+
+        p = ReallocateMemory(builder->dontCares, newCapacity * sizeof(cube64));
+        if (p == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        builder->dontCares = p;
+
+        builder->capacity = newCapacity;
+    }
+
+    // the new cube is the constant '1', literals are added as the recursion unwinds
+    builder->terms[builder->numTerms] = 0;
+    builder->dontCares[builder->numTerms] = builder->allVars;
+    builder->numTerms++;
+
+    return STATUS_OKAY;
+}
+
+static void AddLiteral(
+    EsopBuilder* builder,
+    unsigned long iFirstTerm,
+    unsigned long var,
+    int isPositive)
+{
+    cube64 bitMask = CUBE64_BIT(var);
+
+    for (unsigned long iTerm = iFirstTerm; iTerm < builder->numTerms; iTerm++)
+    {
+        builder->dontCares[iTerm] &= ~bitMask;
+        if (isPositive)
+            builder->terms[iTerm] |= bitMask;
+    }
+}
+
+/*************************************************************************
+MergeEsopCubes
+Purpose - merges pairs of cubes until no two are at distance zero or one.
+  Identical cubes cancel each other. Cubes which differ in one variable are
+  replaced by a single cube holding the third of x, x' and '1' for it.
+*************************************************************************/
+
+static void MergeEsopCubes(
+    EsopBuilder* builder)
+{
+    int isChanged = 1;
+
+    while (isChanged)
+    {
+        isChanged = 0;
+
+        for (unsigned long iTerm = 0; iTerm < builder->numTerms; iTerm++)
+        {
+            unsigned long jTerm = iTerm + 1;
+            while (jTerm < builder->numTerms)
+            {
+                cube64 dontCaresI = builder->dontCares[iTerm];
+                cube64 dontCaresJ = builder->dontCares[jTerm];
+                cube64 difference = (dontCaresI ^ dontCaresJ) |
+                    ((builder->terms[iTerm] ^ builder->terms[jTerm]) & ~dontCaresI & ~dontCaresJ);
+
+                if (difference == 0)
+                {
+                    // x ^ x = 0, remove the later one first so the earlier index stays valid
+                    RemoveEsopCube(builder, jTerm);
+                    RemoveEsopCube(builder, iTerm);
+                    isChanged = 1;
+                    jTerm = iTerm + 1;
+                }
+                else if ((difference & (difference - 1)) == 0)
+                {
+                    // the two cubes use two of x, x' and '1' for this variable, so together they are the third
+                    int stateI = (dontCaresI & difference) ? 2 : ((builder->terms[iTerm] & difference) ? 1 : 0);
+                    int stateJ = (dontCaresJ & difference) ? 2 : ((builder->terms[jTerm] & difference) ? 1 : 0);
+                    int merged = 3 - stateI - stateJ;
+
+                    builder->dontCares[iTerm] &= ~difference;
+                    builder->terms[iTerm] &= ~difference;
+                    if (merged == 2)
+                        builder->dontCares[iTerm] |= difference;
+                    else if (merged == 1)
+                        builder->terms[iTerm] |= difference;
+
+                    RemoveEsopCube(builder, jTerm);
+                    isChanged = 1;
+                    jTerm = iTerm + 1;
+                }
+                else
+                {
+                    jTerm++;
+                }
+
+                if (iTerm >= builder->numTerms)
+                    break;
+            }
+        }
+    }
+}
+
+static void RemoveEsopCube(
+    EsopBuilder* builder,
+    unsigned long iTerm)
+{
+    // order does not matter for an exclusive-or, so move the last cube into the hole
+    builder->numTerms--;
+    builder->terms[iTerm] = builder->terms[builder->numTerms];
+    builder->dontCares[iTerm] = builder->dontCares[builder->numTerms];
+}
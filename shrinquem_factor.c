@@ -0,0 +1,711 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for strlen, memcpy
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define INITIAL_NUM_NODES (64)
+#define FACTOR_INVALID ((unsigned long)-1) // returned when the builder runs out of memory
+
+// a product of literals, care has a bit for each variable in it and value has the bits of the true ones
+typedef struct FactorCube
+{
+    cube64 care;
+    cube64 value;
+} FactorCube;
+
+// the form being built, with a hash table of its nodes so identical ones are shared
+typedef struct FactorBuilder
+{
+    FactoredForm* factored;
+    unsigned long capacity;
+    unsigned long* hashTable; // node indices, FACTOR_INVALID when empty
+    unsigned long hashCapacity; // a power of 2
+} FactorBuilder;
+
+typedef struct EquationBuffer
+{
+    char* text;
+    size_t length;
+    size_t capacity;
+} EquationBuffer;
+
+static unsigned long FactorCubes(FactorBuilder* builder, FactorCube cubes[], unsigned long numCubes);
+static shrinquemStatus DivideByKernel(const FactorCube cubes[], unsigned long numCubes, const FactorCube kernel[], unsigned long numKernel,
+    FactorCube quotient[], unsigned long* numQuotient, FactorCube remainder[], unsigned long* numRemainder);
+static int CompareFactorCubes(const void* a, const void* b);
+static unsigned long CubeNode(FactorBuilder* builder, FactorCube cube, unsigned long firstVar, unsigned long lastVar);
+static unsigned long OrOfCubes(FactorBuilder* builder, const FactorCube cubes[], unsigned long numCubes);
+static unsigned long AddNode(FactorBuilder* builder, factorKind kind, unsigned long first, unsigned long second);
+static shrinquemStatus GrowHashTable(FactorBuilder* builder);
+static unsigned long HashNode(factorKind kind, unsigned long first, unsigned long second);
+static int EvaluateNode(const FactoredForm* factored, unsigned long iNode, cube64 input);
+static shrinquemStatus AppendNode(EquationBuffer* buffer, const FactoredForm* factored, unsigned long iNode, const char** varNames, int inProduct);
+static shrinquemStatus AppendText(EquationBuffer* buffer, const char* text, size_t length);
+
+/*************************************************************************
+FactorSumOfProducts
+Purpose - builds a multi-level expression of the terms of a cover, in
+  which literals shared by several terms are written once, like
+  AB + AC + D becoming A(B + C) + D.
+
+The expression is found by algebraic division. A literal common to all
+the cubes is pulled out first. Otherwise the literal found in the most
+cubes picks a kernel: the cubes holding it, with it and their common
+literals removed. The cubes are weakly divided by the kernel into
+quotient * kernel + remainder, and each of the three parts is factored the
+same way. The nodes are stored with their operands before them and equal
+nodes are only stored once, so the result is a DAG; its root is the last
+node. A product-of-sums cover gives the factored form of its complement
+with the same polarity, and EvaluateFactoredForm and
+GenerateFactoredEquationString respect it.
+*************************************************************************/
+
+shrinquemStatus FactorSumOfProducts(
+    const SumOfProducts* sumOfProducts,
+    FactoredForm* factored)
+{
+    if (sumOfProducts == NULL || factored == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (sumOfProducts->numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+    else if (sumOfProducts->numVars > CUBE64_MAX_VARIABLES)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    const cube64 allVars = CUBE64_ALL_VARS(sumOfProducts->numVars);
+    FactorBuilder builder = { factored, INITIAL_NUM_NODES, NULL, 0 };
+    FactorCube* cubes = NULL;
+    shrinquemStatus status = STATUS_OKAY;
+
+    factored->numVars = sumOfProducts->numVars;
+    factored->numNodes = 0;
+    factored->root = FACTOR_FALSE;
+    factored->polarity = sumOfProducts->polarity;
+    factored->nodes = AllocateMemory(INITIAL_NUM_NODES * sizeof(FactorNode)); // the caller should not have allocated any memory
+    factored->equation = NULL; // the caller should not have allocated any memory
+    if (factored->nodes == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    // the two constants are always nodes FACTOR_FALSE and FACTOR_TRUE
+    factored->nodes[FACTOR_FALSE].kind = FACTOR_KIND_FALSE;
+    factored->nodes[FACTOR_TRUE].kind = FACTOR_KIND_TRUE;
+    factored->nodes[FACTOR_FALSE].first = factored->nodes[FACTOR_FALSE].second = 0;
+    factored->nodes[FACTOR_TRUE].first = factored->nodes[FACTOR_TRUE].second = 0;
+    factored->numNodes = 2;
+
+    if (GrowHashTable(&builder) != STATUS_OKAY)
+    {
+        status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+
+    cubes = AllocateMemory((sumOfProducts->numTerms + 1) * sizeof(FactorCube));
+    if (cubes == NULL)
+    {
+        status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+
+    // duplicates would stop the division from making progress, so they are dropped
+    unsigned long numCubes = 0;
+    for (unsigned long iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
+    {
+        cubes[numCubes].care = ~sumOfProducts->dontCares[iTerm] & allVars;
+        cubes[numCubes].value = sumOfProducts->terms[iTerm] & cubes[numCubes].care;
+        numCubes++;
+    }
+
+    qsort(cubes, numCubes, sizeof(FactorCube), CompareFactorCubes);
+    unsigned long numUnique = 0;
+    for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+    {
+        if (numUnique == 0 || CompareFactorCubes(&cubes[numUnique - 1], &cubes[iCube]) != 0)
+            cubes[numUnique++] = cubes[iCube];
+    }
+
+    factored->root = FactorCubes(&builder, cubes, numUnique);
+    if (factored->root == FACTOR_INVALID)
+        status = STATUS_OUT_OF_MEMORY;
+
+cleanupAndExit:
+
+    if (status != STATUS_OKAY)
+        FinalizeFactoredForm(factored);
+
+    FreeMemory(cubes);
+    FreeMemory(builder.hashTable);
+
+    return status;
+}
+
+void FinalizeFactoredForm(
+    FactoredForm* factored)
+{
+    if (factored == NULL)
+        return;
+
+    FreeMemory(factored->nodes);
+    FreeMemory(factored->equation);
+    factored->nodes = NULL;
+    factored->equation = NULL;
+    factored->numVars = 0;
+    factored->numNodes = 0;
+    factored->root = FACTOR_FALSE;
+    factored->polarity = POLARITY_SUM_OF_PRODUCTS;
+}
+
+triLogic EvaluateFactoredForm(
+    const FactoredForm* factored,
+    const cube64 input)
+{
+    int value = EvaluateNode(factored, factored->root, input);
+    if (factored->polarity == POLARITY_PRODUCT_OF_SUMS)
+        value = !value;
+    return value ? LOGIC_TRUE : LOGIC_FALSE;
+}
+
+// returns the number of AND and OR nodes, each one operation when the form is evaluated once per node
+unsigned long FactoredFormNumOperations(
+    const FactoredForm* factored)
+{
+    unsigned long numOperations = 0;
+
+    for (unsigned long iNode = 0; iNode < factored->numNodes; iNode++)
+    {
+        factorKind kind = factored->nodes[iNode].kind;
+        numOperations += (kind == FACTOR_KIND_AND || kind == FACTOR_KIND_OR);
+    }
+
+    return numOperations;
+}
+
+/*************************************************************************
+GenerateFactoredEquationString
+Purpose - generates a null-terminated string of the factored form, like
+  A(B + C') + D, with the variable names of GenerateEquationString. For a
+  product-of-sums the complement is written by De Morgan's law, products
+  becoming sums and sums products, so it reads like (A + BC)(D').
+*************************************************************************/
+
+shrinquemStatus GenerateFactoredEquationString(
+    FactoredForm* factored,
+    const char** const varNames)
+{
+    EquationBuffer buffer = { NULL, 0, 0 };
+    char** varNamesAuto = NULL;
+    const char** varNamesToUse = (const char**)varNames;
+    shrinquemStatus status = STATUS_OKAY;
+
+    factored->equation = NULL; // the caller should not have allocated any memory
+
+    if (varNames == NULL)
+    {
+        varNamesAuto = AllocateZeroed(factored->numVars, sizeof(char*));
+        if (varNamesAuto == NULL)
+            return STATUS_OUT_OF_MEMORY;
+
+        for (unsigned long iVar = 0; iVar < factored->numVars && status == STATUS_OKAY; iVar++)
+        {
+            varNamesAuto[iVar] = AllocateMemory(2 * sizeof(char));
+            if (varNamesAuto[iVar] == NULL)
+            {
+                status = STATUS_OUT_OF_MEMORY;
+                break;
+            }
+            varNamesAuto[iVar][0] = 'A' + (char)iVar;
+            varNamesAuto[iVar][1] = 0;
+        }
+        varNamesToUse = (const char**)varNamesAuto;
+    }
+
+    if (status == STATUS_OKAY)
+        status = AppendNode(&buffer, factored, factored->root, varNamesToUse, 0);
+    if (status == STATUS_OKAY)
+        status = AppendText(&buffer, "", 1); // the null terminator
+
+    if (status == STATUS_OKAY)
+        factored->equation = buffer.text;
+    else
+        FreeMemory(buffer.text);
+
+    if (varNamesAuto != NULL)
+    {
+        for (unsigned long iVar = 0; iVar < factored->numVars; iVar++)
+            FreeMemory(varNamesAuto[iVar]);
+        FreeMemory(varNamesAuto);
+    }
+
+    return status;
+}
+
+// returns the node of the cubes, which are modified, or FACTOR_INVALID
+static unsigned long FactorCubes(
+    FactorBuilder* builder,
+    FactorCube cubes[],
+    unsigned long numCubes)
+{
+    const unsigned long numVars = builder->factored->numVars;
+
+    if (numCubes == 0)
+        return FACTOR_FALSE;
+
+    for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+    {
+        if (cubes[iCube].care == 0)
+            return FACTOR_TRUE; // a cube without literals covers everything
+    }
+
+    if (numCubes == 1)
+        return CubeNode(builder, cubes[0], 0, numVars);
+
+    // the literals every cube has, the same variable with the same value in all of them
+    cube64 allCare = ~(cube64)0;
+    cube64 allTrue = ~(cube64)0;
+    cube64 anyTrue = 0;
+    for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+    {
+        allCare &= cubes[iCube].care;
+        allTrue &= cubes[iCube].value;
+        anyTrue |= cubes[iCube].value;
+    }
+
+    FactorCube common;
+    common.care = allCare & ~(allTrue ^ anyTrue);
+    common.value = allTrue & common.care;
+    if (common.care != 0)
+    {
+        for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+        {
+            cubes[iCube].care &= ~common.care;
+            cubes[iCube].value &= ~common.care;
+        }
+
+        unsigned long commonNode = CubeNode(builder, common, 0, numVars);
+        unsigned long restNode = FactorCubes(builder, cubes, numCubes);
+        if (commonNode == FACTOR_INVALID || restNode == FACTOR_INVALID)
+            return FACTOR_INVALID;
+        return AddNode(builder, FACTOR_KIND_AND, commonNode, restNode);
+    }
+
+    // the literal in the most cubes, without one in two or more there is nothing to factor
+    unsigned long bestVar = 0;
+    unsigned long bestIsTrue = 0;
+    unsigned long bestCount = 1;
+    for (unsigned long iVar = 0; iVar < numVars; iVar++)
+    {
+        cube64 bitMask = CUBE64_BIT(iVar);
+        unsigned long numTrue = 0;
+        unsigned long numFalse = 0;
+        for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+        {
+            if (cubes[iCube].care & bitMask)
+            {
+                numTrue += (cubes[iCube].value & bitMask) != 0;
+                numFalse += (cubes[iCube].value & bitMask) == 0;
+            }
+        }
+
+        if (numTrue > bestCount || numFalse > bestCount)
+        {
+            bestVar = iVar;
+            bestIsTrue = (numTrue >= numFalse);
+            bestCount = bestIsTrue ? numTrue : numFalse;
+        }
+    }
+
+    if (bestCount < 2)
+        return OrOfCubes(builder, cubes, numCubes);
+
+    FactorCube* kernel = AllocateMemory(3 * numCubes * sizeof(FactorCube));
+    if (kernel == NULL)
+        return FACTOR_INVALID;
+    FactorCube* quotient = kernel + numCubes;
+    FactorCube* remainder = quotient + numCubes;
+
+    // the kernel is the cubes with the literal divided by it, and by whatever else they share
+    const cube64 bestMask = CUBE64_BIT(bestVar);
+    const cube64 bestValue = bestIsTrue ? bestMask : 0;
+    unsigned long numKernel = 0;
+    cube64 kernelCare = ~(cube64)0;
+    cube64 kernelAllTrue = ~(cube64)0;
+    cube64 kernelAnyTrue = 0;
+    for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+    {
+        if ((cubes[iCube].care & bestMask) && (cubes[iCube].value & bestMask) == bestValue)
+        {
+            kernel[numKernel].care = cubes[iCube].care & ~bestMask;
+            kernel[numKernel].value = cubes[iCube].value & ~bestMask;
+            kernelCare &= kernel[numKernel].care;
+            kernelAllTrue &= kernel[numKernel].value;
+            kernelAnyTrue |= kernel[numKernel].value;
+            numKernel++;
+        }
+    }
+
+    cube64 kernelCommon = kernelCare & ~(kernelAllTrue ^ kernelAnyTrue);
+    for (unsigned long iKernel = 0; iKernel < numKernel; iKernel++)
+    {
+        kernel[iKernel].care &= ~kernelCommon;
+        kernel[iKernel].value &= ~kernelCommon;
+    }
+
+    unsigned long numQuotient = 0;
+    unsigned long numRemainder = 0;
+    unsigned long node = FACTOR_INVALID;
+    if (DivideByKernel(cubes, numCubes, kernel, numKernel, quotient, &numQuotient, remainder, &numRemainder) == STATUS_OKAY)
+    {
+        unsigned long quotientNode = FactorCubes(builder, quotient, numQuotient);
+        unsigned long kernelNode = FactorCubes(builder, kernel, numKernel);
+        unsigned long remainderNode = FactorCubes(builder, remainder, numRemainder);
+        if (quotientNode != FACTOR_INVALID && kernelNode != FACTOR_INVALID && remainderNode != FACTOR_INVALID)
+        {
+            node = AddNode(builder, FACTOR_KIND_AND, quotientNode, kernelNode);
+            if (node != FACTOR_INVALID)
+                node = AddNode(builder, FACTOR_KIND_OR, node, remainderNode);
+        }
+    }
+
+    FreeMemory(kernel);
+
+    return node;
+}
+
+/*************************************************************************
+DivideByKernel
+Purpose - weak division of the cubes by the kernel. The quotient is every
+  cube q made from the first kernel cube such that q times each kernel cube
+  is one of the cubes, and the remainder is the cubes not made that way.
+  The cubes are sorted, so each product is found by a binary search.
+*************************************************************************/
+
+static shrinquemStatus DivideByKernel(
+    const FactorCube cubes[],
+    unsigned long numCubes,
+    const FactorCube kernel[],
+    unsigned long numKernel,
+    FactorCube quotient[],
+    unsigned long* numQuotient,
+    FactorCube remainder[],
+    unsigned long* numRemainder)
+{
+    FactorCube* sorted = AllocateMemory(numCubes * sizeof(FactorCube));
+    char* isUsed = AllocateZeroed(numCubes, sizeof(char));
+    if (sorted == NULL || isUsed == NULL)
+    {
+        FreeMemory(sorted);
+        FreeMemory(isUsed);
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    memcpy(sorted, cubes, numCubes * sizeof(FactorCube));
+    qsort(sorted, numCubes, sizeof(FactorCube), CompareFactorCubes);
+
+    *numQuotient = 0;
+    for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+    {
+        const FactorCube* first = &kernel[0];
+        if ((first->care & ~sorted[iCube].care) != 0 || ((first->value ^ sorted[iCube].value) & first->care) != 0)
+            continue;
+
+        FactorCube candidate;
+        candidate.care = sorted[iCube].care & ~first->care;
+        candidate.value = sorted[iCube].value & ~first->care;
+
+        unsigned long iKernel;
+        for (iKernel = 0; iKernel < numKernel; iKernel++)
+        {
+            FactorCube product;
+            if (candidate.care & kernel[iKernel].care)
+                break;
+            product.care = candidate.care | kernel[iKernel].care;
+            product.value = candidate.value | kernel[iKernel].value;
+            if (bsearch(&product, sorted, numCubes, sizeof(FactorCube), CompareFactorCubes) == NULL)
+                break;
+        }
+
+        if (iKernel == numKernel)
+        {
+            quotient[(*numQuotient)++] = candidate;
+            for (iKernel = 0; iKernel < numKernel; iKernel++)
+            {
+                FactorCube product;
+                product.care = candidate.care | kernel[iKernel].care;
+                product.value = candidate.value | kernel[iKernel].value;
+                FactorCube* found = bsearch(&product, sorted, numCubes, sizeof(FactorCube), CompareFactorCubes);
+                isUsed[found - sorted] = 1;
+            }
+        }
+    }
+
+    *numRemainder = 0;
+    for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+    {
+        if (!isUsed[iCube])
+            remainder[(*numRemainder)++] = sorted[iCube];
+    }
+
+    FreeMemory(sorted);
+    FreeMemory(isUsed);
+
+    return STATUS_OKAY;
+}
+
+// sorts the cubes with the highest variables first, the order GenerateEquationString writes them in
+static int CompareFactorCubes(
+    const void* a,
+    const void* b)
+{
+    const FactorCube* first = (const FactorCube*)a;
+    const FactorCube* second = (const FactorCube*)b;
+
+    if (first->care != second->care)
+        return (first->care > second->care) ? -1 : 1;
+    if (first->value != second->value)
+        return (first->value > second->value) ? -1 : 1;
+    return 0;
+}
+
+// returns the AND of the literals of the cube between firstVar and lastVar, split in halves to keep the DAG shallow
+static unsigned long CubeNode(
+    FactorBuilder* builder,
+    FactorCube cube,
+    unsigned long firstVar,
+    unsigned long lastVar)
+{
+    cube64 rangeMask = CUBE64_ALL_VARS(lastVar) & ~CUBE64_ALL_VARS(firstVar);
+    cube64 literals = cube.care & rangeMask;
+
+    if (literals == 0)
+        return FACTOR_TRUE;
+
+    if ((literals & (literals - 1)) == 0)
+    {
+        unsigned long iVar = firstVar;
+        while ((literals & CUBE64_BIT(iVar)) == 0)
+            iVar++;
+        return AddNode(builder, FACTOR_KIND_LITERAL, iVar, (cube.value & CUBE64_BIT(iVar)) != 0);
+    }
+
+    // the higher variables come first so they are written first, like variable A in GenerateEquationString
+    unsigned long middleVar = firstVar + (lastVar - firstVar) / 2;
+    unsigned long highNode = CubeNode(builder, cube, middleVar, lastVar);
+    unsigned long lowNode = CubeNode(builder, cube, firstVar, middleVar);
+    if (highNode == FACTOR_INVALID || lowNode == FACTOR_INVALID)
+        return FACTOR_INVALID;
+    return AddNode(builder, FACTOR_KIND_AND, highNode, lowNode);
+}
+
+// returns the OR of the cubes, split in halves to keep the DAG shallow
+static unsigned long OrOfCubes(
+    FactorBuilder* builder,
+    const FactorCube cubes[],
+    unsigned long numCubes)
+{
+    const unsigned long numVars = builder->factored->numVars;
+
+    if (numCubes == 1)
+        return CubeNode(builder, cubes[0], 0, numVars);
+
+    unsigned long firstNode = OrOfCubes(builder, cubes, numCubes / 2);
+    unsigned long secondNode = OrOfCubes(builder, cubes + numCubes / 2, numCubes - numCubes / 2);
+    if (firstNode == FACTOR_INVALID || secondNode == FACTOR_INVALID)
+        return FACTOR_INVALID;
+    return AddNode(builder, FACTOR_KIND_OR, firstNode, secondNode);
+}
+
+/*************************************************************************
+AddNode
+Purpose - returns the node with the kind and operands, adding it when it is
+  new. ANDs and ORs with a constant operand are simplified away instead.
+*************************************************************************/
+
+static unsigned long AddNode(
+    FactorBuilder* builder,
+    factorKind kind,
+    unsigned long first,
+    unsigned long second)
+{
+    FactoredForm* factored = builder->factored;
+
+    if (kind == FACTOR_KIND_AND)
+    {
+        if (first == FACTOR_FALSE || second == FACTOR_FALSE)
+            return FACTOR_FALSE;
+        if (first == FACTOR_TRUE)
+            return second;
+        if (second == FACTOR_TRUE || first == second)
+            return first;
+    }
+    else if (kind == FACTOR_KIND_OR)
+    {
+        if (first == FACTOR_TRUE || second == FACTOR_TRUE)
+            return FACTOR_TRUE;
+        if (first == FACTOR_FALSE)
+            return second;
+        if (second == FACTOR_FALSE || first == second)
+            return first;
+    }
+
+    unsigned long iSlot = HashNode(kind, first, second) & (builder->hashCapacity - 1);
+    while (builder->hashTable[iSlot] != FACTOR_INVALID)
+    {
+        const FactorNode* node = &factored->nodes[builder->hashTable[iSlot]];
+        if (node->kind == kind && node->first == first && node->second == second)
+            return builder->hashTable[iSlot];
+        iSlot = (iSlot + 1) & (builder->hashCapacity - 1);
+    }
+
+    if (factored->numNodes == builder->capacity)
+    {
+        FactorNode* nodes = ReallocateMemory(factored->nodes, 2 * builder->capacity * sizeof(FactorNode));
+        if (nodes == NULL)
+            return FACTOR_INVALID;
+        factored->nodes = nodes;
+        builder->capacity *= 2;
+    }
+
+    unsigned long iNode = factored->numNodes++;
+    factored->nodes[iNode].kind = kind;
+    factored->nodes[iNode].first = first;
+    factored->nodes[iNode].second = second;
+    builder->hashTable[iSlot] = iNode;
+
+    if (2 * factored->numNodes > builder->hashCapacity && GrowHashTable(builder) != STATUS_OKAY)
+        return FACTOR_INVALID;
+
+    return iNode;
+}
+
+// doubles the hash table, or makes the first one, and puts the nodes back in
+static shrinquemStatus GrowHashTable(
+    FactorBuilder* builder)
+{
+    const FactoredForm* factored = builder->factored;
+    unsigned long newCapacity = (builder->hashCapacity == 0) ? 2 * INITIAL_NUM_NODES : 2 * builder->hashCapacity;
+    unsigned long* newTable = AllocateMemory(newCapacity * sizeof(unsigned long));
+    if (newTable == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    for (unsigned long iSlot = 0; iSlot < newCapacity; iSlot++)
+        newTable[iSlot] = FACTOR_INVALID;
+
+    for (unsigned long iNode = 0; iNode < factored->numNodes; iNode++)
+    {
+        const FactorNode* node = &factored->nodes[iNode];
+        unsigned long iSlot = HashNode(node->kind, node->first, node->second) & (newCapacity - 1);
+        while (newTable[iSlot] != FACTOR_INVALID)
+            iSlot = (iSlot + 1) & (newCapacity - 1);
+        newTable[iSlot] = iNode;
+    }
+
+    FreeMemory(builder->hashTable);
+    builder->hashTable = newTable;
+    builder->hashCapacity = newCapacity;
+
+    return STATUS_OKAY;
+}
+
+static unsigned long HashNode(
+    factorKind kind,
+    unsigned long first,
+    unsigned long second)
+{
+    cube64 hash = ((cube64)kind * 0x9E3779B97F4A7C15ULL) ^ ((cube64)first * 0xC2B2AE3D27D4EB4FULL) ^ ((cube64)second * 0x165667B19E3779F9ULL);
+    return (unsigned long)(hash ^ (hash >> 29));
+}
+
+// the operands of an AND or OR are only evaluated as far as they decide it
+static int EvaluateNode(
+    const FactoredForm* factored,
+    unsigned long iNode,
+    cube64 input)
+{
+    const FactorNode* node = &factored->nodes[iNode];
+
+    switch (node->kind)
+    {
+    case FACTOR_KIND_TRUE:
+        return 1;
+    case FACTOR_KIND_LITERAL:
+        return ((input >> node->first) & 1) == node->second;
+    case FACTOR_KIND_AND:
+        return EvaluateNode(factored, node->first, input) && EvaluateNode(factored, node->second, input);
+    case FACTOR_KIND_OR:
+        return EvaluateNode(factored, node->first, input) || EvaluateNode(factored, node->second, input);
+    default:
+        return 0;
+    }
+}
+
+/*************************************************************************
+AppendNode
+Purpose - writes a node to the buffer. A product-of-sums is written as its
+  dual, so an AND node is written as a sum and an OR node as a product, and
+  a sum inside a product is put in parentheses.
+*************************************************************************/
+
+static shrinquemStatus AppendNode(
+    EquationBuffer* buffer,
+    const FactoredForm* factored,
+    unsigned long iNode,
+    const char** varNames,
+    int inProduct)
+{
+    const FactorNode* node = &factored->nodes[iNode];
+    const int isDual = (factored->polarity == POLARITY_PRODUCT_OF_SUMS);
+    shrinquemStatus status;
+
+    if (node->kind == FACTOR_KIND_FALSE || node->kind == FACTOR_KIND_TRUE)
+        return AppendText(buffer, ((node->kind == FACTOR_KIND_TRUE) != isDual) ? "1" : "0", 1);
+
+    if (node->kind == FACTOR_KIND_LITERAL)
+    {
+        const char* name = varNames[factored->numVars - node->first - 1];
+        status = AppendText(buffer, name, strlen(name));
+        if (status == STATUS_OKAY && (node->second == 0) != isDual)
+            status = AppendText(buffer, "'", 1);
+        return status;
+    }
+
+    const int isSum = (node->kind == FACTOR_KIND_OR) != isDual;
+    const int hasParentheses = isSum && inProduct;
+
+    status = hasParentheses ? AppendText(buffer, "(", 1) : STATUS_OKAY;
+    if (status == STATUS_OKAY)
+        status = AppendNode(buffer, factored, node->first, varNames, !isSum);
+    if (status == STATUS_OKAY && isSum)
+        status = AppendText(buffer, " + ", 3);
+    if (status == STATUS_OKAY)
+        status = AppendNode(buffer, factored, node->second, varNames, !isSum);
+    if (status == STATUS_OKAY && hasParentheses)
+        status = AppendText(buffer, ")", 1);
+
+    return status;
+}
+
+static shrinquemStatus AppendText(
+    EquationBuffer* buffer,
+    const char* text,
+    size_t length)
+{
+    if (buffer->length + length > buffer->capacity)
+    {
+        size_t newCapacity = (buffer->capacity == 0) ? 64 : 2 * buffer->capacity;
+        while (newCapacity < buffer->length + length)
+            newCapacity *= 2;
+
+        char* newText = ReallocateMemory(buffer->text, newCapacity);
+        if (newText == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        buffer->text = newText;
+        buffer->capacity = newCapacity;
+    }
+
+    memcpy(buffer->text + buffer->length, text, length);
+    buffer->length += length;
+
+    return STATUS_OKAY;
+}
@@ -0,0 +1,425 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for memcpy
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+struct IncrementalReduction
+{
+    unsigned long numVars;
+    unsigned long numTerms;
+    unsigned long capacity;
+    cube64* terms;               // don't care bits are always clear
+    cube64* dontCares;
+    unsigned long* refCntTable;  // number of terms covering each minterm
+
+    // minterms left uncovered and terms to check for redundancy by the current update
+    unsigned long numPending;
+    unsigned long pendingCapacity;
+    cube64* pending;
+    unsigned long numCandidates;
+    unsigned long candidateCapacity;
+    cube64* candidates;          // terms, not indices, since indices move on removal
+    cube64* candidateDontCares;
+};
+
+static void AddTermReferences(IncrementalReduction* reduction, cube64 term, cube64 dontCares, long delta);
+static shrinquemStatus AppendTerm(IncrementalReduction* reduction, cube64 term, cube64 dontCares);
+static void RemoveTerm(IncrementalReduction* reduction, unsigned long iTerm);
+static shrinquemStatus PushPending(IncrementalReduction* reduction, cube64 input);
+static shrinquemStatus PushCandidate(IncrementalReduction* reduction, cube64 term, cube64 dontCares);
+static cube64 ExpandMinterm(const IncrementalReduction* reduction, const triLogic truthTable[], cube64 minterm);
+static void RemoveRedundantCandidates(IncrementalReduction* reduction, const triLogic truthTable[]);
+
+/*************************************************************************
+CreateIncrementalReduction
+Purpose - minimizes the truth table with ReduceLogic and keeps the cover
+  along with how many terms cover each minterm, so that later edits of the
+  table can be applied by UpdateIncrementalReduction without starting over.
+*************************************************************************/
+
+shrinquemStatus CreateIncrementalReduction(
+    const triLogic truthTable[],
+    unsigned long numVars,
+    IncrementalReduction** reduction)
+{
+    shrinquemStatus status;
+
+    if (truthTable == NULL || reduction == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    *reduction = NULL;
+
+    SumOfProducts sumOfProducts = { .numVars = numVars };
+    status = ReduceLogic(truthTable, &sumOfProducts);
+    if (status != STATUS_OKAY)
+        return status;
+
+    IncrementalReduction* newReduction = AllocateZeroed(1, sizeof(IncrementalReduction));
+    if (newReduction == NULL)
+    {
+        FinalizeSumOfProducts(&sumOfProducts);
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    newReduction->numVars = numVars;
+    newReduction->numTerms = sumOfProducts.numTerms;
+    newReduction->capacity = sumOfProducts.numTerms;
+    newReduction->terms = sumOfProducts.terms;
+    newReduction->dontCares = sumOfProducts.dontCares;
+    newReduction->refCntTable = AllocateZeroed((size_t)1 << numVars, sizeof(long));
+    if (newReduction->refCntTable == NULL)
+    {
+        DestroyIncrementalReduction(newReduction);
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    for (unsigned long iTerm = 0; iTerm < newReduction->numTerms; iTerm++)
+    {
+        newReduction->terms[iTerm] &= ~newReduction->dontCares[iTerm];
+        AddTermReferences(newReduction, newReduction->terms[iTerm], newReduction->dontCares[iTerm], 1);
+    }
+
+    *reduction = newReduction;
+
+    return STATUS_OKAY;
+}
+
+void DestroyIncrementalReduction(
+    IncrementalReduction* reduction)
+{
+    if (reduction == NULL)
+        return;
+
+    FreeMemory(reduction->terms);
+    FreeMemory(reduction->dontCares);
+    FreeMemory(reduction->refCntTable);
+    FreeMemory(reduction->pending);
+    FreeMemory(reduction->candidates);
+    FreeMemory(reduction->candidateDontCares);
+    FreeMemory(reduction);
+}
+
+/*************************************************************************
+UpdateIncrementalReduction
+Purpose - brings the cover up to date after the caller changed the entries
+  of truthTable listed in changedInputs.
+
+Terms that now cover a FALSE entry are dropped, ON minterms that are left
+uncovered are expanded into new terms the same way ReduceLogic does it, and
+only the terms touching the edit are checked for redundancy. The work is
+proportional to the size of the affected terms rather than to 2^numVars,
+apart from scanning the term list for the ones containing each edit.
+*************************************************************************/
+
+shrinquemStatus UpdateIncrementalReduction(
+    IncrementalReduction* reduction,
+    const triLogic truthTable[],
+    const cube64 changedInputs[],
+    unsigned long numChanged)
+{
+    shrinquemStatus status = STATUS_OKAY;
+
+    if (reduction == NULL || truthTable == NULL || (changedInputs == NULL && numChanged > 0))
+        return STATUS_NULL_ARGUMENT;
+
+    const cube64 allInputs = CUBE64_ALL_VARS(reduction->numVars);
+    reduction->numPending = 0;
+    reduction->numCandidates = 0;
+
+    for (unsigned long iChange = 0; iChange < numChanged && status == STATUS_OKAY; iChange++)
+    {
+        cube64 input = changedInputs[iChange] & allInputs;
+
+        if (truthTable[input] == LOGIC_TRUE)
+        {
+            if (reduction->refCntTable[input] == 0)
+                status = PushPending(reduction, input);
+            continue;
+        }
+
+        // a FALSE entry can't be covered at all, and a term covering a new don't care may have become redundant
+        for (unsigned long iTerm = 0; iTerm < reduction->numTerms && status == STATUS_OKAY; )
+        {
+            cube64 term = reduction->terms[iTerm];
+            cube64 dontCares = reduction->dontCares[iTerm];
+
+            if ((input & ~dontCares) != term)
+            {
+                iTerm++;
+            }
+            else if (truthTable[input] == LOGIC_FALSE)
+            {
+                RemoveTerm(reduction, iTerm);
+
+                // its ON minterms that nothing else covers have to be covered again
+                cube64 dcBits = 0;
+                do
+                {
+                    cube64 minterm = term | dcBits;
+                    if (truthTable[minterm] == LOGIC_TRUE && reduction->refCntTable[minterm] == 0)
+                        status = PushPending(reduction, minterm);
+                    dcBits = (dcBits - dontCares) & dontCares;
+                } while (dcBits && status == STATUS_OKAY);
+            }
+            else
+            {
+                status = PushCandidate(reduction, term, dontCares);
+                iTerm++;
+            }
+        }
+    }
+
+    // cover the pending minterms, skipping the ones an earlier new term already covered
+    for (unsigned long iPending = 0; iPending < reduction->numPending && status == STATUS_OKAY; iPending++)
+    {
+        cube64 minterm = reduction->pending[iPending];
+        if (truthTable[minterm] != LOGIC_TRUE || reduction->refCntTable[minterm] != 0)
+            continue;
+
+        cube64 dontCares = ExpandMinterm(reduction, truthTable, minterm);
+        cube64 term = minterm & ~dontCares;
+        status = AppendTerm(reduction, term, dontCares);
+
+        // the new term may make the terms it overlaps redundant
+        for (unsigned long iTerm = 0; iTerm < reduction->numTerms - 1 && status == STATUS_OKAY; iTerm++)
+        {
+            cube64 commonCares = ~(dontCares | reduction->dontCares[iTerm]);
+            if (((term ^ reduction->terms[iTerm]) & commonCares) == 0)
+                status = PushCandidate(reduction, reduction->terms[iTerm], reduction->dontCares[iTerm]);
+        }
+    }
+
+    if (status == STATUS_OKAY)
+        RemoveRedundantCandidates(reduction, truthTable);
+
+    return status;
+}
+
+/*************************************************************************
+GetIncrementalSumOfProducts
+Purpose - copies the current cover into sumOfProducts, which is then used
+  like the result of ReduceLogic and released with FinalizeSumOfProducts
+*************************************************************************/
+
+shrinquemStatus GetIncrementalSumOfProducts(
+    const IncrementalReduction* reduction,
+    SumOfProducts* sumOfProducts)
+{
+    if (reduction == NULL || sumOfProducts == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    sumOfProducts->numVars = reduction->numVars;
+    sumOfProducts->numTerms = 0;
+    sumOfProducts->polarity = POLARITY_SUM_OF_PRODUCTS;
+    sumOfProducts->terms = NULL; // the caller should not have allocated any memory
+    sumOfProducts->dontCares = NULL; // the caller should not have allocated any memory
+
+    if (reduction->numTerms == 0)
+        return STATUS_OKAY;
+
+    sumOfProducts->terms = AllocateMemory(reduction->numTerms * sizeof(cube64));
+    sumOfProducts->dontCares = AllocateMemory(reduction->numTerms * sizeof(cube64));
+    if (sumOfProducts->terms == NULL || sumOfProducts->dontCares == NULL)
+    {
+        FreeMemory(sumOfProducts->terms);
+        FreeMemory(sumOfProducts->dontCares);
+        sumOfProducts->terms = NULL;
+        sumOfProducts->dontCares = NULL;
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    memcpy(sumOfProducts->terms, reduction->terms, reduction->numTerms * sizeof(cube64));
+    memcpy(sumOfProducts->dontCares, reduction->dontCares, reduction->numTerms * sizeof(cube64));
+    sumOfProducts->numTerms = reduction->numTerms;
+
+    return STATUS_OKAY;
+}
+
+static void AddTermReferences(
+    IncrementalReduction* reduction,
+    cube64 term,
+    cube64 dontCares,
+    long delta)
+{
+    // walk all subsets of the don't care bits
+    cube64 dcBits = 0;
+    do
+    {
+        reduction->refCntTable[term | dcBits] += delta;
+        dcBits = (dcBits - dontCares) & dontCares;
+    } while (dcBits);
+}
+
+static shrinquemStatus AppendTerm(
+    IncrementalReduction* reduction,
+    cube64 term,
+    cube64 dontCares)
+{
+    if (reduction->numTerms == reduction->capacity)
+    {
+        unsigned long newCapacity = (reduction->capacity > 0) ? 2 * reduction->capacity : 16;
+        cube64* newTerms = ReallocateMemory(reduction->terms, newCapacity * sizeof(cube64));
+        if (newTerms == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        reduction->terms = newTerms;
+
+        cube64* newDontCares = ReallocateMemory(reduction->dontCares, newCapacity * sizeof(cube64));
+        if (newDontCares == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        reduction->dontCares = newDontCares;
+        reduction->capacity = newCapacity;
+    }
+
+    reduction->terms[reduction->numTerms] = term;
+    reduction->dontCares[reduction->numTerms] = dontCares;
+    reduction->numTerms++;
+    AddTermReferences(reduction, term, dontCares, 1);
+
+    return STATUS_OKAY;
+}
+
+static void RemoveTerm(
+    IncrementalReduction* reduction,
+    unsigned long iTerm)
+{
+    AddTermReferences(reduction, reduction->terms[iTerm], reduction->dontCares[iTerm], -1);
+
+    // the order of the terms doesn't matter, so move the last one into the hole
+    reduction->numTerms--;
+    reduction->terms[iTerm] = reduction->terms[reduction->numTerms];
+    reduction->dontCares[iTerm] = reduction->dontCares[reduction->numTerms];
+}
+
+static shrinquemStatus PushPending(
+    IncrementalReduction* reduction,
+    cube64 input)
+{
+    if (reduction->numPending == reduction->pendingCapacity)
+    {
+        unsigned long newCapacity = (reduction->pendingCapacity > 0) ? 2 * reduction->pendingCapacity : 16;
+        cube64* newPending = ReallocateMemory(reduction->pending, newCapacity * sizeof(cube64));
+        if (newPending == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        reduction->pending = newPending;
+        reduction->pendingCapacity = newCapacity;
+    }
+
+    reduction->pending[reduction->numPending++] = input;
+
+    return STATUS_OKAY;
+}
+
+static shrinquemStatus PushCandidate(
+    IncrementalReduction* reduction,
+    cube64 term,
+    cube64 dontCares)
+{
+    if (reduction->numCandidates == reduction->candidateCapacity)
+    {
+        unsigned long newCapacity = (reduction->candidateCapacity > 0) ? 2 * reduction->candidateCapacity : 16;
+        cube64* newCandidates = ReallocateMemory(reduction->candidates, newCapacity * sizeof(cube64));
+        if (newCandidates == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        reduction->candidates = newCandidates;
+
+        cube64* newDontCares = ReallocateMemory(reduction->candidateDontCares, newCapacity * sizeof(cube64));
+        if (newDontCares == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        reduction->candidateDontCares = newDontCares;
+        reduction->candidateCapacity = newCapacity;
+    }
+
+    reduction->candidates[reduction->numCandidates] = term;
+    reduction->candidateDontCares[reduction->numCandidates] = dontCares;
+    reduction->numCandidates++;
+
+    return STATUS_OKAY;
+}
+
+/*************************************************************************
+ExpandMinterm
+Purpose - returns the don't care bits of the term grown from minterm by
+  trying each variable in turn, exactly like ReduceLogic. Only the half that
+  a new don't care adds has to be checked for FALSE entries.
+*************************************************************************/
+
+static cube64 ExpandMinterm(
+    const IncrementalReduction* reduction,
+    const triLogic truthTable[],
+    cube64 minterm)
+{
+    cube64 dontCares = 0;
+
+    for (unsigned long iBitTest = 0; iBitTest < reduction->numVars; iBitTest++)
+    {
+        cube64 bitMaskTest = CUBE64_BIT(iBitTest);
+        cube64 otherHalf = (minterm ^ bitMaskTest) & ~dontCares;
+        cube64 dcBits = 0;
+        int hitsFalse = 0;
+
+        do
+        {
+            if (truthTable[otherHalf | dcBits] == LOGIC_FALSE)
+            {
+                hitsFalse = 1;
+                break;
+            }
+            dcBits = (dcBits - dontCares) & dontCares;
+        } while (dcBits);
+
+        if (!hitsFalse)
+            dontCares |= bitMaskTest;
+    }
+
+    return dontCares;
+}
+
+/*************************************************************************
+RemoveRedundantCandidates
+Purpose - drops each candidate term whose TRUE minterms are all covered by
+  other terms. Candidates are checked one at a time with the reference
+  counts kept current, so two terms covering each other are never both
+  removed.
+*************************************************************************/
+
+static void RemoveRedundantCandidates(
+    IncrementalReduction* reduction,
+    const triLogic truthTable[])
+{
+    for (unsigned long iCandidate = 0; iCandidate < reduction->numCandidates; iCandidate++)
+    {
+        cube64 term = reduction->candidates[iCandidate];
+        cube64 dontCares = reduction->candidateDontCares[iCandidate];
+        unsigned long iTerm;
+
+        // the same term may have been queued more than once or removed already
+        for (iTerm = 0; iTerm < reduction->numTerms; iTerm++)
+        {
+            if (reduction->terms[iTerm] == term && reduction->dontCares[iTerm] == dontCares)
+                break;
+        }
+
+        if (iTerm == reduction->numTerms)
+            continue;
+
+        int isRedundant = 1;
+        cube64 dcBits = 0;
+        do
+        {
+            cube64 minterm = term | dcBits;
+            if (truthTable[minterm] == LOGIC_TRUE && reduction->refCntTable[minterm] < 2)
+            {
+                isRedundant = 0;
+                break;
+            }
+            dcBits = (dcBits - dontCares) & dontCares;
+        } while (dcBits);
+
+        if (isRedundant)
+            RemoveTerm(reduction, iTerm);
+    }
+}
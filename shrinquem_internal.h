@@ -0,0 +1,268 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+// declarations shared between the shrinquem source files, not part of the public interface
+
+#if !defined(INC_SHRINQUEM_INTERNAL_H)
+#define INC_SHRINQUEM_INTERNAL_H
+
+#include <stddef.h> // used for size_t
+#include <stdio.h> // used for FILE
+#include "shrinquem.h"
+
+shrinquemStatus GenerateTermsString(
+    SumOfProducts* sumOfProducts,
+    const char** const varNames,
+    const char* separator);
+
+#define BITS_PER_BYTE (8)
+#define BITS_PER_WORD (64)
+#define WORD_VARS (6) // variables indexing the bits inside one word of a bit table
+
+// returns the number of set bits with word-level arithmetic
+unsigned long PopCount64(
+    cube64 bits);
+
+// returns the index of the lowest set bit of a nonzero word
+unsigned long LowestBitIndex(
+    cube64 bits);
+
+// returns the words of the narrowest wide cube holding numVars variables, or 0 past WIDE_MAX_VARIABLES
+unsigned long WideCubeWords(
+    unsigned long numVars);
+
+// functions of up to this many variables have their whole truth table in one 64-bit word
+#define SINGLE_WORD_MAX_VARS (6)
+
+// bit i of VAR_MASKS[v] is set when bit v of the truth table index i is set
+extern const cube64 VAR_MASKS[SINGLE_WORD_MAX_VARS];
+
+shrinquemStatus ReduceLogicSingleWord(
+    const triLogic truthTable[],
+    const triLogic onValue,
+    SumOfProducts* sumOfProducts,
+    unsigned long* numKept,
+    unsigned long* numRemoved);
+
+// the time the loops of a minimization stop improving the cover at, and whether they reached it
+typedef struct Deadline
+{
+    double seconds; // in the clock of GetSeconds
+    int isPassed;
+} Deadline;
+
+// how often the loops check the deadline, often enough that a latency budget is kept to about a millisecond
+#define DEADLINE_MINTERM_INTERVAL ((cube64)1 << 10)
+#define DEADLINE_TERM_INTERVAL    ((cube64)1 << 4)
+
+double GetSeconds(void);
+
+int IsPastDeadline(
+    Deadline* deadline);
+
+// where and how often the expansion loop of ReduceLogicCore saves its state
+typedef struct Checkpoint
+{
+    const char* path;
+    double interval;  // seconds between saves
+    double lastSaved; // in the clock of GetSeconds
+    cube64 tableHash;
+    int isResuming;   // the loop starts from the state in the file
+} Checkpoint;
+
+shrinquemStatus SaveCheckpoint(
+    Checkpoint* checkpoint,
+    const SumOfProducts* sumOfProducts,
+    triLogic onValue,
+    const triLogic resolved[],
+    cube64 nextInput);
+
+shrinquemStatus LoadCheckpoint(
+    const Checkpoint* checkpoint,
+    SumOfProducts* sumOfProducts,
+    size_t maxNumTerms,
+    triLogic onValue,
+    triLogic resolved[],
+    cube64* nextInput);
+
+cube64 HashTruthTable(
+    const triLogic truthTable[],
+    unsigned long numVars);
+
+shrinquemStatus ExpandTermsOrdered(
+    const triLogic truthTable[],
+    const triLogic onValue,
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    SumOfProducts* sumOfProducts);
+
+shrinquemStatus RemoveRedundantTerms(
+    const triLogic truthTable[],
+    const triLogic onValue,
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    SumOfProducts* sumOfProducts,
+    unsigned long* numKept,
+    unsigned long* numRemoved);
+
+double TermCost(
+    const ReduceLogicOptions* options,
+    unsigned long numVars,
+    cube64 dontCares);
+
+double CoverCost(
+    const ReduceLogicOptions* options,
+    const SumOfProducts* sumOfProducts);
+
+void GetVariableOrder(
+    const ReduceLogicOptions* options,
+    unsigned long numVars,
+    unsigned long order[]);
+
+// how often the loops of a minimization report their progress and check for cancellation
+#define PROGRESS_MINTERM_INTERVAL ((cube64)1 << 16)
+#define PROGRESS_TERM_INTERVAL    ((cube64)1 << 8)
+
+shrinquemStatus ReportProgress(
+    const ReduceLogicOptions* options,
+    progressPhase phase,
+    cube64 numProcessed,
+    cube64 numTotal,
+    unsigned long numTerms);
+
+
+// a table of all 3^numVars cubes takes 43 MB at this size
+#define TERNARY_MAX_VARS (16)
+
+#define TERNARY_IMPLICANT (1) // the cube has no entry of the opposite value
+#define TERNARY_HAS_ON    (2) // the cube has an entry of the value being covered
+#define TERNARY_NOT_PRIME (4) // dropping one of the literals still gives an implicant
+
+unsigned char* BuildTernaryImplicantTable(
+    const triLogic truthTable[],
+    unsigned long numVars,
+    triLogic onValue,
+    int markNonPrimes);
+
+unsigned long TernaryPower(
+    unsigned long exponent);
+
+// the transforms of one ReduceLogic run stop growing at this size and the remaining cubes are probed
+#define OFFSET_ORACLE_MEMORY_BUDGET ((size_t)64 << 20)
+
+typedef struct OffSetOracle OffSetOracle;
+
+OffSetOracle* CreateOffSetOracle(
+    const triLogic truthTable[],
+    unsigned long numVars,
+    triLogic offValue,
+    size_t memoryBudget);
+
+void DestroyOffSetOracle(
+    OffSetOracle* oracle);
+
+int CubeHasOffValue(
+    OffSetOracle* oracle,
+    cube64 term,
+    cube64 dontCares);
+
+shrinquemStatus AllocateCubeStore(
+    unsigned long numVars,
+    unsigned long numTerms,
+    CubeStore* store);
+
+void PutLittleEndian(
+    unsigned char bytes[],
+    cube64 value,
+    unsigned long numBytes);
+
+cube64 GetLittleEndian(
+    const unsigned char bytes[],
+    unsigned long numBytes);
+
+shrinquemStatus WriteLittleEndianWords(
+    FILE* file,
+    const cube64 words[],
+    cube64 numWords);
+
+void UnmapFile(
+    void* mapping,
+    size_t size);
+
+typedef enum
+{
+    SCRATCH_HEAP = 0,
+    SCRATCH_FILE,  // a mapping of a file in the scratch directory
+    SCRATCH_PAGES, // straight from the system, with the page policy of the options
+} scratchKind;
+
+// a zeroed work array, in memory or in a file mapping of the scratch directory of the options
+typedef struct ScratchRegion
+{
+    void* data;
+    size_t size;
+    scratchKind kind;
+    pagePolicy pages;  // the pages SCRATCH_PAGES got
+    int isInterleaved; // over the NUMA nodes
+} ScratchRegion;
+
+// the entries of a truth table the loops walk between hints to read ahead, 16 MB of a table of counts
+#define SCRATCH_BLOCK_ENTRIES ((cube64)1 << 21)
+
+// arrays from this size up come from AllocatePages, 32 MB is the resolved entries of 25 variables
+#define HUGE_PAGE_MIN_SIZE ((size_t)32 << 20)
+
+// options may be NULL for the defaults, isShared is set for an array the threads of a parallel run all use
+shrinquemStatus AllocateScratch(
+    const ReduceLogicOptions* options,
+    size_t size,
+    int isShared,
+    ScratchRegion* region);
+
+void FreeScratch(
+    ScratchRegion* region);
+
+void AdviseScratchBlock(
+    const void* data,
+    size_t size,
+    size_t offset,
+    size_t length);
+
+shrinquemStatus AllocatePages(
+    size_t size,
+    pagePolicy pages,
+    int isShared,
+    ScratchRegion* region);
+
+void FreePages(
+    ScratchRegion* region);
+
+void RecordMemoryPlacement(
+    const ScratchRegion* region);
+
+// malloc, calloc, realloc and free through the allocator of SetMemoryAllocator
+void* AllocateMemory(
+    size_t size);
+
+void* AllocateZeroed(
+    size_t count,
+    size_t size);
+
+void* ReallocateMemory(
+    void* p,
+    size_t size);
+
+void FreeMemory(
+    void* p);
+
+int IsHeapAllocator(void);
+
+void* AllocateAligned(
+    size_t size,
+    size_t alignment);
+
+void FreeAligned(
+    void* p);
+
+#endif // !defined(INC_SHRINQUEM_INTERNAL_H)
@@ -0,0 +1,173 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+// a term to try to remove, with what it is sorted by
+typedef struct RemovalCandidate
+{
+    double cost;
+    unsigned long numLiterals;
+    unsigned long iTerm;
+} RemovalCandidate;
+
+static int CompareRemovalCandidates(const void* a, const void* b);
+static void CountOnReferences(const triLogic truthTable[], triLogic onValue, unsigned long refCntTable[], cube64 term, cube64 dontCares, int delta);
+static int HasUniqueOnEntry(const triLogic truthTable[], triLogic onValue, const unsigned long refCntTable[], cube64 term, cube64 dontCares);
+
+/*************************************************************************
+RemoveRedundantTerms
+Purpose - removes the terms whose ON entries are all covered by the other
+  terms. Unlike RemoveNonprimeImplicants, a term that is the only one to
+  cover a DON'T CARE entry is not kept for it, since nothing needs that
+  entry covered.
+
+The terms are tried from the highest cost under the objective of the
+options down, then from the most literals down, so when two terms cover
+each other's ON entries the more expensive one goes, with ties going to
+the later term. The terms kept stay in their order. The DON'T CARE bits of
+the terms are cleared. Once the deadline passes, the terms not tried yet
+are all kept.
+*************************************************************************/
+
+shrinquemStatus RemoveRedundantTerms(
+    const triLogic truthTable[],
+    const triLogic onValue,
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    SumOfProducts* sumOfProducts,
+    unsigned long* numKept,
+    unsigned long* numRemoved)
+{
+    const unsigned long numVars = sumOfProducts->numVars;
+    const unsigned long numTerms = sumOfProducts->numTerms;
+
+    if (numTerms == 0 || IsPastDeadline(deadline))
+        return STATUS_OKAY;
+
+    ScratchRegion refCntScratch = { 0 };
+    shrinquemStatus status = AllocateScratch(options, (size_t)CUBE64_BIT(numVars) * sizeof(unsigned long), 0, &refCntScratch);
+    unsigned long* refCntTable = refCntScratch.data;
+    RemovalCandidate* order = AllocateMemory(numTerms * sizeof(RemovalCandidate));
+    char* isRemoved = AllocateZeroed(numTerms, sizeof(char));
+    if (refCntTable == NULL || order == NULL || isRemoved == NULL)
+    {
+        FreeScratch(&refCntScratch);
+        FreeMemory(order);
+        FreeMemory(isRemoved);
+        return (status != STATUS_OKAY) ? status : STATUS_OUT_OF_MEMORY;
+    }
+
+    for (unsigned long iTerm = 0; iTerm < numTerms; iTerm++)
+    {
+        sumOfProducts->terms[iTerm] &= ~sumOfProducts->dontCares[iTerm];
+        CountOnReferences(truthTable, onValue, refCntTable, sumOfProducts->terms[iTerm], sumOfProducts->dontCares[iTerm], 1);
+    }
+
+    for (unsigned long iTerm = 0; iTerm < numTerms; iTerm++)
+    {
+        order[iTerm].cost = TermCost(options, numVars, sumOfProducts->dontCares[iTerm]);
+        order[iTerm].numLiterals = numVars - PopCount64(sumOfProducts->dontCares[iTerm] & CUBE64_ALL_VARS(numVars));
+        order[iTerm].iTerm = iTerm;
+    }
+
+    qsort(order, numTerms, sizeof(RemovalCandidate), CompareRemovalCandidates);
+
+    for (unsigned long iOrder = 0; iOrder < numTerms; iOrder++)
+    {
+        if ((iOrder & (PROGRESS_TERM_INTERVAL - 1)) == 0 &&
+            ReportProgress(options, PROGRESS_PHASE_IRREDUNDANT, iOrder, numTerms, numTerms) != STATUS_OKAY)
+        {
+            FreeScratch(&refCntScratch);
+            FreeMemory(order);
+            FreeMemory(isRemoved);
+            return STATUS_CANCELLED;
+        }
+
+        if ((iOrder & (DEADLINE_TERM_INTERVAL - 1)) == 0 && IsPastDeadline(deadline))
+            break;
+
+        unsigned long iTerm = order[iOrder].iTerm;
+        if (!HasUniqueOnEntry(truthTable, onValue, refCntTable, sumOfProducts->terms[iTerm], sumOfProducts->dontCares[iTerm]))
+        {
+            CountOnReferences(truthTable, onValue, refCntTable, sumOfProducts->terms[iTerm], sumOfProducts->dontCares[iTerm], -1);
+            isRemoved[iTerm] = 1;
+        }
+    }
+
+    unsigned long iNewTerm = 0;
+    for (unsigned long iTerm = 0; iTerm < numTerms; iTerm++)
+    {
+        if (isRemoved[iTerm])
+            continue;
+
+        sumOfProducts->terms[iNewTerm] = sumOfProducts->terms[iTerm];
+        sumOfProducts->dontCares[iNewTerm] = sumOfProducts->dontCares[iTerm];
+        iNewTerm++;
+    }
+
+    *numKept += iNewTerm;
+    *numRemoved += numTerms - iNewTerm;
+    sumOfProducts->numTerms = iNewTerm;
+
+    FreeScratch(&refCntScratch);
+    FreeMemory(order);
+    FreeMemory(isRemoved);
+
+    return ReportProgress(options, PROGRESS_PHASE_IRREDUNDANT, numTerms, numTerms, iNewTerm);
+}
+
+// sorts the most expensive candidates first, then those with the most literals, then the later terms
+static int CompareRemovalCandidates(
+    const void* a,
+    const void* b)
+{
+    const RemovalCandidate* first = (const RemovalCandidate*)a;
+    const RemovalCandidate* second = (const RemovalCandidate*)b;
+
+    if (first->cost != second->cost)
+        return (first->cost < second->cost) ? 1 : -1;
+    if (first->numLiterals != second->numLiterals)
+        return (first->numLiterals < second->numLiterals) ? 1 : -1;
+    return (first->iTerm < second->iTerm) ? 1 : -1;
+}
+
+// adds delta to the count of every ON entry of the cube, term has its don't care bits cleared
+static void CountOnReferences(
+    const triLogic truthTable[],
+    triLogic onValue,
+    unsigned long refCntTable[],
+    cube64 term,
+    cube64 dontCares,
+    int delta)
+{
+    cube64 dcBits = 0;
+    do
+    {
+        if (truthTable[term | dcBits] == onValue)
+            refCntTable[term | dcBits] += delta;
+        dcBits = (dcBits - dontCares) & dontCares;
+    } while (dcBits);
+}
+
+// returns nonzero when the cube holds an ON entry no other term covers
+static int HasUniqueOnEntry(
+    const triLogic truthTable[],
+    triLogic onValue,
+    const unsigned long refCntTable[],
+    cube64 term,
+    cube64 dontCares)
+{
+    cube64 dcBits = 0;
+    do
+    {
+        if (truthTable[term | dcBits] == onValue && refCntTable[term | dcBits] == 1)
+            return 1;
+        dcBits = (dcBits - dontCares) & dontCares;
+    } while (dcBits);
+
+    return 0;
+}
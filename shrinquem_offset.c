@@ -0,0 +1,274 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for memcpy
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define INITIAL_NUM_MASKS (64)
+#define MIN_DONT_CARES_TO_TRACK (4)
+
+// bit i of LOW_HALF_MASKS[v] is set when bit v of i is clear
+static const cube64 LOW_HALF_MASKS[WORD_VARS] =
+{
+    0x5555555555555555ULL,
+    0x3333333333333333ULL,
+    0x0F0F0F0F0F0F0F0FULL,
+    0x00FF00FF00FF00FFULL,
+    0x0000FFFF0000FFFFULL,
+    0x00000000FFFFFFFFULL,
+};
+
+typedef struct OffSetMask
+{
+    cube64 dontCares;
+    cube64 probeCost;  // minterms probed so far for cubes with these don't cares
+    cube64* reachable; // bit x is set when x with any of the don't care bits set is OFF, or NULL
+} OffSetMask;
+
+struct OffSetOracle
+{
+    const triLogic* truthTable;
+    triLogic offValue;
+    unsigned long numVars;
+    size_t numWords;
+    size_t memoryLeft;
+    unsigned long numMasks;
+    unsigned long capacity; // a power of 2, the table is open addressed
+    OffSetMask* masks;
+};
+
+static OffSetMask* FindMask(OffSetOracle* oracle, cube64 dontCares, int canAdd);
+static void BuildReachable(OffSetOracle* oracle, OffSetMask* mask);
+static void OrTransform(cube64 reachable[], size_t numWords, unsigned long iVar);
+
+/*************************************************************************
+CreateOffSetOracle
+Purpose - sets up the answer to "does this cube have an OFF entry" for
+  the expansion loop of ReduceLogic, within memoryBudget bytes.
+
+Each query probes the minterms of the cube until the total probed for its
+set of don't cares would have paid for a transform of the OFF-set for that
+set. The transform is then built, after which the query is a single bit:
+an OR-superset-sum over the don't care variables, one variable after the
+other, leaves at x the OR of the OFF flags of every x with any of those
+bits set. Buying only once the probes have cost as much keeps the total
+within twice the better of the two choices, and the masks ReduceLogic
+never repeats are never built. When a transform would go over the budget
+the queries of that mask just keep probing.
+*************************************************************************/
+
+OffSetOracle* CreateOffSetOracle(
+    const triLogic truthTable[],
+    unsigned long numVars,
+    triLogic offValue,
+    size_t memoryBudget)
+{
+    OffSetOracle* oracle = AllocateZeroed(1, sizeof(OffSetOracle));
+    if (oracle == NULL)
+        return NULL;
+
+    oracle->masks = AllocateZeroed(INITIAL_NUM_MASKS, sizeof(OffSetMask));
+    if (oracle->masks == NULL)
+    {
+        FreeMemory(oracle);
+        return NULL;
+    }
+
+    oracle->truthTable = truthTable;
+    oracle->offValue = offValue;
+    oracle->numVars = numVars;
+    oracle->numWords = (numVars > WORD_VARS) ? ((size_t)1 << (numVars - WORD_VARS)) : 1;
+    oracle->memoryLeft = memoryBudget;
+    oracle->capacity = INITIAL_NUM_MASKS;
+
+    return oracle;
+}
+
+void DestroyOffSetOracle(
+    OffSetOracle* oracle)
+{
+    if (oracle == NULL)
+        return;
+
+    for (unsigned long iMask = 0; iMask < oracle->capacity; iMask++)
+        FreeMemory(oracle->masks[iMask].reachable);
+
+    FreeMemory(oracle->masks);
+    FreeMemory(oracle);
+}
+
+// returns nonzero when some minterm of the cube is an OFF entry
+int CubeHasOffValue(
+    OffSetOracle* oracle,
+    cube64 term,
+    cube64 dontCares)
+{
+    term &= ~dontCares;
+
+    if (dontCares == 0)
+        return oracle->truthTable[term] == oracle->offValue;
+
+    // cubes this small are cheaper to probe than to look up
+    unsigned long numDontCares = 0;
+    for (cube64 remaining = dontCares; remaining && numDontCares < MIN_DONT_CARES_TO_TRACK; remaining &= remaining - 1)
+        numDontCares++;
+
+    OffSetMask* mask = (numDontCares < MIN_DONT_CARES_TO_TRACK) ? NULL : FindMask(oracle, dontCares, 1);
+    if (mask != NULL && mask->reachable == NULL)
+    {
+        // building costs a fill from the truth table and one pass per variable, or one pass over the parent's copy
+        cube64 sizeTruthtable = CUBE64_BIT(oracle->numVars);
+        cube64 lowestDontCare = dontCares & (~dontCares + 1);
+        OffSetMask* parent = FindMask(oracle, dontCares & ~lowestDontCare, 0); // doesn't add, so mask stays where it is
+        cube64 buildCost = (parent != NULL && parent->reachable != NULL) ? 2 * oracle->numWords : sizeTruthtable;
+        for (cube64 remaining = dontCares; remaining; remaining &= remaining - 1)
+            buildCost += oracle->numWords;
+
+        size_t size = oracle->numWords * sizeof(cube64);
+        if (mask->probeCost >= buildCost && size <= oracle->memoryLeft)
+        {
+            mask->reachable = AllocateMemory(size);
+            if (mask->reachable != NULL)
+            {
+                oracle->memoryLeft -= size;
+                if (parent != NULL && parent->reachable != NULL)
+                {
+                    memcpy(mask->reachable, parent->reachable, size);
+                    OrTransform(mask->reachable, oracle->numWords, LowestBitIndex(lowestDontCare));
+                }
+                else
+                {
+                    BuildReachable(oracle, mask);
+                }
+            }
+        }
+    }
+
+    if (mask != NULL && mask->reachable != NULL)
+        return (mask->reachable[term / BITS_PER_WORD] >> (term % BITS_PER_WORD)) & 1;
+
+    // walk all subsets of the don't care bits until an OFF entry turns up
+    cube64 dcBits = 0;
+    cube64 numProbed = 0;
+    int hasOff = 0;
+    do
+    {
+        numProbed++;
+        if (oracle->truthTable[term | dcBits] == oracle->offValue)
+        {
+            hasOff = 1;
+            break;
+        }
+        dcBits = (dcBits - dontCares) & dontCares;
+    } while (dcBits);
+
+    if (mask != NULL)
+        mask->probeCost += numProbed;
+
+    return hasOff;
+}
+
+/*************************************************************************
+FindMask
+Purpose - returns the entry of a set of don't cares, or NULL when it is not
+  in the table. With canAdd a new entry is added, which can move the others,
+  and NULL is only returned when the table can't grow.
+*************************************************************************/
+
+static OffSetMask* FindMask(
+    OffSetOracle* oracle,
+    cube64 dontCares,
+    int canAdd)
+{
+    if (dontCares == 0)
+        return NULL;
+
+    if (canAdd && 2 * (oracle->numMasks + 1) > oracle->capacity)
+    {
+        unsigned long newCapacity = 2 * oracle->capacity;
+        OffSetMask* newMasks = AllocateZeroed(newCapacity, sizeof(OffSetMask));
+        if (newMasks == NULL)
+            return NULL;
+
+        for (unsigned long iMask = 0; iMask < oracle->capacity; iMask++)
+        {
+            if (oracle->masks[iMask].dontCares == 0)
+                continue;
+
+            unsigned long iSlot = (unsigned long)(oracle->masks[iMask].dontCares * 0x9E3779B97F4A7C15ULL >> 32) & (newCapacity - 1);
+            while (newMasks[iSlot].dontCares != 0)
+                iSlot = (iSlot + 1) & (newCapacity - 1);
+            newMasks[iSlot] = oracle->masks[iMask];
+        }
+
+        FreeMemory(oracle->masks);
+        oracle->masks = newMasks;
+        oracle->capacity = newCapacity;
+    }
+
+    unsigned long iSlot = (unsigned long)(dontCares * 0x9E3779B97F4A7C15ULL >> 32) & (oracle->capacity - 1);
+    while (oracle->masks[iSlot].dontCares != 0 && oracle->masks[iSlot].dontCares != dontCares)
+        iSlot = (iSlot + 1) & (oracle->capacity - 1);
+
+    if (oracle->masks[iSlot].dontCares == 0)
+    {
+        if (!canAdd)
+            return NULL;
+
+        oracle->masks[iSlot].dontCares = dontCares;
+        oracle->numMasks++;
+    }
+
+    return &oracle->masks[iSlot];
+}
+
+// packs the OFF entries into bits and runs the transform for every don't care variable
+static void BuildReachable(
+    OffSetOracle* oracle,
+    OffSetMask* mask)
+{
+    cube64 sizeTruthtable = CUBE64_BIT(oracle->numVars);
+
+    for (size_t iWord = 0; iWord < oracle->numWords; iWord++)
+        mask->reachable[iWord] = 0;
+
+    for (cube64 iInput = 0; iInput < sizeTruthtable; iInput++)
+        mask->reachable[iInput / BITS_PER_WORD] |= (cube64)(oracle->truthTable[iInput] == oracle->offValue) << (iInput % BITS_PER_WORD);
+
+    for (unsigned long iVar = 0; iVar < oracle->numVars; iVar++)
+    {
+        if (mask->dontCares & CUBE64_BIT(iVar))
+            OrTransform(mask->reachable, oracle->numWords, iVar);
+    }
+}
+
+/*************************************************************************
+OrTransform
+Purpose - ORs into every x with bit iVar clear the flag of x with it set.
+  Variables inside a word are a shift and a mask, and the others OR one
+  run of words into the run before it, so the pass streams through memory.
+*************************************************************************/
+
+static void OrTransform(
+    cube64 reachable[],
+    size_t numWords,
+    unsigned long iVar)
+{
+    if (iVar < WORD_VARS)
+    {
+        unsigned long shift = 1UL << iVar;
+        for (size_t iWord = 0; iWord < numWords; iWord++)
+            reachable[iWord] |= (reachable[iWord] >> shift) & LOW_HALF_MASKS[iVar];
+        return;
+    }
+
+    size_t run = (size_t)1 << (iVar - WORD_VARS);
+    for (size_t block = 0; block < numWords; block += 2 * run)
+    {
+        for (size_t iWord = block; iWord < block + run; iWord++)
+            reachable[iWord] |= reachable[iWord + run];
+    }
+}
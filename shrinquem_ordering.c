@@ -0,0 +1,360 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+static cube64 WordMaskOfCube(unsigned long numVars, cube64 term, cube64 dontCares);
+static unsigned long CountInCube(const cube64 bits[], unsigned long numVars, cube64 term, cube64 dontCares);
+static int AnyInCube(const cube64 bits[], unsigned long numVars, cube64 term, cube64 dontCares);
+static void ClearCube(cube64 bits[], unsigned long numVars, cube64 term, cube64 dontCares);
+static cube64 ExpandSeed(const cube64 offBits[], const cube64 uncoveredBits[], unsigned long numVars, const unsigned long varOrder[], expandOrder expansion, cube64* term);
+static shrinquemStatus SortSeedsByConstraint(const cube64 onBits[], const cube64 offBits[], unsigned long numVars, unsigned long numOn, cube64** seeds);
+
+/*************************************************************************
+ExpandTermsOrdered
+Purpose - derives the terms of ReduceLogicCore with the seed and expansion
+  orders of the options, trying the variables in the order GetVariableOrder
+  gives for the objective. The terms are not made irredundant; that is left
+  to the caller like it is for the other expansion loops. Once the deadline
+  passes, the seeds left become terms as they are.
+
+The ON, OFF and uncovered entries are packed one bit per entry, so a cube
+is a set of words picked by its high don't cares, each ANDed with a mask of
+its low literals. Checking a cube for OFF entries and counting the
+uncovered ON entries it holds are then word ANDs and popcounts.
+*************************************************************************/
+
+shrinquemStatus ExpandTermsOrdered(
+    const triLogic truthTable[],
+    const triLogic onValue,
+    const ReduceLogicOptions* options,
+    Deadline* deadline,
+    SumOfProducts* sumOfProducts)
+{
+    const unsigned long numVars = sumOfProducts->numVars;
+    const triLogic offValue = (onValue == LOGIC_TRUE) ? LOGIC_FALSE : LOGIC_TRUE;
+    const cube64 sizeTruthtable = CUBE64_BIT(numVars);
+    const size_t numWords = (numVars > WORD_VARS) ? ((size_t)1 << (numVars - WORD_VARS)) : 1;
+    shrinquemStatus status = STATUS_OKAY;
+    cube64* seeds = NULL;
+    unsigned long numOn = 0;
+    unsigned long varOrder[CUBE64_MAX_VARIABLES];
+
+    GetVariableOrder(options, numVars, varOrder);
+
+    sumOfProducts->numTerms = 0;
+    sumOfProducts->terms = NULL; // the caller should not have allocated any memory
+    sumOfProducts->dontCares = NULL; // the caller should not have allocated any memory
+
+    cube64* onBits = AllocateZeroed(numWords, sizeof(cube64));
+    cube64* offBits = AllocateZeroed(numWords, sizeof(cube64));
+    cube64* uncoveredBits = AllocateMemory(numWords * sizeof(cube64));
+    if (onBits == NULL || offBits == NULL || uncoveredBits == NULL)
+    {
+        status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+
+    for (cube64 iInput = 0; iInput < sizeTruthtable; iInput++)
+    {
+        onBits[iInput / BITS_PER_WORD] |= (cube64)(truthTable[iInput] == onValue) << (iInput % BITS_PER_WORD);
+        offBits[iInput / BITS_PER_WORD] |= (cube64)(truthTable[iInput] == offValue) << (iInput % BITS_PER_WORD);
+    }
+
+    for (size_t iWord = 0; iWord < numWords; iWord++)
+    {
+        uncoveredBits[iWord] = onBits[iWord];
+        numOn += PopCount64(onBits[iWord]);
+    }
+
+    // every term covers at least its seed, so there are never more terms than ON entries
+    if (numOn > 0)
+    {
+        sumOfProducts->terms = AllocateMemory(numOn * sizeof(cube64));
+        sumOfProducts->dontCares = AllocateMemory(numOn * sizeof(cube64));
+        if (sumOfProducts->terms == NULL || sumOfProducts->dontCares == NULL)
+        {
+            status = STATUS_OUT_OF_MEMORY;
+            goto cleanupAndExit;
+        }
+    }
+
+    if (options->seeding == SEED_ORDER_MOST_CONSTRAINED)
+    {
+        status = SortSeedsByConstraint(onBits, offBits, numVars, numOn, &seeds);
+        if (status != STATUS_OKAY)
+            goto cleanupAndExit;
+
+        for (unsigned long iSeed = 0; iSeed < numOn; iSeed++)
+        {
+            if ((iSeed & (PROGRESS_MINTERM_INTERVAL - 1)) == 0)
+            {
+                status = ReportProgress(options, PROGRESS_PHASE_EXPANDING, iSeed, numOn, sumOfProducts->numTerms);
+                if (status != STATUS_OKAY)
+                    goto cleanupAndExit;
+            }
+
+            cube64 term = seeds[iSeed];
+            if (((uncoveredBits[term / BITS_PER_WORD] >> (term % BITS_PER_WORD)) & 1) == 0)
+                continue;
+
+            if ((iSeed & (DEADLINE_MINTERM_INTERVAL - 1)) == 0)
+                IsPastDeadline(deadline);
+            cube64 dontCares = (deadline != NULL && deadline->isPassed) ? 0 :
+                ExpandSeed(offBits, uncoveredBits, numVars, varOrder, options->expansion, &term);
+            ClearCube(uncoveredBits, numVars, term, dontCares);
+            sumOfProducts->terms[sumOfProducts->numTerms] = term;
+            sumOfProducts->dontCares[sumOfProducts->numTerms] = dontCares;
+            sumOfProducts->numTerms++;
+        }
+    }
+    else
+    {
+        for (size_t iWord = 0; iWord < numWords; iWord++)
+        {
+            if (((cube64)iWord * BITS_PER_WORD & (PROGRESS_MINTERM_INTERVAL - 1)) == 0)
+            {
+                status = ReportProgress(options, PROGRESS_PHASE_EXPANDING, (cube64)iWord * BITS_PER_WORD, sizeTruthtable, sumOfProducts->numTerms);
+                if (status != STATUS_OKAY)
+                    goto cleanupAndExit;
+            }
+
+            if (((cube64)iWord * BITS_PER_WORD & (DEADLINE_MINTERM_INTERVAL - 1)) == 0)
+                IsPastDeadline(deadline);
+
+            while (uncoveredBits[iWord])
+            {
+                cube64 term = (cube64)iWord * BITS_PER_WORD + LowestBitIndex(uncoveredBits[iWord]);
+                cube64 dontCares = (deadline != NULL && deadline->isPassed) ? 0 :
+                    ExpandSeed(offBits, uncoveredBits, numVars, varOrder, options->expansion, &term);
+                ClearCube(uncoveredBits, numVars, term, dontCares);
+                sumOfProducts->terms[sumOfProducts->numTerms] = term;
+                sumOfProducts->dontCares[sumOfProducts->numTerms] = dontCares;
+                sumOfProducts->numTerms++;
+            }
+        }
+    }
+
+    status = ReportProgress(options, PROGRESS_PHASE_EXPANDING, sizeTruthtable, sizeTruthtable, sumOfProducts->numTerms);
+
+cleanupAndExit:
+
+    if (status != STATUS_OKAY)
+    {
+        FreeMemory(sumOfProducts->terms);
+        FreeMemory(sumOfProducts->dontCares);
+        sumOfProducts->numTerms = 0;
+        sumOfProducts->terms = NULL;
+        sumOfProducts->dontCares = NULL;
+    }
+
+    FreeMemory(seeds);
+    FreeMemory(onBits);
+    FreeMemory(offBits);
+    FreeMemory(uncoveredBits);
+
+    return status;
+}
+
+/*************************************************************************
+ExpandSeed
+Purpose - grows the minterm in term into a cube without OFF entries and
+  returns its don't cares, with term cleared where they are set. With
+  EXPAND_ORDER_FIXED the variables are tried once each in varOrder. With
+  EXPAND_ORDER_MOST_UNCOVERED every step takes the variable whose other half
+  has no OFF entry and the most uncovered ON entries, the one first in
+  varOrder winning ties, until no variable can be dropped.
+*************************************************************************/
+
+static cube64 ExpandSeed(
+    const cube64 offBits[],
+    const cube64 uncoveredBits[],
+    unsigned long numVars,
+    const unsigned long varOrder[],
+    expandOrder expansion,
+    cube64* term)
+{
+    cube64 dontCares = 0;
+
+    if (expansion == EXPAND_ORDER_FIXED)
+    {
+        for (unsigned long iOrder = 0; iOrder < numVars; iOrder++)
+        {
+            cube64 bitMask = CUBE64_BIT(varOrder[iOrder]);
+            if (!AnyInCube(offBits, numVars, *term ^ bitMask, dontCares))
+            {
+                dontCares |= bitMask;
+                *term &= ~bitMask;
+            }
+        }
+
+        return dontCares;
+    }
+
+    while (1)
+    {
+        unsigned long bestVar = numVars;
+        unsigned long bestCount = 0;
+
+        for (unsigned long iOrder = 0; iOrder < numVars; iOrder++)
+        {
+            cube64 bitMask = CUBE64_BIT(varOrder[iOrder]);
+            if ((dontCares & bitMask) || AnyInCube(offBits, numVars, *term ^ bitMask, dontCares))
+                continue;
+
+            unsigned long count = CountInCube(uncoveredBits, numVars, *term ^ bitMask, dontCares);
+            if (bestVar == numVars || count > bestCount)
+            {
+                bestVar = varOrder[iOrder];
+                bestCount = count;
+            }
+        }
+
+        if (bestVar == numVars)
+            break;
+
+        dontCares |= CUBE64_BIT(bestVar);
+        *term &= ~CUBE64_BIT(bestVar);
+    }
+
+    return dontCares;
+}
+
+/*************************************************************************
+SortSeedsByConstraint
+Purpose - returns the ON entries ordered by how many of their neighbors,
+  the entries one variable away, are not OFF, fewest first and ascending
+  within a count. A minterm with few such neighbors can only be covered by
+  few cubes, so it is best to pick those cubes before others take its
+  neighbors. The seeds are counted into buckets, so this is linear.
+*************************************************************************/
+
+static shrinquemStatus SortSeedsByConstraint(
+    const cube64 onBits[],
+    const cube64 offBits[],
+    unsigned long numVars,
+    unsigned long numOn,
+    cube64** seeds)
+{
+    const size_t numWords = (numVars > WORD_VARS) ? ((size_t)1 << (numVars - WORD_VARS)) : 1;
+    unsigned long bucketStarts[CUBE64_MAX_VARIABLES + 2] = { 0 };
+
+    *seeds = AllocateMemory((numOn > 0 ? numOn : 1) * sizeof(cube64));
+    if (*seeds == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    // the first pass counts the seeds of each bucket and the second places them
+    for (int iPass = 0; iPass < 2; iPass++)
+    {
+        for (size_t iWord = 0; iWord < numWords; iWord++)
+        {
+            for (cube64 remaining = onBits[iWord]; remaining; remaining &= remaining - 1)
+            {
+                cube64 minterm = (cube64)iWord * BITS_PER_WORD + LowestBitIndex(remaining);
+                unsigned long numFree = 0;
+                for (unsigned long iVar = 0; iVar < numVars; iVar++)
+                {
+                    cube64 neighbor = minterm ^ CUBE64_BIT(iVar);
+                    numFree += ((offBits[neighbor / BITS_PER_WORD] >> (neighbor % BITS_PER_WORD)) & 1) == 0;
+                }
+
+                if (iPass == 0)
+                    bucketStarts[numFree + 1]++;
+                else
+                    (*seeds)[bucketStarts[numFree]++] = minterm;
+            }
+        }
+
+        if (iPass == 0)
+        {
+            for (unsigned long iBucket = 1; iBucket <= numVars + 1; iBucket++)
+                bucketStarts[iBucket] += bucketStarts[iBucket - 1];
+        }
+    }
+
+    return STATUS_OKAY;
+}
+
+// returns the bits of one word that are in the cube, from the literals of the variables inside a word
+static cube64 WordMaskOfCube(
+    unsigned long numVars,
+    cube64 term,
+    cube64 dontCares)
+{
+    unsigned long numWordVars = (numVars < WORD_VARS) ? numVars : WORD_VARS;
+    cube64 mask = CUBE64_ALL_VARS(1UL << numWordVars);
+
+    for (unsigned long iVar = 0; iVar < numWordVars; iVar++)
+    {
+        if (dontCares & CUBE64_BIT(iVar))
+            continue;
+
+        mask &= (term & CUBE64_BIT(iVar)) ? VAR_MASKS[iVar] : ~VAR_MASKS[iVar];
+    }
+
+    return mask;
+}
+
+// the words of a cube are the subsets of its high don't cares added to its high literals
+static unsigned long CountInCube(
+    const cube64 bits[],
+    unsigned long numVars,
+    cube64 term,
+    cube64 dontCares)
+{
+    const cube64 mask = WordMaskOfCube(numVars, term, dontCares);
+    const cube64 wordDontCares = dontCares >> WORD_VARS;
+    const cube64 wordBase = (term & ~dontCares) >> WORD_VARS;
+    unsigned long count = 0;
+    cube64 wordBits = 0;
+
+    do
+    {
+        count += PopCount64(bits[wordBase | wordBits] & mask);
+        wordBits = (wordBits - wordDontCares) & wordDontCares;
+    } while (wordBits);
+
+    return count;
+}
+
+static int AnyInCube(
+    const cube64 bits[],
+    unsigned long numVars,
+    cube64 term,
+    cube64 dontCares)
+{
+    const cube64 mask = WordMaskOfCube(numVars, term, dontCares);
+    const cube64 wordDontCares = dontCares >> WORD_VARS;
+    const cube64 wordBase = (term & ~dontCares) >> WORD_VARS;
+    cube64 wordBits = 0;
+
+    do
+    {
+        if (bits[wordBase | wordBits] & mask)
+            return 1;
+        wordBits = (wordBits - wordDontCares) & wordDontCares;
+    } while (wordBits);
+
+    return 0;
+}
+
+static void ClearCube(
+    cube64 bits[],
+    unsigned long numVars,
+    cube64 term,
+    cube64 dontCares)
+{
+    const cube64 mask = WordMaskOfCube(numVars, term, dontCares);
+    const cube64 wordDontCares = dontCares >> WORD_VARS;
+    const cube64 wordBase = (term & ~dontCares) >> WORD_VARS;
+    cube64 wordBits = 0;
+
+    do
+    {
+        bits[wordBase | wordBits] &= ~mask;
+        wordBits = (wordBits - wordDontCares) & wordDontCares;
+    } while (wordBits);
+}
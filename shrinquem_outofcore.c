@@ -0,0 +1,251 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for memset, strlen
+#if defined(_WIN32)
+#include <windows.h> // used for CreateFileMapping, MapViewOfFile
+#else
+#include <fcntl.h> // used for open
+#include <sys/mman.h> // used for mmap, madvise
+#include <sys/stat.h> // used for fstat
+#include <unistd.h> // used for close, ftruncate, unlink
+#endif
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define SCRATCH_FILE_PREFIX "shrinquem-"
+#define SCRATCH_FILE_TEMPLATE "shrinquem-XXXXXX"
+
+static void* MapScratchFile(const char* directory, size_t size);
+
+/*************************************************************************
+MapTruthTableFile
+Purpose - maps a truth table kept in a file, one triLogic per byte in the
+  order of the inputs, so that functions larger than memory can be
+  minimized in place. The file must be exactly 2^numVars bytes. The values
+  are read-only; UnmapTruthTableFile releases them.
+*************************************************************************/
+
+shrinquemStatus MapTruthTableFile(
+    const char* path,
+    unsigned long numVars,
+    MappedTruthTable* table)
+{
+    if (path == NULL || table == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    memset(table, 0, sizeof(MappedTruthTable));
+
+    if (numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+    else if (numVars > CUBE64_MAX_VARIABLES || numVars >= sizeof(size_t) * BITS_PER_BYTE)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    const cube64 numEntries = CUBE64_BIT(numVars);
+
+    size_t size = 0;
+    void* mapping = NULL;
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return STATUS_FILE_ERROR;
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && (cube64)fileSize.QuadPart == numEntries)
+    {
+        HANDLE fileMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (fileMapping != NULL)
+        {
+            mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(fileMapping); // the view keeps the mapping open
+        }
+        size = (size_t)fileSize.QuadPart;
+    }
+    CloseHandle(file);
+#else
+    int file = open(path, O_RDONLY);
+    if (file < 0)
+        return STATUS_FILE_ERROR;
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) == 0 && (cube64)fileStat.st_size == numEntries)
+    {
+        size = (size_t)fileStat.st_size;
+        mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, file, 0);
+        if (mapping == MAP_FAILED)
+            mapping = NULL;
+    }
+    close(file); // the mapping stays valid
+#endif
+
+    if (mapping == NULL)
+        return (size == numEntries) ? STATUS_FILE_ERROR : STATUS_INVALID_ARGUMENT;
+
+    table->numVars = numVars;
+    table->values = (const triLogic*)mapping;
+    table->mapping = mapping;
+    table->mappingSize = size;
+
+    return STATUS_OKAY;
+}
+
+void UnmapTruthTableFile(
+    MappedTruthTable* table)
+{
+    if (table == NULL || table->mapping == NULL)
+        return;
+
+    UnmapFile(table->mapping, table->mappingSize);
+    memset(table, 0, sizeof(MappedTruthTable));
+}
+
+/*************************************************************************
+AllocateScratch
+Purpose - allocates a zeroed work array of one minimization. Without a
+  scratch directory, small arrays come from the allocator and large ones
+  from AllocatePages with the page policy of the options. With a directory
+  the array is a shared mapping of a temporary file there, so the pages
+  the loops are not using can be written out and dropped by the kernel
+  rather than swapped. The file is removed as soon as it is mapped and
+  goes away with the mapping.
+*************************************************************************/
+
+shrinquemStatus AllocateScratch(
+    const ReduceLogicOptions* options,
+    size_t size,
+    int isShared,
+    ScratchRegion* region)
+{
+    memset(region, 0, sizeof(ScratchRegion));
+
+    // a caller who set an allocator wants the memory from it, so the huge pages are only mapped for the heap
+    const char* directory = (options != NULL) ? options->scratchDirectory : NULL;
+    if (directory == NULL && size >= HUGE_PAGE_MIN_SIZE && IsHeapAllocator())
+        return AllocatePages(size, (options != NULL) ? options->pages : PAGES_TRANSPARENT_HUGE, isShared, region);
+
+    if (directory == NULL)
+    {
+        region->data = AllocateZeroed(size > 0 ? size : 1, 1);
+        region->size = size;
+        return (region->data != NULL) ? STATUS_OKAY : STATUS_OUT_OF_MEMORY;
+    }
+
+    region->data = MapScratchFile(directory, size > 0 ? size : 1);
+    region->size = size > 0 ? size : 1;
+    region->kind = SCRATCH_FILE;
+
+    if (region->data == NULL)
+    {
+        memset(region, 0, sizeof(ScratchRegion));
+        return STATUS_FILE_ERROR;
+    }
+
+    return STATUS_OKAY;
+}
+
+void FreeScratch(
+    ScratchRegion* region)
+{
+    if (region->data == NULL)
+        return;
+
+    if (region->kind == SCRATCH_FILE)
+        UnmapFile(region->data, region->size);
+    else if (region->kind == SCRATCH_PAGES)
+        FreePages(region);
+    else
+        FreeMemory(region->data);
+
+    memset(region, 0, sizeof(ScratchRegion));
+}
+
+/*************************************************************************
+AdviseScratchBlock
+Purpose - tells the kernel the block of a mapped array the loop is about
+  to walk, so it is read ahead in one go rather than a page fault at a
+  time. Arrays in memory and systems without the hint are left alone.
+*************************************************************************/
+
+void AdviseScratchBlock(
+    const void* data,
+    size_t size,
+    size_t offset,
+    size_t length)
+{
+#if defined(_WIN32)
+    (void)data;
+    (void)size;
+    (void)offset;
+    (void)length;
+#else
+    if (data == NULL || offset >= size)
+        return;
+
+    // madvise needs a page-aligned start, so the block is widened down to one
+    const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t start = offset - offset % pageSize;
+    const size_t end = (length < size - offset) ? offset + length : size;
+    madvise((char*)data + start, end - start, MADV_WILLNEED);
+#endif
+}
+
+static void* MapScratchFile(
+    const char* directory,
+    size_t size)
+{
+    void* mapping = NULL;
+
+#if defined(_WIN32)
+    char path[MAX_PATH];
+    if (GetTempFileNameA(directory, SCRATCH_FILE_PREFIX, 0, path) == 0)
+        return NULL;
+
+    // the file is deleted when the view, the last thing holding it, is unmapped
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+        FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        DeleteFileA(path);
+        return NULL;
+    }
+
+    LARGE_INTEGER fileSize;
+    fileSize.QuadPart = (LONGLONG)size;
+    HANDLE fileMapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, fileSize.HighPart, fileSize.LowPart, NULL);
+    if (fileMapping != NULL)
+    {
+        mapping = MapViewOfFile(fileMapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+        CloseHandle(fileMapping); // the view keeps the mapping open
+    }
+    CloseHandle(file);
+#else
+    size_t directoryLength = strlen(directory);
+    char* path = AllocateMemory(directoryLength + 1 + sizeof(SCRATCH_FILE_TEMPLATE));
+    if (path == NULL)
+        return NULL;
+    memcpy(path, directory, directoryLength);
+    path[directoryLength] = '/';
+    memcpy(path + directoryLength + 1, SCRATCH_FILE_TEMPLATE, sizeof(SCRATCH_FILE_TEMPLATE));
+
+    int file = mkstemp(path);
+    if (file >= 0)
+    {
+        unlink(path); // the mapping keeps the file until it is unmapped
+
+        // the file is sparse, so it reads as zeros until written
+        if (ftruncate(file, (off_t)size) == 0)
+        {
+            mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+            if (mapping == MAP_FAILED)
+                mapping = NULL;
+        }
+        close(file);
+    }
+    FreeMemory(path);
+#endif
+
+    return mapping;
+}
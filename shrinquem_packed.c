@@ -0,0 +1,551 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for memcpy
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define BYTES_PER_WORD (sizeof(cube64))
+
+static shrinquemStatus CheckOperands(const PackedTruthTable* first, const PackedTruthTable* second, const PackedTruthTable* result);
+static cube64 LastWordMask(unsigned long numVars);
+static void CopyTable(const PackedTruthTable* table, PackedTruthTable* result);
+static void CofactorWords(cube64 words[], size_t numWords, unsigned long iVar, int value);
+static void SwapWords(cube64 words[], size_t numWords, unsigned long iVar, unsigned long jVar);
+
+/*************************************************************************
+AllocatePackedTruthTable
+Purpose - makes a truth table of numVars variables with 64 entries to a
+  word, every entry FALSE.
+
+Tables are built from the variables with the operations below, each a
+loop over the words with no branches that compilers unroll and vectorize.
+That is 64 entries per operation, or 256 with 256-bit vectors, where a
+triLogic table has the caller evaluate its predicate on every entry. The
+result of ReduceLogicPacked is the same as ReduceLogicWithOptions on the
+same entries.
+*************************************************************************/
+
+shrinquemStatus AllocatePackedTruthTable(
+    unsigned long numVars,
+    PackedTruthTable* table)
+{
+    if (table == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    table->numVars = numVars;
+    table->numWords = 0;
+    table->values = NULL;
+    table->dontCares = NULL;
+
+    if (numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+    else if (numVars > CUBE64_MAX_VARIABLES || numVars >= sizeof(size_t) * BITS_PER_BYTE)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    table->numWords = (numVars > WORD_VARS) ? ((size_t)1 << (numVars - WORD_VARS)) : 1;
+    if (table->numWords > (size_t)-1 / BYTES_PER_WORD)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    table->values = AllocateAligned(table->numWords * BYTES_PER_WORD, CUBE_STORE_ALIGNMENT);
+    table->dontCares = AllocateAligned(table->numWords * BYTES_PER_WORD, CUBE_STORE_ALIGNMENT);
+    if (table->values == NULL || table->dontCares == NULL)
+    {
+        FinalizePackedTruthTable(table);
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    memset(table->values, 0, table->numWords * BYTES_PER_WORD);
+    memset(table->dontCares, 0, table->numWords * BYTES_PER_WORD);
+
+    return STATUS_OKAY;
+}
+
+void FinalizePackedTruthTable(
+    PackedTruthTable* table)
+{
+    if (table == NULL)
+        return;
+
+    FreeAligned(table->values);
+    FreeAligned(table->dontCares);
+    table->values = NULL;
+    table->dontCares = NULL;
+    table->numWords = 0;
+}
+
+shrinquemStatus PackedTableConstant(
+    triLogic value,
+    PackedTruthTable* table)
+{
+    shrinquemStatus status = CheckOperands(table, table, table);
+    if (status != STATUS_OKAY)
+        return status;
+
+    const cube64 lastMask = LastWordMask(table->numVars);
+    const cube64 valueWord = (value == LOGIC_TRUE) ? lastMask : 0;
+    const cube64 dontCareWord = (value == LOGIC_DONT_CARE) ? lastMask : 0;
+    for (size_t iWord = 0; iWord < table->numWords; iWord++)
+    {
+        table->values[iWord] = valueWord;
+        table->dontCares[iWord] = dontCareWord;
+    }
+
+    return STATUS_OKAY;
+}
+
+// the entries are TRUE where variable iVar is set, the low variables repeat a pattern and the high ones whole words
+shrinquemStatus PackedTableVariable(
+    unsigned long iVar,
+    PackedTruthTable* table)
+{
+    shrinquemStatus status = CheckOperands(table, table, table);
+    if (status != STATUS_OKAY)
+        return status;
+    else if (iVar >= table->numVars)
+        return STATUS_INVALID_ARGUMENT;
+
+    const cube64 lastMask = LastWordMask(table->numVars);
+    for (size_t iWord = 0; iWord < table->numWords; iWord++)
+    {
+        if (iVar < WORD_VARS)
+            table->values[iWord] = VAR_MASKS[iVar] & lastMask;
+        else
+            table->values[iWord] = ((iWord >> (iVar - WORD_VARS)) & 1) ? ~(cube64)0 : 0;
+        table->dontCares[iWord] = 0;
+    }
+
+    return STATUS_OKAY;
+}
+
+shrinquemStatus PackedTableAnd(
+    const PackedTruthTable* first,
+    const PackedTruthTable* second,
+    PackedTruthTable* result)
+{
+    shrinquemStatus status = CheckOperands(first, second, result);
+    if (status != STATUS_OKAY)
+        return status;
+
+    for (size_t iWord = 0; iWord < result->numWords; iWord++)
+    {
+        result->values[iWord] = first->values[iWord] & second->values[iWord];
+        result->dontCares[iWord] = first->dontCares[iWord] | second->dontCares[iWord];
+    }
+
+    return STATUS_OKAY;
+}
+
+shrinquemStatus PackedTableOr(
+    const PackedTruthTable* first,
+    const PackedTruthTable* second,
+    PackedTruthTable* result)
+{
+    shrinquemStatus status = CheckOperands(first, second, result);
+    if (status != STATUS_OKAY)
+        return status;
+
+    for (size_t iWord = 0; iWord < result->numWords; iWord++)
+    {
+        result->values[iWord] = first->values[iWord] | second->values[iWord];
+        result->dontCares[iWord] = first->dontCares[iWord] | second->dontCares[iWord];
+    }
+
+    return STATUS_OKAY;
+}
+
+shrinquemStatus PackedTableXor(
+    const PackedTruthTable* first,
+    const PackedTruthTable* second,
+    PackedTruthTable* result)
+{
+    shrinquemStatus status = CheckOperands(first, second, result);
+    if (status != STATUS_OKAY)
+        return status;
+
+    for (size_t iWord = 0; iWord < result->numWords; iWord++)
+    {
+        result->values[iWord] = first->values[iWord] ^ second->values[iWord];
+        result->dontCares[iWord] = first->dontCares[iWord] | second->dontCares[iWord];
+    }
+
+    return STATUS_OKAY;
+}
+
+shrinquemStatus PackedTableNot(
+    const PackedTruthTable* table,
+    PackedTruthTable* result)
+{
+    shrinquemStatus status = CheckOperands(table, table, result);
+    if (status != STATUS_OKAY)
+        return status;
+
+    const cube64 lastMask = LastWordMask(table->numVars);
+    for (size_t iWord = 0; iWord < result->numWords; iWord++)
+    {
+        result->values[iWord] = ~table->values[iWord] & lastMask;
+        result->dontCares[iWord] = table->dontCares[iWord];
+    }
+
+    return STATUS_OKAY;
+}
+
+// the entries that are TRUE in mask become DON'T CARE, whatever mask's own don't cares are
+shrinquemStatus PackedTableMaskDontCares(
+    const PackedTruthTable* table,
+    const PackedTruthTable* mask,
+    PackedTruthTable* result)
+{
+    shrinquemStatus status = CheckOperands(table, mask, result);
+    if (status != STATUS_OKAY)
+        return status;
+
+    for (size_t iWord = 0; iWord < result->numWords; iWord++)
+    {
+        result->values[iWord] = table->values[iWord];
+        result->dontCares[iWord] = table->dontCares[iWord] | mask->values[iWord];
+    }
+
+    return STATUS_OKAY;
+}
+
+/*************************************************************************
+PackedTableCofactor
+Purpose - the table with variable iVar fixed at value, which no longer
+  depends on iVar. A low variable moves the kept half of each word over
+  the other half with a shift, a high variable copies whole words.
+*************************************************************************/
+
+shrinquemStatus PackedTableCofactor(
+    const PackedTruthTable* table,
+    unsigned long iVar,
+    int value,
+    PackedTruthTable* result)
+{
+    shrinquemStatus status = CheckOperands(table, table, result);
+    if (status != STATUS_OKAY)
+        return status;
+    else if (iVar >= table->numVars)
+        return STATUS_INVALID_ARGUMENT;
+
+    CopyTable(table, result);
+    CofactorWords(result->values, result->numWords, iVar, value);
+    CofactorWords(result->dontCares, result->numWords, iVar, value);
+
+    return STATUS_OKAY;
+}
+
+/*************************************************************************
+PackedTableSwapVariables
+Purpose - the table with variables iVar and jVar exchanged. Two low
+  variables swap bits inside each word with a delta swap, a low and a
+  high one trade bits between pairs of words, and two high ones swap
+  whole words.
+*************************************************************************/
+
+shrinquemStatus PackedTableSwapVariables(
+    const PackedTruthTable* table,
+    unsigned long iVar,
+    unsigned long jVar,
+    PackedTruthTable* result)
+{
+    shrinquemStatus status = CheckOperands(table, table, result);
+    if (status != STATUS_OKAY)
+        return status;
+    else if (iVar >= table->numVars || jVar >= table->numVars)
+        return STATUS_INVALID_ARGUMENT;
+
+    CopyTable(table, result);
+    if (iVar != jVar)
+    {
+        unsigned long lowVar = (iVar < jVar) ? iVar : jVar;
+        unsigned long highVar = (iVar < jVar) ? jVar : iVar;
+        SwapWords(result->values, result->numWords, lowVar, highVar);
+        SwapWords(result->dontCares, result->numWords, lowVar, highVar);
+    }
+
+    return STATUS_OKAY;
+}
+
+// variable v of the table becomes variable permutation[v] of the result, done as at most numVars - 1 swaps
+shrinquemStatus PackedTablePermute(
+    const PackedTruthTable* table,
+    const unsigned long permutation[],
+    PackedTruthTable* result)
+{
+    unsigned long varAt[CUBE64_MAX_VARIABLES];   // the variable of the table at each position
+    unsigned long positionOf[CUBE64_MAX_VARIABLES];
+    unsigned long wanted[CUBE64_MAX_VARIABLES];  // the variable of the table each position ends with
+    cube64 seen = 0;
+
+    shrinquemStatus status = CheckOperands(table, table, result);
+    if (status != STATUS_OKAY)
+        return status;
+    else if (permutation == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    for (unsigned long iVar = 0; iVar < table->numVars; iVar++)
+    {
+        if (permutation[iVar] >= table->numVars || (seen & CUBE64_BIT(permutation[iVar])))
+            return STATUS_INVALID_ARGUMENT;
+        seen |= CUBE64_BIT(permutation[iVar]);
+        wanted[permutation[iVar]] = iVar;
+        varAt[iVar] = iVar;
+        positionOf[iVar] = iVar;
+    }
+
+    CopyTable(table, result);
+    for (unsigned long iPosition = 0; iPosition < table->numVars; iPosition++)
+    {
+        unsigned long fromPosition = positionOf[wanted[iPosition]];
+        if (fromPosition == iPosition)
+            continue;
+
+        // fromPosition is always higher, the lower positions are done
+        SwapWords(result->values, result->numWords, iPosition, fromPosition);
+        SwapWords(result->dontCares, result->numWords, iPosition, fromPosition);
+
+        unsigned long displaced = varAt[iPosition];
+        varAt[fromPosition] = displaced;
+        positionOf[displaced] = fromPosition;
+        varAt[iPosition] = wanted[iPosition];
+        positionOf[wanted[iPosition]] = iPosition;
+    }
+
+    return STATUS_OKAY;
+}
+
+shrinquemStatus PackedTableFromTriLogic(
+    const triLogic truthTable[],
+    PackedTruthTable* table)
+{
+    shrinquemStatus status = CheckOperands(table, table, table);
+    if (status != STATUS_OKAY)
+        return status;
+    else if (truthTable == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    const size_t numEntries = (size_t)1 << table->numVars;
+    for (size_t iWord = 0; iWord < table->numWords; iWord++)
+    {
+        const triLogic* entries = &truthTable[iWord * CUBE64_MAX_VARIABLES];
+        const unsigned long numWordEntries = (numEntries < CUBE64_MAX_VARIABLES) ? (unsigned long)numEntries : CUBE64_MAX_VARIABLES;
+        cube64 values = 0;
+        cube64 dontCares = 0;
+        for (unsigned long iEntry = 0; iEntry < numWordEntries; iEntry++)
+        {
+            values |= (cube64)(entries[iEntry] == LOGIC_TRUE) << iEntry;
+            dontCares |= (cube64)(entries[iEntry] == LOGIC_DONT_CARE) << iEntry;
+        }
+        table->values[iWord] = values;
+        table->dontCares[iWord] = dontCares;
+    }
+
+    return STATUS_OKAY;
+}
+
+/*************************************************************************
+PackedTableToTriLogic
+Purpose - writes the 2^numVars entries of the table to truthTable. Each
+  byte of a word becomes 8 entries at once through a table spreading its
+  bits into the bytes of a word, so it runs at memory speed.
+*************************************************************************/
+
+shrinquemStatus PackedTableToTriLogic(
+    const PackedTruthTable* table,
+    triLogic truthTable[])
+{
+    uint64_t spread[256]; // byte k is bit k of the index, in memory order
+    unsigned char bytes[BYTES_PER_WORD];
+
+    shrinquemStatus status = CheckOperands(table, table, table);
+    if (status != STATUS_OKAY)
+        return status;
+    else if (truthTable == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    if (table->numVars < WORD_VARS)
+    {
+        for (unsigned long iEntry = 0; iEntry < (1UL << table->numVars); iEntry++)
+        {
+            if ((table->dontCares[0] >> iEntry) & 1)
+                truthTable[iEntry] = LOGIC_DONT_CARE;
+            else
+                truthTable[iEntry] = ((table->values[0] >> iEntry) & 1) ? LOGIC_TRUE : LOGIC_FALSE;
+        }
+        return STATUS_OKAY;
+    }
+
+    for (unsigned long iByte = 0; iByte < 256; iByte++)
+    {
+        for (unsigned long iBit = 0; iBit < BITS_PER_BYTE; iBit++)
+            bytes[iBit] = (iByte >> iBit) & 1;
+        memcpy(&spread[iByte], bytes, BYTES_PER_WORD);
+    }
+
+    for (size_t iWord = 0; iWord < table->numWords; iWord++)
+    {
+        const cube64 values = table->values[iWord];
+        const cube64 dontCares = table->dontCares[iWord];
+        triLogic* entries = &truthTable[iWord * CUBE64_MAX_VARIABLES];
+        for (unsigned long iByte = 0; iByte < BYTES_PER_WORD; iByte++)
+        {
+            uint64_t valueBytes = spread[(values >> (iByte * BITS_PER_BYTE)) & 0xFF];
+            uint64_t dontCareBytes = spread[(dontCares >> (iByte * BITS_PER_BYTE)) & 0xFF];
+            uint64_t entryBytes = (valueBytes & ~dontCareBytes) | (dontCareBytes * LOGIC_DONT_CARE);
+            memcpy(&entries[iByte * BITS_PER_BYTE], &entryBytes, BYTES_PER_WORD);
+        }
+    }
+
+    return STATUS_OKAY;
+}
+
+// minimizes the table with ReduceLogicWithOptions, options may be NULL for the defaults
+shrinquemStatus ReduceLogicPacked(
+    const PackedTruthTable* table,
+    SumOfProducts* sumOfProducts,
+    const ReduceLogicOptions* options)
+{
+    if (sumOfProducts == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    shrinquemStatus status = CheckOperands(table, table, table);
+    if (status != STATUS_OKAY)
+        return status;
+
+    triLogic* truthTable = AllocateMemory(table->numWords * CUBE64_MAX_VARIABLES * sizeof(triLogic));
+    if (truthTable == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    status = PackedTableToTriLogic(table, truthTable);
+    if (status == STATUS_OKAY)
+    {
+        sumOfProducts->numVars = table->numVars;
+        status = ReduceLogicWithOptions(truthTable, sumOfProducts, options);
+    }
+
+    FreeMemory(truthTable);
+
+    return status;
+}
+
+static shrinquemStatus CheckOperands(
+    const PackedTruthTable* first,
+    const PackedTruthTable* second,
+    const PackedTruthTable* result)
+{
+    if (first == NULL || second == NULL || result == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (first->values == NULL || first->dontCares == NULL ||
+        second->values == NULL || second->dontCares == NULL ||
+        result->values == NULL || result->dontCares == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (first->numVars != second->numVars || first->numVars != result->numVars)
+        return STATUS_INVALID_ARGUMENT;
+
+    return STATUS_OKAY;
+}
+
+// the bits of the single word of a table under six variables, all of them otherwise
+static cube64 LastWordMask(
+    unsigned long numVars)
+{
+    return CUBE64_ALL_VARS(1UL << ((numVars < WORD_VARS) ? numVars : WORD_VARS));
+}
+
+static void CopyTable(
+    const PackedTruthTable* table,
+    PackedTruthTable* result)
+{
+    if (table == result)
+        return;
+
+    memcpy(result->values, table->values, table->numWords * BYTES_PER_WORD);
+    memcpy(result->dontCares, table->dontCares, table->numWords * BYTES_PER_WORD);
+}
+
+// in place, each word only reads itself or a word with the variable's bit already in place
+static void CofactorWords(
+    cube64 words[],
+    size_t numWords,
+    unsigned long iVar,
+    int value)
+{
+    if (iVar < WORD_VARS)
+    {
+        const cube64 varMask = VAR_MASKS[iVar];
+        const unsigned long shift = 1UL << iVar;
+        for (size_t iWord = 0; iWord < numWords; iWord++)
+        {
+            if (value)
+            {
+                cube64 kept = words[iWord] & varMask;
+                words[iWord] = kept | (kept >> shift);
+            }
+            else
+            {
+                cube64 kept = words[iWord] & ~varMask;
+                words[iWord] = kept | (kept << shift);
+            }
+        }
+    }
+    else
+    {
+        const size_t stride = (size_t)1 << (iVar - WORD_VARS);
+        for (size_t iWord = 0; iWord < numWords; iWord++)
+            words[iWord] = words[value ? (iWord | stride) : (iWord & ~stride)];
+    }
+}
+
+// lowVar is below highVar
+static void SwapWords(
+    cube64 words[],
+    size_t numWords,
+    unsigned long lowVar,
+    unsigned long highVar)
+{
+    if (highVar < WORD_VARS)
+    {
+        // the entries with lowVar set and highVar clear trade places with their partners
+        const cube64 pairMask = VAR_MASKS[lowVar] & ~VAR_MASKS[highVar];
+        const unsigned long shift = (1UL << highVar) - (1UL << lowVar);
+        for (size_t iWord = 0; iWord < numWords; iWord++)
+        {
+            cube64 delta = ((words[iWord] >> shift) ^ words[iWord]) & pairMask;
+            words[iWord] ^= delta ^ (delta << shift);
+        }
+    }
+    else if (lowVar < WORD_VARS)
+    {
+        // the word with highVar clear gives its lowVar set half for the lowVar clear half of its partner
+        const cube64 varMask = VAR_MASKS[lowVar];
+        const unsigned long shift = 1UL << lowVar;
+        const size_t stride = (size_t)1 << (highVar - WORD_VARS);
+        for (size_t iWord = 0; iWord < numWords; iWord++)
+        {
+            if (iWord & stride)
+                continue;
+            cube64 low = words[iWord];
+            cube64 high = words[iWord | stride];
+            words[iWord] = (low & ~varMask) | ((high & ~varMask) << shift);
+            words[iWord | stride] = (high & varMask) | ((low & varMask) >> shift);
+        }
+    }
+    else
+    {
+        const size_t lowStride = (size_t)1 << (lowVar - WORD_VARS);
+        const size_t highStride = (size_t)1 << (highVar - WORD_VARS);
+        for (size_t iWord = 0; iWord < numWords; iWord++)
+        {
+            if ((iWord & lowStride) && !(iWord & highStride))
+            {
+                size_t partner = iWord ^ lowStride ^ highStride;
+                cube64 word = words[iWord];
+                words[iWord] = words[partner];
+                words[partner] = word;
+            }
+        }
+    }
+}
@@ -0,0 +1,215 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for memcpy, memset
+#if defined(_WIN32)
+#include <windows.h> // used for VirtualAlloc, GetLargePageMinimum
+#else
+#include <stdio.h> // used for fopen, fscanf
+#include <sys/mman.h> // used for mmap, madvise
+#if defined(__linux__)
+#include <sys/syscall.h> // used for SYS_mbind
+#include <unistd.h> // used for syscall
+#endif
+#endif
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define HUGE_PAGE_SIZE ((size_t)2 << 20) // on x86-64 and most arm64 kernels
+#define MAX_NUMA_NODES (64) // the nodes past these are left out of the mask, interleaving over 64 spreads the load as well
+#define MPOL_INTERLEAVE_MODE (3) // MPOL_INTERLEAVE of numaif.h, which needs libnuma to be installed
+
+static MemoryPlacement lastPlacement = { 0 };
+
+static cube64 GetNumaNodeMask(void);
+#if !defined(_WIN32)
+static void* MapAnonymousPages(size_t size, pagePolicy pages, pagePolicy* pagesGot);
+#endif
+static int InterleavePages(void* data, size_t size, cube64 nodeMask);
+
+/*************************************************************************
+AllocatePages
+Purpose - allocates a large zeroed work array straight from the system,
+  aligned to and asking for huge pages, as the random probes of the
+  expansion loops go all over the arrays the size of the truth table and
+  take a TLB miss nearly every time on small pages. Explicit huge pages
+  come from the pool the administrator reserved, and when it is empty the
+  transparent ones are asked for instead.
+
+An array that the threads of a parallel run share is interleaved across
+the NUMA nodes, so neither thread reads all of it from the other socket.
+The arrays of one run are left to the first-touch policy: they are filled
+by the thread of the run, so they land on its node. The placement got is
+kept in the region, for RecordMemoryPlacement.
+*************************************************************************/
+
+shrinquemStatus AllocatePages(
+    size_t size,
+    pagePolicy pages,
+    int isShared,
+    ScratchRegion* region)
+{
+    memset(region, 0, sizeof(ScratchRegion));
+
+    pagePolicy pagesGot = PAGES_SMALL;
+    size_t alignedSize = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    void* data = NULL;
+
+#if defined(_WIN32)
+    // large pages need the lock pages privilege, without it the allocation fails and small pages are used
+    SIZE_T largePageSize = GetLargePageMinimum();
+    if (pages == PAGES_EXPLICIT_HUGE && largePageSize != 0)
+    {
+        alignedSize = (size + largePageSize - 1) / largePageSize * largePageSize;
+        data = VirtualAlloc(NULL, alignedSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        pagesGot = PAGES_EXPLICIT_HUGE;
+    }
+    if (data == NULL)
+    {
+        alignedSize = size;
+        data = VirtualAlloc(NULL, alignedSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        pagesGot = PAGES_SMALL;
+    }
+#else
+    data = MapAnonymousPages(alignedSize, pages, &pagesGot);
+#endif
+
+    if (data == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    const cube64 nodeMask = GetNumaNodeMask();
+
+    region->data = data;
+    region->size = alignedSize;
+    region->kind = SCRATCH_PAGES;
+    region->pages = pagesGot;
+    region->isInterleaved = isShared && PopCount64(nodeMask) > 1 && InterleavePages(data, alignedSize, nodeMask);
+
+    return STATUS_OKAY;
+}
+
+void FreePages(
+    ScratchRegion* region)
+{
+#if defined(_WIN32)
+    VirtualFree(region->data, 0, MEM_RELEASE);
+#else
+    munmap(region->data, region->size);
+#endif
+}
+
+// keeps where an array allocated on the calling thread went, the threads of a parallel run don't record theirs
+void RecordMemoryPlacement(
+    const ScratchRegion* region)
+{
+    if (region->kind != SCRATCH_PAGES)
+        return;
+
+    lastPlacement.size = region->size;
+    lastPlacement.pages = region->pages;
+    lastPlacement.numNodes = PopCount64(GetNumaNodeMask());
+    lastPlacement.isInterleaved = region->isInterleaved;
+}
+
+void GetMemoryPlacement(
+    MemoryPlacement* placement)
+{
+    *placement = lastPlacement;
+}
+
+#if !defined(_WIN32)
+static void* MapAnonymousPages(
+    size_t size,
+    pagePolicy pages,
+    pagePolicy* pagesGot)
+{
+    void* data;
+
+#if defined(MAP_HUGETLB)
+    if (pages == PAGES_EXPLICIT_HUGE)
+    {
+        data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (data != MAP_FAILED)
+        {
+            *pagesGot = PAGES_EXPLICIT_HUGE;
+            return data;
+        }
+    }
+#endif
+
+    // one huge page more than needed is mapped so the start can be moved up to a huge page boundary
+    char* mapping = mmap(NULL, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+        return NULL;
+
+    size_t head = (HUGE_PAGE_SIZE - (size_t)mapping % HUGE_PAGE_SIZE) % HUGE_PAGE_SIZE;
+    if (head > 0)
+        munmap(mapping, head);
+    munmap(mapping + head + size, HUGE_PAGE_SIZE - head);
+    data = mapping + head;
+
+    *pagesGot = PAGES_SMALL;
+#if defined(MADV_HUGEPAGE)
+    if (pages != PAGES_SMALL && madvise(data, size, MADV_HUGEPAGE) == 0)
+        *pagesGot = PAGES_TRANSPARENT_HUGE;
+#else
+    (void)pages;
+#endif
+
+    return data;
+}
+#endif
+
+// a bit for each online node below MAX_NUMA_NODES, from the list like 0-1 or 0,2-3 the kernel gives
+static cube64 GetNumaNodeMask(void)
+{
+#if defined(_WIN32)
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode))
+        return 1;
+    return (highestNode + 1 >= MAX_NUMA_NODES) ? ~(cube64)0 : CUBE64_BIT(highestNode + 1) - 1;
+#else
+    cube64 nodeMask = 0;
+    FILE* file = fopen("/sys/devices/system/node/online", "r");
+    if (file == NULL)
+        return 1;
+
+    unsigned long first;
+    unsigned long last;
+    while (fscanf(file, "%lu", &first) == 1)
+    {
+        last = first;
+        int separator = fgetc(file);
+        if (separator == '-' && fscanf(file, "%lu", &last) == 1)
+            separator = fgetc(file);
+
+        for (unsigned long iNode = first; iNode <= last && iNode < MAX_NUMA_NODES; iNode++)
+            nodeMask |= CUBE64_BIT(iNode);
+        if (separator != ',')
+            break;
+    }
+    fclose(file);
+
+    return (nodeMask != 0) ? nodeMask : 1;
+#endif
+}
+
+// spreads the pages round robin over the nodes of the mask, returning nonzero when the kernel took the policy
+static int InterleavePages(
+    void* data,
+    size_t size,
+    cube64 nodeMask)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    unsigned long mask[sizeof(cube64) / sizeof(unsigned long)];
+    memcpy(mask, &nodeMask, sizeof(mask));
+    return syscall(SYS_mbind, data, size, MPOL_INTERLEAVE_MODE, mask, (unsigned long)MAX_NUMA_NODES + 1, 0) == 0;
+#else
+    (void)data;
+    (void)size;
+    (void)nodeMask;
+    return 0;
+#endif
+}
@@ -0,0 +1,427 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <string.h> // used for strlen, strchr
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define NO_VARIABLE (-1)
+#define NO_CHILD    (0) // the root is never a child, so 0 marks a missing one
+
+// the variable names as a trie over the characters they use
+struct EquationParser
+{
+    unsigned long numVars;
+    unsigned long alphabetSize;
+    unsigned char charCodes[256]; // 1 + the position of each character in the alphabet, 0 when no name uses it
+    unsigned long numNodes;
+    uint32_t* children;           // alphabetSize entries per node, NO_CHILD when missing
+    int* nodeVars;                // the variable whose name ends at each node, or NO_VARIABLE
+};
+
+static shrinquemStatus AddName(EquationParser* parser, const char* name, unsigned long iVar);
+static shrinquemStatus ParseLiteral(const EquationParser* parser, const char** position, unsigned long* iVar, int* isComplemented);
+static shrinquemStatus ParseProduct(const EquationParser* parser, const char** position, cube64* care, cube64* value);
+static shrinquemStatus ParseSum(const EquationParser* parser, const char** position, char closing, cube64* care, cube64* value);
+static shrinquemStatus AddLiteral(unsigned long iVar, int isTrue, cube64* care, cube64* value);
+static int IsConstant(const EquationParser* parser, const char* position, char constant);
+static const char* SkipSpaces(const char* position);
+
+/*************************************************************************
+CreateEquationParser
+Purpose - builds a parser for the equations GenerateEquationString makes
+  with the same variable names, NULL giving A, B, C, ... as it does. The
+  names go into a trie whose nodes have a child per character used by any
+  name, so each character of an equation is one table step. It is built
+  once and used for any number of equations.
+
+A name can't be empty, repeated, or hold a space, tab, +, ', ( or ).
+*************************************************************************/
+
+shrinquemStatus CreateEquationParser(
+    unsigned long numVars,
+    const char** const varNames,
+    EquationParser** parser)
+{
+    if (parser == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+    else if (numVars > CUBE64_MAX_VARIABLES)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    char autoNames[CUBE64_MAX_VARIABLES][2];
+    size_t totalLength = 0;
+    shrinquemStatus status = STATUS_OKAY;
+
+    *parser = NULL;
+
+    EquationParser* newParser = AllocateZeroed(1, sizeof(EquationParser));
+    if (newParser == NULL)
+        return STATUS_OUT_OF_MEMORY;
+    newParser->numVars = numVars;
+
+    // the alphabet is the characters of the names, so the tables stay small
+    for (unsigned long iVar = 0; iVar < numVars; iVar++)
+    {
+        autoNames[iVar][0] = 'A' + (char)iVar;
+        autoNames[iVar][1] = 0;
+
+        const char* name = (varNames != NULL) ? varNames[iVar] : autoNames[iVar];
+        if (name == NULL || name[0] == 0 || name[strcspn(name, " \t+'()")] != 0)
+        {
+            status = STATUS_INVALID_ARGUMENT;
+            goto cleanupAndExit;
+        }
+
+        for (const char* c = name; *c != 0; c++)
+        {
+            if (newParser->charCodes[(unsigned char)*c] == 0)
+                newParser->charCodes[(unsigned char)*c] = (unsigned char)++newParser->alphabetSize;
+        }
+        totalLength += strlen(name);
+    }
+
+    newParser->children = AllocateZeroed((totalLength + 1) * newParser->alphabetSize, sizeof(uint32_t));
+    newParser->nodeVars = AllocateMemory((totalLength + 1) * sizeof(int));
+    if (newParser->children == NULL || newParser->nodeVars == NULL)
+    {
+        status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+    newParser->nodeVars[0] = NO_VARIABLE;
+    newParser->numNodes = 1;
+
+    // the first name is the highest variable, as in GenerateEquationString
+    for (unsigned long iVar = 0; iVar < numVars && status == STATUS_OKAY; iVar++)
+    {
+        const char* name = (varNames != NULL) ? varNames[iVar] : autoNames[iVar];
+        status = AddName(newParser, name, numVars - iVar - 1);
+    }
+
+cleanupAndExit:
+
+    if (status != STATUS_OKAY)
+        DestroyEquationParser(newParser);
+    else
+        *parser = newParser;
+
+    return status;
+}
+
+void DestroyEquationParser(
+    EquationParser* parser)
+{
+    if (parser == NULL)
+        return;
+
+    FreeMemory(parser->children);
+    FreeMemory(parser->nodeVars);
+    FreeMemory(parser);
+}
+
+/*************************************************************************
+ParseEquationString
+Purpose - reads an equation of GenerateEquationString back into a
+  sum-of-products with the given polarity, which can't be told from the
+  text alone since a single sum A + B' reads like a sum of two products.
+
+A sum-of-products is products of literals joined by +, and a product-of-
+sums is sums in parentheses written next to each other, a sum of one
+literal having none. A literal is a name with a ' when complemented, and
+the constants 0 and 1 stand for no terms or a term without literals. Where
+two names could match the longest one is taken. Spaces and tabs may be
+added between the literals and around the + and parentheses. The terms are
+counted first, so the arrays are allocated once at their final size and
+the cubes are written straight into them. STATUS_PARSE_ERROR is returned
+for an unknown name or anything else that isn't an equation, including a
+product or sum with both polarities of a variable.
+*************************************************************************/
+
+shrinquemStatus ParseEquationString(
+    const EquationParser* parser,
+    const char* equation,
+    logicPolarity polarity,
+    SumOfProducts* sumOfProducts)
+{
+    if (parser == NULL || equation == NULL || sumOfProducts == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    const int isProductOfSums = (polarity == POLARITY_PRODUCT_OF_SUMS);
+    const cube64 allVars = CUBE64_ALL_VARS(parser->numVars);
+    const char* position = SkipSpaces(equation);
+    shrinquemStatus status = STATUS_OKAY;
+
+    sumOfProducts->numVars = parser->numVars;
+    sumOfProducts->numTerms = 0;
+    sumOfProducts->terms = NULL; // the caller should not have allocated any memory
+    sumOfProducts->dontCares = NULL; // the caller should not have allocated any memory
+    sumOfProducts->equation = NULL;
+    sumOfProducts->polarity = polarity;
+    sumOfProducts->cost = 0.0;
+
+    // every term but the last is followed by a +, or in a product-of-sums opens a ( or is a literal outside them
+    unsigned long maxTerms = 1;
+    unsigned long depth = 0;
+    for (const char* c = position; *c != 0; c++)
+    {
+        if (!isProductOfSums)
+        {
+            if (*c == '+')
+                maxTerms++;
+        }
+        else if (*c == '(')
+        {
+            maxTerms++;
+            depth++;
+        }
+        else if (*c == ')')
+        {
+            if (depth > 0)
+                depth--;
+        }
+        else if (depth == 0 && *c != ' ' && *c != '\t' && *c != '\'' && *c != '+')
+        {
+            maxTerms++; // a name of several characters is counted more than once, which only leaves room
+        }
+    }
+
+    sumOfProducts->terms = AllocateMemory(maxTerms * sizeof(cube64));
+    sumOfProducts->dontCares = AllocateMemory(maxTerms * sizeof(cube64));
+    if (sumOfProducts->terms == NULL || sumOfProducts->dontCares == NULL)
+    {
+        status = STATUS_OUT_OF_MEMORY;
+        goto cleanupAndExit;
+    }
+
+    // a product-of-sums of a single sum has no parentheses, so it is read as one sum
+    const int isSingleSum = isProductOfSums && strchr(position, '(') == NULL && strchr(position, '+') != NULL;
+
+    while (*position != 0 && status == STATUS_OKAY)
+    {
+        cube64 care = 0;
+        cube64 value = 0;
+        int isTerm = 1;
+
+        if (IsConstant(parser, position, isProductOfSums ? '1' : '0'))
+        {
+            isTerm = 0; // a constant that doesn't change the result
+            position = SkipSpaces(position + 1);
+        }
+        else if (IsConstant(parser, position, isProductOfSums ? '0' : '1'))
+        {
+            position = SkipSpaces(position + 1); // a term without literals
+        }
+        else if (!isProductOfSums)
+        {
+            status = ParseProduct(parser, &position, &care, &value);
+        }
+        else if (isSingleSum)
+        {
+            status = ParseSum(parser, &position, 0, &care, &value);
+        }
+        else if (*position == '(')
+        {
+            position = SkipSpaces(position + 1);
+            status = ParseSum(parser, &position, ')', &care, &value);
+            if (status == STATUS_OKAY && *position != ')')
+                status = STATUS_PARSE_ERROR;
+            else if (status == STATUS_OKAY)
+                position = SkipSpaces(position + 1);
+        }
+        else
+        {
+            unsigned long iVar;
+            int isComplemented;
+            status = ParseLiteral(parser, &position, &iVar, &isComplemented);
+            if (status == STATUS_OKAY)
+                status = AddLiteral(iVar, isComplemented, &care, &value);
+        }
+
+        if (status == STATUS_OKAY && isTerm)
+        {
+            sumOfProducts->terms[sumOfProducts->numTerms] = value;
+            sumOfProducts->dontCares[sumOfProducts->numTerms] = ~care & allVars;
+            sumOfProducts->numTerms++;
+        }
+
+        // products are joined by +, sums just follow each other
+        if (status == STATUS_OKAY && !isProductOfSums && *position != 0)
+        {
+            if (*position != '+')
+                status = STATUS_PARSE_ERROR;
+            position = SkipSpaces(position + 1);
+            if (*position == 0)
+                status = STATUS_PARSE_ERROR;
+        }
+    }
+
+    sumOfProducts->cost = (double)sumOfProducts->numTerms;
+
+cleanupAndExit:
+
+    if (status != STATUS_OKAY)
+    {
+        FreeMemory(sumOfProducts->terms);
+        FreeMemory(sumOfProducts->dontCares);
+        sumOfProducts->terms = NULL;
+        sumOfProducts->dontCares = NULL;
+        sumOfProducts->numTerms = 0;
+        sumOfProducts->cost = 0.0;
+    }
+
+    return status;
+}
+
+static shrinquemStatus AddName(
+    EquationParser* parser,
+    const char* name,
+    unsigned long iVar)
+{
+    unsigned long iNode = 0;
+
+    for (const char* c = name; *c != 0; c++)
+    {
+        uint32_t* child = &parser->children[iNode * parser->alphabetSize + parser->charCodes[(unsigned char)*c] - 1];
+        if (*child == NO_CHILD)
+        {
+            parser->nodeVars[parser->numNodes] = NO_VARIABLE;
+            *child = (uint32_t)parser->numNodes++;
+        }
+        iNode = *child;
+    }
+
+    if (parser->nodeVars[iNode] != NO_VARIABLE)
+        return STATUS_INVALID_ARGUMENT; // the same name twice
+
+    parser->nodeVars[iNode] = (int)iVar;
+
+    return STATUS_OKAY;
+}
+
+// reads the longest name at the position and its complement sign, then skips the spaces after them
+static shrinquemStatus ParseLiteral(
+    const EquationParser* parser,
+    const char** position,
+    unsigned long* iVar,
+    int* isComplemented)
+{
+    const char* c = *position;
+    const char* end = NULL;
+    unsigned long iNode = 0;
+
+    while (parser->charCodes[(unsigned char)*c] != 0)
+    {
+        iNode = parser->children[iNode * parser->alphabetSize + parser->charCodes[(unsigned char)*c] - 1];
+        if (iNode == NO_CHILD)
+            break;
+        c++;
+        if (parser->nodeVars[iNode] != NO_VARIABLE)
+        {
+            *iVar = (unsigned long)parser->nodeVars[iNode];
+            end = c;
+        }
+    }
+
+    if (end == NULL)
+        return STATUS_PARSE_ERROR;
+
+    *isComplemented = (*end == '\'');
+    *position = SkipSpaces(end + *isComplemented);
+
+    return STATUS_OKAY;
+}
+
+// reads literals up to a + or the end, as one term of a sum-of-products
+static shrinquemStatus ParseProduct(
+    const EquationParser* parser,
+    const char** position,
+    cube64* care,
+    cube64* value)
+{
+    shrinquemStatus status = STATUS_OKAY;
+
+    do
+    {
+        unsigned long iVar;
+        int isComplemented;
+        status = ParseLiteral(parser, position, &iVar, &isComplemented);
+        if (status == STATUS_OKAY)
+            status = AddLiteral(iVar, !isComplemented, care, value);
+    } while (status == STATUS_OKAY && **position != 0 && **position != '+');
+
+    return status;
+}
+
+// reads literals joined by + up to the closing character, the cube of the complement of the sum
+static shrinquemStatus ParseSum(
+    const EquationParser* parser,
+    const char** position,
+    char closing,
+    cube64* care,
+    cube64* value)
+{
+    shrinquemStatus status = STATUS_OKAY;
+
+    while (status == STATUS_OKAY)
+    {
+        unsigned long iVar;
+        int isComplemented;
+        status = ParseLiteral(parser, position, &iVar, &isComplemented);
+        if (status == STATUS_OKAY)
+            status = AddLiteral(iVar, isComplemented, care, value);
+
+        if (status != STATUS_OKAY || **position == closing)
+            break;
+        if (**position != '+')
+            return STATUS_PARSE_ERROR;
+        *position = SkipSpaces(*position + 1);
+    }
+
+    return status;
+}
+
+static shrinquemStatus AddLiteral(
+    unsigned long iVar,
+    int isTrue,
+    cube64* care,
+    cube64* value)
+{
+    cube64 bitMask = CUBE64_BIT(iVar);
+    cube64 bitValue = isTrue ? bitMask : 0;
+
+    if ((*care & bitMask) && (*value & bitMask) != bitValue)
+        return STATUS_PARSE_ERROR; // both polarities of the variable
+
+    *care |= bitMask;
+    *value |= bitValue;
+
+    return STATUS_OKAY;
+}
+
+// returns nonzero when the position holds the constant as a whole term, not the start of a name
+static int IsConstant(
+    const EquationParser* parser,
+    const char* position,
+    char constant)
+{
+    if (*position != constant)
+        return 0;
+
+    unsigned char code = parser->charCodes[(unsigned char)constant];
+    if (code != 0 && parser->children[code - 1] != NO_CHILD)
+        return 0;
+
+    const char* next = SkipSpaces(position + 1);
+    return *next == 0 || *next == '+' || *next == '(';
+}
+
+static const char* SkipSpaces(
+    const char* position)
+{
+    while (*position == ' ' || *position == '\t')
+        position++;
+    return position;
+}
@@ -0,0 +1,601 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include <stdio.h> // used for fopen, fread, fwrite
+#include <string.h> // used for memchr, memmove, memcpy, memset, strlen, strspn, strcspn, strncmp
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+#define PLA_CHUNK_SIZE ((size_t)1 << 20) // bytes read at a time, a line longer than this grows the buffer
+#define INITIAL_NUM_CUBES (64)
+
+#define INPUT_ONE       (1) // an input of 1
+#define INPUT_DONT_CARE (2) // an input of - or 2
+#define INPUT_OTHER     (4) // anything but an input of 0
+
+// the class of each character as the input of a cube
+static const unsigned char INPUT_CLASSES[256] =
+{
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 2, 4, 4, 0, 1, 2, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, // '-' '0' '1' '2'
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+};
+
+// the state of a PLA being read, kept between the chunks of the file
+typedef struct PlaParser
+{
+    PlaFunction* pla;
+    unsigned long iOutput;
+    unsigned long numOutputs;
+    int hasNumVars;
+    int hasType;
+    int hasOnSet;       // the type has f
+    int hasDontCareSet; // the type has d
+    int hasOffSet;      // the type has r
+    int isDone;         // .e was read
+    unsigned long onCapacity;
+    unsigned long dontCareCapacity;
+    unsigned long offCapacity;
+} PlaParser;
+
+static shrinquemStatus ParseLine(PlaParser* parser, char* line, size_t length);
+static shrinquemStatus ParseDirective(PlaParser* parser, char* line);
+static shrinquemStatus ParseCube(PlaParser* parser, const char* line, size_t length);
+static shrinquemStatus SplitNames(char* text, unsigned long maxNames, char*** names, unsigned long* numNames);
+static shrinquemStatus AppendCube(SumOfProducts* cubes, unsigned long* capacity, cube64 term, cube64 dontCares);
+static void PaintCubes(const SumOfProducts* cubes, triLogic truthTable[], triLogic value);
+
+/*************************************************************************
+ReadPlaFile
+Purpose - reads output iOutput of a PLA file into the cubes of its ON,
+  DON'T CARE and OFF sets, with no truth table. The sets can go to
+  BddFromSumOfProducts for ReduceLogicFromBdd, or to TruthTableFromPla for
+  ReduceLogic when the function is narrow enough.
+
+The file is read in chunks of PLA_CHUNK_SIZE bytes and each line is parsed
+as soon as it is whole, so the file is never held in memory. The .i, .o,
+.ilb, .ob, .type, .p and .e directives are used and the others are skipped.
+Without .type the type is fd, as in espresso. The first input column is the
+highest variable, so the .ilb names are in the order GenerateEquationString
+takes them. An output of 1 or 4 is ON, 0 or 3 is OFF, - or 2 is DON'T CARE
+and ~ is none of them, and each set is only kept when the type has its
+letter. Entries in no cube are OFF when the type has f and not r, ON when
+it has r and not f, and DON'T CARE when it has both.
+*************************************************************************/
+
+shrinquemStatus ReadPlaFile(
+    const char* path,
+    unsigned long iOutput,
+    PlaFunction* pla)
+{
+    if (path == NULL || pla == NULL)
+        return STATUS_NULL_ARGUMENT;
+
+    PlaParser parser = { .pla = pla, .iOutput = iOutput, .numOutputs = 1 };
+    shrinquemStatus status = STATUS_OKAY;
+    size_t capacity = PLA_CHUNK_SIZE;
+    size_t length = 0;
+    char* buffer = NULL;
+
+    memset(pla, 0, sizeof(PlaFunction)); // the caller should not have allocated any memory
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+        return STATUS_FILE_ERROR;
+
+    buffer = AllocateMemory(capacity + 1);
+    if (buffer == NULL)
+    {
+        fclose(file);
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    int isEndOfFile = 0;
+    while (status == STATUS_OKAY && !parser.isDone && !isEndOfFile)
+    {
+        if (length == capacity)
+        {
+            char* newBuffer = ReallocateMemory(buffer, 2 * capacity + 1);
+            if (newBuffer == NULL)
+            {
+                status = STATUS_OUT_OF_MEMORY;
+                break;
+            }
+            buffer = newBuffer;
+            capacity *= 2;
+        }
+
+        size_t numRead = fread(buffer + length, 1, capacity - length, file);
+        length += numRead;
+        if (numRead == 0)
+        {
+            if (ferror(file))
+            {
+                status = STATUS_FILE_ERROR;
+                break;
+            }
+            isEndOfFile = 1;
+        }
+
+        // parse the whole lines, the last one too once the file has ended
+        size_t start = 0;
+        while (status == STATUS_OKAY && !parser.isDone && start < length)
+        {
+            char* newline = memchr(buffer + start, '\n', length - start);
+            if (newline == NULL && !isEndOfFile)
+                break;
+
+            size_t end = (newline != NULL) ? (size_t)(newline - buffer) : length;
+            buffer[end] = 0;
+            status = ParseLine(&parser, buffer + start, end - start);
+            start = end + 1;
+        }
+
+        if (start >= length)
+        {
+            length = 0;
+        }
+        else if (start > 0)
+        {
+            memmove(buffer, buffer + start, length - start);
+            length -= start;
+        }
+    }
+
+    FreeMemory(buffer);
+    fclose(file);
+
+    if (status == STATUS_OKAY && !parser.hasNumVars)
+        status = STATUS_PARSE_ERROR;
+    else if (status == STATUS_OKAY && iOutput >= parser.numOutputs)
+        status = STATUS_INVALID_ARGUMENT;
+
+    if (status != STATUS_OKAY)
+    {
+        FinalizePla(pla);
+        return status;
+    }
+
+    if (!parser.hasType)
+        parser.hasOnSet = parser.hasDontCareSet = 1;
+
+    if (parser.hasOnSet && parser.hasOffSet)
+        pla->unlisted = LOGIC_DONT_CARE;
+    else if (parser.hasOffSet)
+        pla->unlisted = LOGIC_TRUE;
+    else
+        pla->unlisted = LOGIC_FALSE;
+
+    pla->onSet.numVars = pla->dontCareSet.numVars = pla->offSet.numVars = pla->numVars;
+
+    return STATUS_OKAY;
+}
+
+void FinalizePla(
+    PlaFunction* pla)
+{
+    if (pla == NULL)
+        return;
+
+    FinalizeSumOfProducts(&pla->onSet);
+    FinalizeSumOfProducts(&pla->dontCareSet);
+    FinalizeSumOfProducts(&pla->offSet);
+    FreeMemory(pla->varNames); // the names are stored after the pointers
+    FreeMemory(pla->outputName);
+    pla->varNames = NULL;
+    pla->outputName = NULL;
+    pla->numVars = 0;
+}
+
+/*************************************************************************
+TruthTableFromPla
+Purpose - fills a dense truth table from the cubes of a PLA. The entries in
+  no cube get the unlisted value, then the OFF cubes, the ON cubes and the
+  DON'T CARE cubes are written in that order, so an entry in both an ON and
+  a DON'T CARE cube is a DON'T CARE, as in espresso.
+*************************************************************************/
+
+shrinquemStatus TruthTableFromPla(
+    const PlaFunction* pla,
+    triLogic truthTable[])
+{
+    if (pla == NULL || truthTable == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (pla->numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+    else if (pla->numVars >= CUBE64_MAX_VARIABLES)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    memset(truthTable, pla->unlisted, (size_t)CUBE64_BIT(pla->numVars) * sizeof(triLogic));
+    PaintCubes(&pla->offSet, truthTable, LOGIC_FALSE);
+    PaintCubes(&pla->onSet, truthTable, LOGIC_TRUE);
+    PaintCubes(&pla->dontCareSet, truthTable, LOGIC_DONT_CARE);
+
+    return STATUS_OKAY;
+}
+
+/*************************************************************************
+WritePlaFile
+Purpose - writes a cover as a single output PLA file. A sum-of-products is
+  written as type f with its terms as the ON cubes, and a product-of-sums as
+  type r with its terms, the cubes of the complement, as the OFF cubes.
+*************************************************************************/
+
+shrinquemStatus WritePlaFile(
+    const char* path,
+    const SumOfProducts* sumOfProducts,
+    const char** const varNames,
+    const char* outputName)
+{
+    if (path == NULL || sumOfProducts == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (sumOfProducts->numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+    else if (sumOfProducts->numVars > CUBE64_MAX_VARIABLES)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    const unsigned long numVars = sumOfProducts->numVars;
+    const int isProductOfSums = (sumOfProducts->polarity == POLARITY_PRODUCT_OF_SUMS);
+
+    // each row is the inputs, a space, the output and a newline
+    char* row = AllocateMemory(numVars + 4);
+    if (row == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        FreeMemory(row);
+        return STATUS_FILE_ERROR;
+    }
+
+    fprintf(file, ".i %lu\n.o 1\n", numVars);
+    if (varNames != NULL)
+    {
+        fprintf(file, ".ilb");
+        for (unsigned long iVar = 0; iVar < numVars; iVar++)
+            fprintf(file, " %s", varNames[iVar]);
+        fprintf(file, "\n");
+    }
+    if (outputName != NULL)
+        fprintf(file, ".ob %s\n", outputName);
+    fprintf(file, ".type %s\n.p %lu\n", isProductOfSums ? "r" : "f", sumOfProducts->numTerms);
+
+    row[numVars] = ' ';
+    row[numVars + 1] = isProductOfSums ? '0' : '1';
+    row[numVars + 2] = '\n';
+    for (unsigned long iTerm = 0; iTerm < sumOfProducts->numTerms; iTerm++)
+    {
+        for (unsigned long iVar = 0; iVar < numVars; iVar++)
+        {
+            cube64 bitMask = CUBE64_BIT(numVars - iVar - 1);
+            if (sumOfProducts->dontCares[iTerm] & bitMask)
+                row[iVar] = '-';
+            else
+                row[iVar] = (sumOfProducts->terms[iTerm] & bitMask) ? '1' : '0';
+        }
+        fwrite(row, 1, numVars + 3, file);
+    }
+
+    fprintf(file, ".e\n");
+
+    int hasFailed = ferror(file);
+    if (fclose(file) != 0)
+        hasFailed = 1;
+
+    FreeMemory(row);
+
+    return hasFailed ? STATUS_FILE_ERROR : STATUS_OKAY;
+}
+
+// parses one line without its newline, line[length] is 0
+static shrinquemStatus ParseLine(
+    PlaParser* parser,
+    char* line,
+    size_t length)
+{
+    if (length > 0 && line[length - 1] == '\r')
+        line[--length] = 0;
+
+    while (length > 0 && (*line == ' ' || *line == '\t'))
+    {
+        line++;
+        length--;
+    }
+
+    if (length == 0 || *line == '#')
+        return STATUS_OKAY;
+
+    if (*line == '.')
+        return ParseDirective(parser, line + 1);
+
+    return ParseCube(parser, line, length);
+}
+
+static shrinquemStatus ParseDirective(
+    PlaParser* parser,
+    char* line)
+{
+    PlaFunction* pla = parser->pla;
+    size_t keywordLength = strcspn(line, " \t");
+    char* argument = line + keywordLength + strspn(line + keywordLength, " \t");
+
+    if (keywordLength == 1 && line[0] == 'i')
+    {
+        char* end;
+        unsigned long numVars = strtoul(argument, &end, 10);
+        if (end == argument || parser->hasNumVars)
+            return STATUS_PARSE_ERROR;
+        if (numVars < 1)
+            return STATUS_TOO_FEW_VARIABLES;
+        if (numVars > CUBE64_MAX_VARIABLES)
+            return STATUS_TOO_MANY_VARIABLES;
+        pla->numVars = numVars;
+        parser->hasNumVars = 1;
+    }
+    else if (keywordLength == 1 && line[0] == 'o')
+    {
+        char* end;
+        parser->numOutputs = strtoul(argument, &end, 10);
+        if (end == argument || parser->numOutputs < 1)
+            return STATUS_PARSE_ERROR;
+    }
+    else if (keywordLength == 3 && strncmp(line, "ilb", 3) == 0)
+    {
+        unsigned long numNames;
+        if (!parser->hasNumVars || pla->varNames != NULL)
+            return STATUS_PARSE_ERROR;
+        shrinquemStatus status = SplitNames(argument, pla->numVars, &pla->varNames, &numNames);
+        if (status == STATUS_OKAY && numNames != pla->numVars)
+            status = STATUS_PARSE_ERROR;
+        return status;
+    }
+    else if (keywordLength == 2 && strncmp(line, "ob", 2) == 0)
+    {
+        char** names = NULL;
+        unsigned long numNames;
+        shrinquemStatus status = SplitNames(argument, parser->iOutput + 1, &names, &numNames);
+        if (status == STATUS_OKAY && numNames > parser->iOutput && pla->outputName == NULL)
+        {
+            size_t nameLength = strlen(names[parser->iOutput]);
+            pla->outputName = AllocateMemory(nameLength + 1);
+            if (pla->outputName == NULL)
+                status = STATUS_OUT_OF_MEMORY;
+            else
+                memcpy(pla->outputName, names[parser->iOutput], nameLength + 1);
+        }
+        FreeMemory(names);
+        return status;
+    }
+    else if (keywordLength == 4 && strncmp(line, "type", 4) == 0)
+    {
+        size_t typeLength = strcspn(argument, " \t");
+        if (typeLength == 0 || parser->hasType)
+            return STATUS_PARSE_ERROR;
+        for (size_t iChar = 0; iChar < typeLength; iChar++)
+        {
+            if (argument[iChar] == 'f')
+                parser->hasOnSet = 1;
+            else if (argument[iChar] == 'd')
+                parser->hasDontCareSet = 1;
+            else if (argument[iChar] == 'r')
+                parser->hasOffSet = 1;
+            else
+                return STATUS_PARSE_ERROR;
+        }
+        parser->hasType = 1;
+    }
+    else if (keywordLength == 1 && line[0] == 'p')
+    {
+        // the number of cubes, only a hint for how much to allocate
+        unsigned long numCubes = strtoul(argument, NULL, 10);
+        if (numCubes > parser->onCapacity && numCubes < ((unsigned long)1 << 26))
+        {
+            cube64* terms = ReallocateMemory(pla->onSet.terms, numCubes * sizeof(cube64));
+            cube64* dontCares = (terms != NULL) ? ReallocateMemory(pla->onSet.dontCares, numCubes * sizeof(cube64)) : NULL;
+            if (terms != NULL)
+                pla->onSet.terms = terms;
+            if (dontCares != NULL)
+            {
+                pla->onSet.dontCares = dontCares;
+                parser->onCapacity = numCubes;
+            }
+        }
+    }
+    else if ((keywordLength == 1 && line[0] == 'e') || (keywordLength == 3 && strncmp(line, "end", 3) == 0))
+    {
+        parser->isDone = 1;
+    }
+
+    return STATUS_OKAY;
+}
+
+/*************************************************************************
+ParseCube
+Purpose - parses a row of input and output characters. Spaces, tabs and |
+  may separate them anywhere. The input is 0, 1, or - or 2 for a variable
+  that isn't a literal.
+*************************************************************************/
+
+static shrinquemStatus ParseCube(
+    PlaParser* parser,
+    const char* line,
+    size_t length)
+{
+    PlaFunction* pla = parser->pla;
+    const unsigned long numVars = pla->numVars;
+    unsigned long iColumn = 0;
+    cube64 term = 0;
+    cube64 dontCares = 0;
+    char output = 0;
+
+    if (!parser->hasNumVars)
+        return STATUS_PARSE_ERROR;
+    if (parser->iOutput >= parser->numOutputs)
+        return STATUS_INVALID_ARGUMENT;
+
+    if (!parser->hasType)
+    {
+        parser->hasOnSet = parser->hasDontCareSet = 1;
+        parser->hasType = 1;
+    }
+
+    // the usual row starts with all its inputs together, which is parsed by table without branches
+    size_t iChar = 0;
+    if (length >= numVars)
+    {
+        unsigned char classes = 0;
+        for (unsigned long iVar = 0; iVar < numVars; iVar++)
+        {
+            unsigned char inputClass = INPUT_CLASSES[(unsigned char)line[iVar]];
+            term = (term << 1) | (inputClass & INPUT_ONE);
+            dontCares = (dontCares << 1) | ((inputClass & INPUT_DONT_CARE) >> 1);
+            classes |= inputClass;
+        }
+
+        if ((classes & INPUT_OTHER) == 0)
+        {
+            iChar = numVars;
+            iColumn = numVars;
+        }
+        else
+        {
+            term = 0;
+            dontCares = 0;
+        }
+    }
+
+    for (; iChar < length; iChar++)
+    {
+        char c = line[iChar];
+        if (c == ' ' || c == '\t' || c == '|')
+            continue;
+
+        if (iColumn < numVars)
+        {
+            cube64 bitMask = CUBE64_BIT(numVars - iColumn - 1);
+            if (c == '1')
+                term |= bitMask;
+            else if (c == '-' || c == '2')
+                dontCares |= bitMask;
+            else if (c != '0')
+                return STATUS_PARSE_ERROR;
+        }
+        else if (iColumn - numVars == parser->iOutput)
+        {
+            output = c;
+        }
+        iColumn++;
+    }
+
+    if (iColumn != numVars + parser->numOutputs)
+        return STATUS_PARSE_ERROR;
+
+    switch (output)
+    {
+    case '1':
+    case '4':
+        return parser->hasOnSet ? AppendCube(&pla->onSet, &parser->onCapacity, term, dontCares) : STATUS_OKAY;
+    case '0':
+    case '3':
+        return parser->hasOffSet ? AppendCube(&pla->offSet, &parser->offCapacity, term, dontCares) : STATUS_OKAY;
+    case '-':
+    case '2':
+        return parser->hasDontCareSet ? AppendCube(&pla->dontCareSet, &parser->dontCareCapacity, term, dontCares) : STATUS_OKAY;
+    case '~':
+        return STATUS_OKAY;
+    default:
+        return STATUS_PARSE_ERROR;
+    }
+}
+
+// splits text at spaces and tabs into at most maxNames names, stored in one block after the pointers
+static shrinquemStatus SplitNames(
+    char* text,
+    unsigned long maxNames,
+    char*** names,
+    unsigned long* numNames)
+{
+    size_t textLength = strlen(text);
+
+    *names = AllocateMemory(maxNames * sizeof(char*) + textLength + 1);
+    *numNames = 0;
+    if (*names == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    char* copy = (char*)(*names + maxNames);
+    memcpy(copy, text, textLength + 1);
+
+    char* name = copy + strspn(copy, " \t");
+    while (*name != 0)
+    {
+        if (*numNames == maxNames)
+        {
+            (*numNames)++; // one too many
+            break;
+        }
+        (*names)[(*numNames)++] = name;
+
+        name += strcspn(name, " \t");
+        if (*name != 0)
+        {
+            *name++ = 0;
+            name += strspn(name, " \t");
+        }
+    }
+
+    return STATUS_OKAY;
+}
+
+static shrinquemStatus AppendCube(
+    SumOfProducts* cubes,
+    unsigned long* capacity,
+    cube64 term,
+    cube64 dontCares)
+{
+    if (cubes->numTerms == *capacity)
+    {
+        unsigned long newCapacity = (*capacity == 0) ? INITIAL_NUM_CUBES : 2 * *capacity;
+        cube64* terms = ReallocateMemory(cubes->terms, newCapacity * sizeof(cube64));
+        if (terms == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        cubes->terms = terms;
+
+        cube64* newDontCares = ReallocateMemory(cubes->dontCares, newCapacity * sizeof(cube64));
+        if (newDontCares == NULL)
+            return STATUS_OUT_OF_MEMORY;
+        cubes->dontCares = newDontCares;
+        *capacity = newCapacity;
+    }
+
+    cubes->terms[cubes->numTerms] = term;
+    cubes->dontCares[cubes->numTerms] = dontCares;
+    cubes->numTerms++;
+
+    return STATUS_OKAY;
+}
+
+static void PaintCubes(
+    const SumOfProducts* cubes,
+    triLogic truthTable[],
+    triLogic value)
+{
+    for (unsigned long iTerm = 0; iTerm < cubes->numTerms; iTerm++)
+    {
+        cube64 dontCares = cubes->dontCares[iTerm];
+        cube64 term = cubes->terms[iTerm] & ~dontCares;
+        cube64 dcBits = 0;
+        do
+        {
+            truthTable[term | dcBits] = value;
+            dcBits = (dcBits - dontCares) & dontCares;
+        } while (dcBits);
+    }
+}
@@ -0,0 +1,155 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+// the most terms an irredundant cover of 6 variables can have, a checkerboard
+#define SINGLE_WORD_MAX_TERMS (32)
+
+const cube64 VAR_MASKS[SINGLE_WORD_MAX_VARS] =
+{
+    0xAAAAAAAAAAAAAAAAULL,
+    0xCCCCCCCCCCCCCCCCULL,
+    0xF0F0F0F0F0F0F0F0ULL,
+    0xFF00FF00FF00FF00ULL,
+    0xFFFF0000FFFF0000ULL,
+    0xFFFFFFFF00000000ULL,
+};
+
+static cube64 CubeMinterms(unsigned long numVars, cube64 term, cube64 dontCares);
+
+/*************************************************************************
+ReduceLogicSingleWord
+Purpose - same as ReduceLogicCore for functions of up to SINGLE_WORD_MAX_VARS
+  variables, whose whole truth table fits in one 64-bit word.
+
+The ON and OFF entries are packed into one word each, and the set of
+minterms of a cube is built from the VAR_MASKS constants, so expanding a
+term and marking what it covers are a few ANDs instead of loops over the
+table. Irredundancy keeps the OR of the kept terms before each term and of
+all terms after it, which removes exactly the terms RemoveNonprimeImplicants
+removes. Nothing is allocated except the terms and dontCares of the result.
+*************************************************************************/
+
+shrinquemStatus ReduceLogicSingleWord(
+    const triLogic truthTable[],
+    const triLogic onValue,
+    SumOfProducts* sumOfProducts,
+    unsigned long* numKept,
+    unsigned long* numRemoved)
+{
+    const unsigned long numVars = sumOfProducts->numVars;
+    const unsigned long sizeTruthtable = 1UL << numVars;
+    const triLogic offValue = (onValue == LOGIC_TRUE) ? LOGIC_FALSE : LOGIC_TRUE;
+    cube64 onSet = 0;
+    cube64 offSet = 0;
+    cube64 terms[SINGLE_WORD_MAX_TERMS];
+    cube64 dontCares[SINGLE_WORD_MAX_TERMS];
+    cube64 minterms[SINGLE_WORD_MAX_TERMS + 1];
+    cube64 suffixCovers[SINGLE_WORD_MAX_TERMS + 1];
+    unsigned long numTerms = 0;
+
+    sumOfProducts->numTerms = 0;
+    sumOfProducts->terms = NULL; // the caller should not have allocated any memory
+    sumOfProducts->dontCares = NULL; // the caller should not have allocated any memory
+
+    for (unsigned long iInput = 0; iInput < sizeTruthtable; iInput++)
+    {
+        onSet |= (cube64)(truthTable[iInput] == onValue) << iInput;
+        offSet |= (cube64)(truthTable[iInput] == offValue) << iInput;
+    }
+
+    // seed a term from the lowest ON minterm not covered yet and grow it one variable at a time
+    for (cube64 unresolved = onSet; unresolved; numTerms++)
+    {
+        cube64 term = 0;
+        for (cube64 lowest = unresolved & (~unresolved + 1); lowest > 1; lowest >>= 1)
+        {
+            term++;
+        }
+
+        cube64 termDontCares = 0;
+        for (unsigned long iBitTest = 0; iBitTest < numVars; iBitTest++)
+        {
+            cube64 bitMaskTest = CUBE64_BIT(iBitTest);
+            if ((CubeMinterms(numVars, term ^ bitMaskTest, termDontCares) & offSet) == 0)
+            {
+                termDontCares |= bitMaskTest;
+                term &= ~bitMaskTest;
+            }
+        }
+
+        terms[numTerms] = term;
+        dontCares[numTerms] = termDontCares;
+        minterms[numTerms] = CubeMinterms(numVars, term, termDontCares);
+        unresolved &= ~minterms[numTerms];
+    }
+
+    // a term is removed when the kept terms before it and all the terms after it cover every minterm of it
+    suffixCovers[numTerms] = 0;
+    for (unsigned long iTerm = numTerms; iTerm-- > 0;)
+    {
+        suffixCovers[iTerm] = suffixCovers[iTerm + 1] | minterms[iTerm];
+    }
+
+    cube64 prefixCover = 0;
+    unsigned long numNewTerms = 0;
+    for (unsigned long iTerm = 0; iTerm < numTerms; iTerm++)
+    {
+        if (minterms[iTerm] & ~(prefixCover | suffixCovers[iTerm + 1]))
+        {
+            prefixCover |= minterms[iTerm];
+            terms[numNewTerms] = terms[iTerm];
+            dontCares[numNewTerms] = dontCares[iTerm];
+            numNewTerms++;
+        }
+    }
+
+    *numKept += numNewTerms;
+    *numRemoved += numTerms - numNewTerms;
+
+    if (numNewTerms == 0)
+        return STATUS_OKAY;
+
+    sumOfProducts->terms = AllocateMemory(numNewTerms * sizeof(cube64));
+    sumOfProducts->dontCares = AllocateMemory(numNewTerms * sizeof(cube64));
+    if (sumOfProducts->terms == NULL || sumOfProducts->dontCares == NULL)
+    {
+        FreeMemory(sumOfProducts->terms);
+        FreeMemory(sumOfProducts->dontCares);
+        sumOfProducts->terms = NULL;
+        sumOfProducts->dontCares = NULL;
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    for (unsigned long iTerm = 0; iTerm < numNewTerms; iTerm++)
+    {
+        sumOfProducts->terms[iTerm] = terms[iTerm];
+        sumOfProducts->dontCares[iTerm] = dontCares[iTerm];
+    }
+    sumOfProducts->numTerms = numNewTerms;
+
+    return STATUS_OKAY;
+}
+
+// returns the truth table entries the cube covers as a bit mask
+static cube64 CubeMinterms(
+    unsigned long numVars,
+    cube64 term,
+    cube64 dontCares)
+{
+    cube64 minterms = CUBE64_ALL_VARS(1UL << numVars);
+
+    for (unsigned long iVar = 0; iVar < numVars; iVar++)
+    {
+        if (dontCares & CUBE64_BIT(iVar))
+            continue;
+
+        minterms &= (term & CUBE64_BIT(iVar)) ? VAR_MASKS[iVar] : ~VAR_MASKS[iVar];
+    }
+
+    return minterms;
+}
@@ -0,0 +1,226 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include <stdlib.h>
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+static void SweepTernaryTable(unsigned char table[], unsigned long numVars, int markNonPrimes);
+
+/*************************************************************************
+BuildTernaryImplicantTable
+Purpose - returns a table with one entry for every cube of the function,
+  indexed by its ternary encoding, the sum of digit v * 3^v where the digit
+  is 0 or 1 for a literal and 2 for a don't care. Each entry has the
+  TERNARY_IMPLICANT flag when the cube has no entry of the opposite value,
+  and the TERNARY_HAS_ON flag when it has at least one entry equal to
+  onValue. With markNonPrimes, implicants that stay implicants when one of
+  their literals is dropped also get TERNARY_NOT_PRIME. Returns NULL when
+  numVars is over TERNARY_MAX_VARS or the 3^numVars bytes can't be
+  allocated; the table is released with FreeMemory.
+
+The flags of the minterms are set from the truth table, and those of a cube
+with a dash in variable v follow from the two cubes with a 0 and a 1 in v.
+Sweeping the variables in order, every cube is computed after its halves,
+and each sweep combines two contiguous runs of 3^v entries into a third,
+which streams through memory and vectorizes.
+*************************************************************************/
+
+unsigned char* BuildTernaryImplicantTable(
+    const triLogic truthTable[],
+    unsigned long numVars,
+    triLogic onValue,
+    int markNonPrimes)
+{
+    if (numVars > TERNARY_MAX_VARS)
+        return NULL;
+
+    const triLogic offValue = (onValue == LOGIC_TRUE) ? LOGIC_FALSE : LOGIC_TRUE;
+    unsigned char* table = AllocateZeroed(TernaryPower(numVars), sizeof(unsigned char));
+    if (table == NULL)
+        return NULL;
+
+    // counting the minterms in binary moves their ternary index by the same carries in base 3
+    unsigned long ternaryIndex = 0;
+    for (cube64 iInput = 0; iInput < CUBE64_BIT(numVars); iInput++)
+    {
+        unsigned char flags = 0;
+        if (truthTable[iInput] != offValue)
+            flags |= TERNARY_IMPLICANT;
+        if (truthTable[iInput] == onValue)
+            flags |= TERNARY_HAS_ON;
+        table[ternaryIndex] = flags;
+
+        for (unsigned long iVar = 0; iVar < numVars; iVar++)
+        {
+            if (iInput & CUBE64_BIT(iVar))
+            {
+                ternaryIndex -= TernaryPower(iVar);
+            }
+            else
+            {
+                ternaryIndex += TernaryPower(iVar);
+                break;
+            }
+        }
+    }
+
+    SweepTernaryTable(table, numVars, 0);
+    if (markNonPrimes)
+        SweepTernaryTable(table, numVars, 1);
+
+    return table;
+}
+
+/*************************************************************************
+GeneratePrimeImplicants
+Purpose - returns every prime implicant of the function which contains at
+  least one TRUE entry, i.e. the cubes that avoid all FALSE entries and
+  can't be grown further, for functions of up to TERNARY_MAX_VARS
+  variables. The result is used like the one of ReduceLogic, and the
+  implicants are in the order of their ternary index.
+*************************************************************************/
+
+shrinquemStatus GeneratePrimeImplicants(
+    const triLogic truthTable[],
+    SumOfProducts* sumOfProducts)
+{
+    if (truthTable == NULL || sumOfProducts == NULL)
+        return STATUS_NULL_ARGUMENT;
+    else if (sumOfProducts->numVars < 1)
+        return STATUS_TOO_FEW_VARIABLES;
+    else if (sumOfProducts->numVars > TERNARY_MAX_VARS)
+        return STATUS_TOO_MANY_VARIABLES;
+
+    const unsigned long numVars = sumOfProducts->numVars;
+    const unsigned long numCubes = TernaryPower(numVars);
+    sumOfProducts->numTerms = 0;
+    sumOfProducts->polarity = POLARITY_SUM_OF_PRODUCTS;
+    sumOfProducts->terms = NULL; // the caller should not have allocated any memory
+    sumOfProducts->dontCares = NULL; // the caller should not have allocated any memory
+
+    unsigned char* table = BuildTernaryImplicantTable(truthTable, numVars, LOGIC_TRUE, 1);
+    if (table == NULL)
+        return STATUS_OUT_OF_MEMORY;
+
+    const unsigned char primeFlags = TERNARY_IMPLICANT | TERNARY_HAS_ON;
+    const unsigned char testedFlags = TERNARY_IMPLICANT | TERNARY_HAS_ON | TERNARY_NOT_PRIME;
+    unsigned long numPrimes = 0;
+    for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+    {
+        numPrimes += ((table[iCube] & testedFlags) == primeFlags);
+    }
+
+    if (numPrimes > 0)
+    {
+        sumOfProducts->terms = AllocateMemory(numPrimes * sizeof(cube64));
+        sumOfProducts->dontCares = AllocateMemory(numPrimes * sizeof(cube64));
+        if (sumOfProducts->terms == NULL || sumOfProducts->dontCares == NULL)
+        {
+            FreeMemory(sumOfProducts->terms);
+            FreeMemory(sumOfProducts->dontCares);
+            sumOfProducts->terms = NULL;
+            sumOfProducts->dontCares = NULL;
+            FreeMemory(table);
+            return STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    // count through the cubes in base 3, digit 0 and 1 being a literal and 2 a don't care
+    unsigned char digits[TERNARY_MAX_VARS] = { 0 };
+    cube64 term = 0;
+    cube64 dontCares = 0;
+    for (unsigned long iCube = 0; iCube < numCubes; iCube++)
+    {
+        if ((table[iCube] & testedFlags) == primeFlags)
+        {
+            sumOfProducts->terms[sumOfProducts->numTerms] = term;
+            sumOfProducts->dontCares[sumOfProducts->numTerms] = dontCares;
+            sumOfProducts->numTerms++;
+        }
+
+        for (unsigned long iVar = 0; iVar < numVars; iVar++)
+        {
+            cube64 bitMask = CUBE64_BIT(iVar);
+            if (digits[iVar] == 2)
+            {
+                digits[iVar] = 0;
+                dontCares &= ~bitMask;
+                continue;
+            }
+
+            digits[iVar]++;
+            if (digits[iVar] == 1)
+            {
+                term |= bitMask;
+            }
+            else
+            {
+                term &= ~bitMask;
+                dontCares |= bitMask;
+            }
+            break;
+        }
+    }
+
+    FreeMemory(table);
+
+    return STATUS_OKAY;
+}
+
+// returns 3^exponent for exponents up to TERNARY_MAX_VARS
+unsigned long TernaryPower(
+    unsigned long exponent)
+{
+    unsigned long power = 1;
+    for (unsigned long i = 0; i < exponent; i++)
+        power *= 3;
+    return power;
+}
+
+/*************************************************************************
+SweepTernaryTable
+Purpose - the two passes over the table, one variable at a time. For each
+  variable the table splits into blocks of three runs of 3^v entries, the
+  cubes with a 0, a 1 and a dash in that variable.
+
+The first pass makes the dash run the AND of the implicant flags and the OR
+of the has-ON flags of the other two. The second pass flags the cubes in the
+0 and 1 runs as not prime when the dash run next to them is an implicant.
+*************************************************************************/
+
+static void SweepTernaryTable(
+    unsigned char table[],
+    unsigned long numVars,
+    int markNonPrimes)
+{
+    const unsigned long numCubes = TernaryPower(numVars);
+
+    for (unsigned long iVar = 0, run = 1; iVar < numVars; iVar++, run *= 3)
+    {
+        for (unsigned long block = 0; block < numCubes; block += 3 * run)
+        {
+            unsigned char* zeros = &table[block];
+            unsigned char* ones = &table[block + run];
+            unsigned char* dashes = &table[block + 2 * run];
+
+            if (markNonPrimes)
+            {
+                for (unsigned long i = 0; i < run; i++)
+                {
+                    unsigned char notPrime = (unsigned char)((dashes[i] & TERNARY_IMPLICANT) * TERNARY_NOT_PRIME);
+                    zeros[i] |= notPrime;
+                    ones[i] |= notPrime;
+                }
+            }
+            else
+            {
+                for (unsigned long i = 0; i < run; i++)
+                {
+                    dashes[i] = (unsigned char)(((zeros[i] & ones[i]) & TERNARY_IMPLICANT) | ((zeros[i] | ones[i]) & TERNARY_HAS_ON));
+                }
+            }
+        }
+    }
+}
@@ -6,6 +6,7 @@
 #include <stdio.h> // used for printf, ect.
 #include <time.h> // used for time() to seed srand
 #include <math.h> // used for floor
+#include <string.h> // used for strcmp, strstr, memcmp
 #include "shrinquem.h"
 
 #pragma warning( disable : 28159)
@@ -19,6 +20,7 @@ static const char* unitsGetTickCount = "milliseconds";
 #elif defined(__unix__) || defined(__linux__)
 
 #include <errno.h>
+#include <string.h> // used for strerror
 #include <sys/time.h>
 static const char* unitsGetTickCount = "microseconds";
 
@@ -51,11 +53,39 @@ static void TestAllTruthTables(void);
 static void TestAllTruthTablesWithOneFalse(void);
 static void TestAllTruthTablesWithOneTrue(void);
 static void TestSomeRandomTruthTables(void);
+static void TestBddEngine(void);
+static void TestEsop(void);
+static void TestProductOfSums(void);
+static void TestIncrementalReduction(void);
+static void TestWideCubes(void);
+static void TestCubeStore(void);
+static void TestSmallFunctionBatch(void);
+static void TestPrimeImplicants(void);
+static void TestSparseOffSet(void);
+static void TestExpansionOrders(void);
+static void TestOnOnlyIrredundancy(void);
+static void TestCostObjectives(void);
+static void TestFactoredForm(void);
+static void TestCodeGeneration(void);
+static void TestPlaFiles(void);
+static void TestBinaryFiles(void);
+static void TestEquationParsing(void);
+static void TestEquivalenceChecking(void);
+static void TestPackedTables(void);
+static void TestProgressAndCancellation(void);
+static void TestDeadlines(void);
+static void TestCheckpoints(void);
+static void TestOutOfCore(void);
+static void TestMemoryPlacement(void);
+static void TestMemoryAllocator(void);
 
 // Helper functions
 static void TestAllInputs(const SumOfProducts sumOfProducts, const triLogic truthTable[], unsigned long* numRight, unsigned long* numWrong);
+static void TestAllInputsExclusive(const SumOfProducts sumOfProducts, const triLogic truthTable[], unsigned long* numRight, unsigned long* numWrong);
 static long GetRandomLong(long min, long max);
 static void GetRandomBoolArray(unsigned long numElements, char boolArray[]);
+static void GetRandomTriLogicArray(unsigned long numElements, triLogic triLogicArray[]);
+static int CubeHasValue(const triLogic truthTable[], unsigned long numVars, cube64 term, cube64 dontCares, triLogic value);
 
 int main(int argc, char* argv[])
 {
@@ -71,6 +101,31 @@ int main(int argc, char* argv[])
     TestAllTruthTablesWithOneFalse();
     TestAllTruthTablesWithOneTrue();
     TestSomeRandomTruthTables();
+    TestBddEngine();
+    TestEsop();
+    TestProductOfSums();
+    TestIncrementalReduction();
+    TestWideCubes();
+    TestCubeStore();
+    TestSmallFunctionBatch();
+    TestPrimeImplicants();
+    TestSparseOffSet();
+    TestExpansionOrders();
+    TestOnOnlyIrredundancy();
+    TestCostObjectives();
+    TestFactoredForm();
+    TestCodeGeneration();
+    TestPlaFiles();
+    TestBinaryFiles();
+    TestEquationParsing();
+    TestEquivalenceChecking();
+    TestPackedTables();
+    TestProgressAndCancellation();
+    TestDeadlines();
+    TestCheckpoints();
+    TestOutOfCore();
+    TestMemoryPlacement();
+    TestMemoryAllocator();
     return 0;
 }
 
@@ -511,6 +566,3040 @@ static void TestSomeRandomTruthTables(void)
     printf("\n");
 }
 
+static void TestBddEngine(void)
+{
+    const unsigned long numTests = 20;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+    const unsigned long numWideVars = 30;
+    const unsigned long numThresholdVars = 40;
+
+    shrinquemStatus retVal;
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+    unsigned long numTermsBdd = 0;
+    unsigned long numTermsDense = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestBddEngine test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            if (iTest % 2)
+                GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+            else
+                GetRandomBoolArray(numOfPossibleInputs, truthTable);
+
+            SumOfProducts sumOfProducts = { iVars };
+            retVal = ReduceLogicBdd(truthTable, &sumOfProducts);
+            if (retVal == STATUS_OKAY)
+            {
+                TestAllInputs(sumOfProducts, truthTable, &numRight, &numWrong);
+                numTermsBdd += sumOfProducts.numTerms;
+                FinalizeSumOfProducts(&sumOfProducts);
+            }
+            else
+            {
+                numFailures++;
+            }
+
+            SumOfProducts sumOfProductsDense = { iVars };
+            if (ReduceLogic(truthTable, &sumOfProductsDense) == STATUS_OKAY)
+            {
+                numTermsDense += sumOfProductsDense.numTerms;
+                FinalizeSumOfProducts(&sumOfProductsDense);
+            }
+
+            // with no primes allowed to be listed the cyclic core is always covered on the BDDs
+            BddManager* manager = NULL;
+            SumOfProducts sumOfProductsUnlisted = { iVars };
+            BddCoverInfo info;
+            if (CreateBddManager(iVars, &manager) == STATUS_OKAY &&
+                ReduceLogicFromBddBounded(manager, BddFromTruthTable(manager, truthTable, LOGIC_TRUE),
+                    BddFromTruthTable(manager, truthTable, LOGIC_DONT_CARE), 0, &sumOfProductsUnlisted, &info) == STATUS_OKAY)
+            {
+                TestAllInputs(sumOfProductsUnlisted, truthTable, &numRight, &numWrong);
+                if (info.isCoreListed != (info.numCorePrimes == 0.0) || info.numEssential > sumOfProductsUnlisted.numTerms)
+                    numWrong++;
+                FinalizeSumOfProducts(&sumOfProductsUnlisted);
+            }
+            else
+            {
+                numFailures++;
+            }
+
+            DestroyBddManager(manager);
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    // x0 x15 + x1 x16 + ... is exponential in the natural order and linear once the pairs are adjacent
+    BddManager* manager = NULL;
+    if (CreateBddManager(numWideVars, &manager) == STATUS_OKAY)
+    {
+        bddNode f = BDD_FALSE;
+        for (unsigned long iPair = 0; iPair < numWideVars / 2; iPair++)
+        {
+            bddNode pair = BddAnd(manager, BddVariable(manager, iPair), BddVariable(manager, iPair + numWideVars / 2));
+            f = BddOr(manager, f, pair);
+        }
+
+        BddRef(manager, f);
+        BddCollectGarbage(manager);
+        unsigned long numNodesBefore = BddNodeCount(manager);
+        retVal = BddReorder(manager);
+        unsigned long numNodesAfter = BddNodeCount(manager);
+        printf("Sifting %i variables took the BDD from %i to %i nodes...\n", numWideVars, numNodesBefore, numNodesAfter);
+
+        // every pair is an essential prime, so there is no cyclic core left to list
+        SumOfProducts sumOfProducts = { numWideVars };
+        BddCoverInfo info;
+        if (retVal == STATUS_OKAY && ReduceLogicFromBddBounded(manager, f, BDD_FALSE, BDD_DEFAULT_MAX_PRIMES, &sumOfProducts, &info) == STATUS_OKAY)
+        {
+            // BDDs are canonical, so an equivalent cover must give back the very same node
+            if (BddFromSumOfProducts(manager, &sumOfProducts) == f && sumOfProducts.numTerms == numWideVars / 2 && numNodesAfter < numNodesBefore &&
+                info.numEssential == numWideVars / 2 && info.numCorePrimes == 0.0)
+                numRight++;
+            else
+                numWrong++;
+            FinalizeSumOfProducts(&sumOfProducts);
+        }
+        else
+        {
+            numFailures++;
+        }
+
+        DestroyBddManager(manager);
+    }
+    else
+    {
+        numFailures++;
+    }
+
+    // At least half of 40 variables true has a prime for each way to pick the half, C(40, 20) of them, and all of them
+    // contain the all-true input. Covering just that input must pick one of the primes without ever listing them.
+    manager = NULL;
+    if (CreateBddManager(numThresholdVars, &manager) == STATUS_OKAY)
+    {
+        const unsigned long threshold = numThresholdVars / 2;
+        bddNode atLeast[21]; // the inputs with at least each count of variables true, up to the threshold
+        bddNode allTrue = BDD_TRUE;
+
+        atLeast[0] = BDD_TRUE;
+        for (unsigned long iCount = 1; iCount <= threshold; iCount++)
+            atLeast[iCount] = BDD_FALSE;
+
+        for (unsigned long iVar = 0; iVar < numThresholdVars; iVar++)
+        {
+            bddNode x = BddVariable(manager, iVar);
+            for (unsigned long iCount = threshold; iCount > 0; iCount--)
+                atLeast[iCount] = BddOr(manager, atLeast[iCount], BddAnd(manager, x, atLeast[iCount - 1]));
+            allTrue = BddAnd(manager, allTrue, x);
+        }
+
+        double numPrimes = 1.0;
+        for (unsigned long iCount = 0; iCount < threshold; iCount++)
+            numPrimes = numPrimes * (numThresholdVars - iCount) / (iCount + 1);
+
+        bddNode dcSet = BddAnd(manager, atLeast[threshold], BddNot(manager, allTrue));
+        SumOfProducts sumOfProducts = { numThresholdVars };
+        BddCoverInfo info;
+        if (ReduceLogicFromBddBounded(manager, allTrue, dcSet, BDD_DEFAULT_MAX_PRIMES, &sumOfProducts, &info) == STATUS_OKAY)
+        {
+            unsigned long numLiterals = 0;
+            for (unsigned long iVar = 0; iVar < numThresholdVars && sumOfProducts.numTerms == 1; iVar++)
+                numLiterals += !(sumOfProducts.dontCares[0] & CUBE64_BIT(iVar));
+
+            printf("Covering one input of %.0f primes listed %s of them...\n", info.numPrimes, info.isCoreListed ? "all" : "none");
+            if (info.numPrimes == numPrimes && info.numCorePrimes == numPrimes && info.numEssential == 0 && !info.isCoreListed &&
+                sumOfProducts.numTerms == 1 && numLiterals == threshold &&
+                BddAnd(manager, BddFromSumOfProducts(manager, &sumOfProducts), BddNot(manager, atLeast[threshold])) == BDD_FALSE &&
+                EvaluateSumOfProducts(sumOfProducts, CUBE64_ALL_VARS(numThresholdVars)) == LOGIC_TRUE)
+                numRight++;
+            else
+                numWrong++;
+            FinalizeSumOfProducts(&sumOfProducts);
+        }
+        else
+        {
+            numFailures++;
+        }
+
+        DestroyBddManager(manager);
+    }
+    else
+    {
+        numFailures++;
+    }
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\nTerms with BDDs : %i", numTermsBdd);
+    printf("\nTerms dense     : %i", numTermsDense);
+    printf("\n");
+}
+
+static void TestEsop(void)
+{
+    const unsigned long numTests = 20;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+    const unsigned long numParityVars = 12;
+
+    shrinquemStatus retVal;
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestEsop test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            if (iTest % 2)
+                GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+            else
+                GetRandomBoolArray(numOfPossibleInputs, truthTable);
+
+            SumOfProducts sumOfProducts = { iVars };
+            retVal = ReduceLogicEsop(truthTable, &sumOfProducts);
+            if (retVal == STATUS_OKAY)
+            {
+                TestAllInputsExclusive(sumOfProducts, truthTable, &numRight, &numWrong);
+                FinalizeSumOfProducts(&sumOfProducts);
+            }
+            else
+            {
+                numFailures++;
+            }
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    // parity is the worst case for a sum-of-products and takes one cube per variable as an ESOP
+    unsigned long numOfPossibleInputs = 1 << numParityVars;
+    truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+    if (truthTable != NULL)
+    {
+        for (unsigned long iInput = 0; iInput < numOfPossibleInputs; iInput++)
+        {
+            unsigned long parity = 0;
+            for (unsigned long iVar = 0; iVar < numParityVars; iVar++)
+                parity ^= (iInput >> iVar) & 1;
+            truthTable[iInput] = (triLogic)parity;
+        }
+
+        SumOfProducts sumOfProducts = { numParityVars };
+        SumOfProducts sumOfProductsDense = { numParityVars };
+        if (ReduceLogicEsop(truthTable, &sumOfProducts) == STATUS_OKAY && ReduceLogic(truthTable, &sumOfProductsDense) == STATUS_OKAY)
+        {
+            printf("Parity of %i variables takes %i ESOP terms and %i SOP terms...\n", numParityVars, sumOfProducts.numTerms, sumOfProductsDense.numTerms);
+            TestAllInputsExclusive(sumOfProducts, truthTable, &numRight, &numWrong);
+            if (sumOfProducts.numTerms == numParityVars)
+                numRight++;
+            else
+                numWrong++;
+
+            const char* variableNames[] = { "A", "B", "C" };
+            SumOfProducts sumOfProductsSmall = { 3 };
+            if (ReduceLogicEsop(truthTable, &sumOfProductsSmall) == STATUS_OKAY)
+            {
+                GenerateExclusiveEquationString(&sumOfProductsSmall, variableNames);
+                printf("\n%s\n", sumOfProductsSmall.equation);
+                FinalizeSumOfProducts(&sumOfProductsSmall);
+            }
+        }
+        else
+        {
+            numFailures++;
+        }
+
+        FinalizeSumOfProducts(&sumOfProducts);
+        FinalizeSumOfProducts(&sumOfProductsDense);
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestProductOfSums(void)
+{
+    const unsigned long numTests = 20;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+
+    shrinquemStatus retVal;
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestProductOfSums test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            if (iTest % 2)
+                GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+            else
+                GetRandomBoolArray(numOfPossibleInputs, truthTable);
+
+            SumOfProducts sumOfProducts = { iVars };
+            SumOfProducts productOfSums = { iVars };
+            SumOfProducts automatic = { iVars };
+            retVal = ReduceLogic(truthTable, &sumOfProducts);
+            if (retVal == STATUS_OKAY)
+                retVal = ReduceLogicPOS(truthTable, &productOfSums);
+            if (retVal == STATUS_OKAY)
+                retVal = ReduceLogicAuto(truthTable, &automatic);
+
+            if (retVal == STATUS_OKAY)
+            {
+                TestAllInputs(productOfSums, truthTable, &numRight, &numWrong);
+                TestAllInputs(automatic, truthTable, &numRight, &numWrong);
+
+                // the automatic choice must match the cheaper of the two forms
+                unsigned long numTermsExpected = (productOfSums.numTerms < sumOfProducts.numTerms) ? productOfSums.numTerms : sumOfProducts.numTerms;
+                if (automatic.numTerms == numTermsExpected)
+                    numRight++;
+                else
+                    numWrong++;
+            }
+            else
+            {
+                numFailures++;
+            }
+
+            FinalizeSumOfProducts(&sumOfProducts);
+            FinalizeSumOfProducts(&productOfSums);
+            FinalizeSumOfProducts(&automatic);
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    // GitHub example 1 as a product-of-sums
+    const triLogic exampleTable[8] = { 1,1,0,1,1,0,0,0 };
+    SumOfProducts productOfSums = { 3 };
+    if (ReduceLogicPOS(exampleTable, &productOfSums) == STATUS_OKAY &&
+        GenerateEquationString(&productOfSums, NULL) == STATUS_OKAY)
+    {
+        printf("f(A, B, C) = %s\n", productOfSums.equation);
+        TestAllInputs(productOfSums, exampleTable, &numRight, &numWrong);
+    }
+    else
+    {
+        numFailures++;
+    }
+    FinalizeSumOfProducts(&productOfSums);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestIncrementalReduction(void)
+{
+    const unsigned long numTests = 10;
+    const unsigned long numUpdates = 20;
+    const unsigned long maxChanges = 8;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+
+    triLogic* truthTable = NULL;
+    cube64 changedInputs[8];
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+    unsigned long numIncrementalTerms = 0;
+    unsigned long numFullTerms = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestIncrementalReduction test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            IncrementalReduction* reduction = NULL;
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+            if (CreateIncrementalReduction(truthTable, iVars, &reduction) != STATUS_OKAY)
+            {
+                numFailures++;
+                continue;
+            }
+
+            for (unsigned long iUpdate = 0; iUpdate < numUpdates; iUpdate++)
+            {
+                unsigned long numChanged = GetRandomLong(1, maxChanges);
+                for (unsigned long iChange = 0; iChange < numChanged; iChange++)
+                {
+                    changedInputs[iChange] = GetRandomLong(0, numOfPossibleInputs - 1);
+                    truthTable[changedInputs[iChange]] = (triLogic)GetRandomLong(LOGIC_FALSE, LOGIC_DONT_CARE);
+                }
+
+                SumOfProducts sumOfProducts = { iVars };
+                SumOfProducts sumOfProductsFull = { iVars };
+                if (UpdateIncrementalReduction(reduction, truthTable, changedInputs, numChanged) == STATUS_OKAY &&
+                    GetIncrementalSumOfProducts(reduction, &sumOfProducts) == STATUS_OKAY &&
+                    ReduceLogic(truthTable, &sumOfProductsFull) == STATUS_OKAY)
+                {
+                    TestAllInputs(sumOfProducts, truthTable, &numRight, &numWrong);
+                    numIncrementalTerms += sumOfProducts.numTerms;
+                    numFullTerms += sumOfProductsFull.numTerms;
+                }
+                else
+                {
+                    numFailures++;
+                }
+
+                FinalizeSumOfProducts(&sumOfProducts);
+                FinalizeSumOfProducts(&sumOfProductsFull);
+            }
+
+            DestroyIncrementalReduction(reduction);
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    printf("Incremental covers took %i terms against %i for full minimizations...\n", numIncrementalTerms, numFullTerms);
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestWideCubes(void)
+{
+    const unsigned long numTests = 1000;
+    const unsigned long numWideVars = 128;
+    const unsigned long numWiderVars = 200;
+    const unsigned long numXorVars = 120;
+    const unsigned long numWidestVars = 300;
+    const unsigned long maxLiterals = 6;
+
+    BddManager* manager = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestWideCubes test...\n\n");
+
+    // a 64-variable sum-of-products, whose top variables used to overflow the masks: f = x63 x40' + x0
+    cube64 terms[2] = { CUBE64_BIT(63), CUBE64_BIT(0) };
+    cube64 dontCares[2] = { ~(CUBE64_BIT(63) | CUBE64_BIT(40)), ~CUBE64_BIT(0) };
+    SumOfProducts sumOfProducts = { 64, 2, terms, dontCares };
+    const cube64 inputs[4] = { CUBE64_BIT(63), CUBE64_BIT(63) | CUBE64_BIT(40), CUBE64_BIT(40) | CUBE64_BIT(0), CUBE64_BIT(32) };
+    const triLogic expected[4] = { LOGIC_TRUE, LOGIC_FALSE, LOGIC_TRUE, LOGIC_FALSE };
+    for (unsigned long iInput = 0; iInput < 4; iInput++)
+    {
+        if (EvaluateSumOfProducts(sumOfProducts, inputs[iInput]) == expected[iInput])
+            numRight++;
+        else
+            numWrong++;
+    }
+
+    // check the word-parallel containment and intersection against the BDDs of the same cubes
+    if (CreateBddManager(numWideVars, &manager) != STATUS_OKAY)
+    {
+        numFailures++;
+    }
+    else
+    {
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            cube128 cubes[2];
+            bddNode bdds[2];
+
+            for (unsigned long iCube = 0; iCube < 2; iCube++)
+            {
+                cube128* cube = &cubes[iCube];
+                cube->value[0] = cube->value[1] = 0;
+                cube->dontCares[0] = cube->dontCares[1] = ~(cube64)0;
+
+                // draw the literals from a few variables in each word so the cubes often overlap
+                unsigned long numLiterals = GetRandomLong(0, maxLiterals);
+                for (unsigned long iLiteral = 0; iLiteral < numLiterals; iLiteral++)
+                {
+                    unsigned long iVar = GetRandomLong(0, 3) + 64 * GetRandomLong(0, 1) + 60 * GetRandomLong(0, 1);
+                    Cube128SetLiteral(cube, iVar, (int)GetRandomLong(0, 1));
+                }
+
+                bdds[iCube] = BddFromWideCube(manager, cube->value, cube->dontCares);
+                BddRef(manager, bdds[iCube]);
+            }
+
+            bddNode intersection = BddAnd(manager, bdds[0], bdds[1]);
+            bddNode notOuter = BddNot(manager, bdds[0]);
+            bddNode outside = BddAnd(manager, bdds[1], notOuter);
+            if (bdds[0] == BDD_INVALID || bdds[1] == BDD_INVALID || intersection == BDD_INVALID || outside == BDD_INVALID)
+            {
+                numFailures++;
+            }
+            else
+            {
+                if (Cube128Intersects(&cubes[0], &cubes[1]) == (intersection != BDD_FALSE))
+                    numRight++;
+                else
+                    numWrong++;
+
+                if (Cube128Contains(&cubes[0], &cubes[1]) == (outside == BDD_FALSE))
+                    numRight++;
+                else
+                    numWrong++;
+
+                // a minterm of the inner cube lies in the outer one whenever the outer contains the inner
+                cube64 minterm[2] = { cubes[1].value[0] & ~cubes[1].dontCares[0], cubes[1].value[1] & ~cubes[1].dontCares[1] };
+                if (!Cube128Contains(&cubes[0], &cubes[1]) || Cube128ContainsMinterm(&cubes[0], minterm))
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            BddDeref(manager, bdds[0]);
+            BddDeref(manager, bdds[1]);
+        }
+
+        DestroyBddManager(manager);
+    }
+
+    // x0 x1 + x2 x3 + ... over 128 variables, every pair an essential prime
+    manager = NULL;
+    if (CreateBddManager(numWideVars, &manager) == STATUS_OKAY)
+    {
+        bddNode f = BDD_FALSE;
+        for (unsigned long iVar = 0; iVar < numWideVars; iVar += 2)
+            f = BddOr(manager, f, BddAnd(manager, BddVariable(manager, iVar), BddVariable(manager, iVar + 1)));
+
+        WideSumOfProducts wide = { 0 };
+        BddCoverInfo info;
+        if (ReduceLogicWideFromBdd(manager, f, BDD_FALSE, BDD_DEFAULT_MAX_PRIMES, &wide, &info) == STATUS_OKAY)
+        {
+            // BDDs are canonical, so an equivalent cover must give back the very same node
+            const cube128* terms = (const cube128*)wide.terms;
+            if (BddFromWideSumOfProducts(manager, &wide) == f && wide.numWords == 2 && wide.numTerms == numWideVars / 2 &&
+                info.numEssential == numWideVars / 2 && info.numCorePrimes == 0.0 &&
+                Cube128Intersects(&terms[0], &terms[1]) && !Cube128Contains(&terms[0], &terms[1]))
+                numRight++;
+            else
+                numWrong++;
+            FinalizeWideSumOfProducts(&wide);
+        }
+        else
+        {
+            numFailures++;
+        }
+
+        DestroyBddManager(manager);
+    }
+    else
+    {
+        numFailures++;
+    }
+
+    // x0 ^ x1 + x2 ^ x3 + ... over the first 120 of 200 variables, plus the last three not all equal, whose six primes
+    // are a cyclic core with no essential prime
+    manager = NULL;
+    if (CreateBddManager(numWiderVars, &manager) == STATUS_OKAY)
+    {
+        bddNode f = BDD_FALSE;
+        for (unsigned long iVar = 0; iVar < numXorVars; iVar += 2)
+            f = BddOr(manager, f, BddXor(manager, BddVariable(manager, iVar), BddVariable(manager, iVar + 1)));
+
+        bddNode x = BddVariable(manager, numWiderVars - 3);
+        bddNode y = BddVariable(manager, numWiderVars - 2);
+        bddNode z = BddVariable(manager, numWiderVars - 1);
+        f = BddOr(manager, f, BddOr(manager, BddXor(manager, x, y), BddXor(manager, y, z)));
+
+        WideSumOfProducts wide = { 0 };
+        BddCoverInfo info;
+        if (ReduceLogicWideFromBdd(manager, f, BDD_FALSE, BDD_DEFAULT_MAX_PRIMES, &wide, &info) == STATUS_OKAY)
+        {
+            if (BddFromWideSumOfProducts(manager, &wide) == f && wide.numWords == 4 && info.numEssential == numXorVars &&
+                info.numCorePrimes == 6.0 && info.isCoreListed && wide.numTerms <= numXorVars + 4)
+                numRight++;
+            else
+                numWrong++;
+
+            // and the word-parallel evaluation of the cover agrees with the function on random inputs
+            for (unsigned long iTest = 0; iTest < numTests; iTest++)
+            {
+                // every pair equal and the last three equal, then half the time one variable flipped, so the cover is often false
+                cube64 input[4] = { 0 };
+                for (unsigned long iVar = 0; iVar < numWiderVars; iVar++)
+                {
+                    unsigned long iCopied = (iVar < numXorVars) ? iVar - iVar % 2 : (iVar >= numWiderVars - 3) ? numWiderVars - 3 : iVar;
+                    if ((iCopied == iVar) ? GetRandomLong(0, 1) : ((input[iCopied / 64] >> (iCopied % 64)) & 1))
+                        input[iVar / 64] |= CUBE64_BIT(iVar % 64);
+                }
+
+                if (GetRandomLong(0, 1))
+                {
+                    unsigned long iFlipped = GetRandomLong(0, numWiderVars - 1);
+                    input[iFlipped / 64] ^= CUBE64_BIT(iFlipped % 64);
+                }
+
+                // variable i of the input is bit i % 64 of word i / 64
+                triLogic expected = LOGIC_FALSE;
+                for (unsigned long iVar = 0; iVar < numWiderVars - 1; iVar++)
+                {
+                    if ((iVar < numXorVars && iVar % 2 == 0) || iVar >= numWiderVars - 3)
+                    {
+                        if (((input[iVar / 64] >> (iVar % 64)) & 1) != ((input[(iVar + 1) / 64] >> ((iVar + 1) % 64)) & 1))
+                            expected = LOGIC_TRUE;
+                    }
+                }
+
+                if (EvaluateWideSumOfProducts(&wide, input) == expected)
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            FinalizeWideSumOfProducts(&wide);
+        }
+        else
+        {
+            numFailures++;
+        }
+
+        DestroyBddManager(manager);
+    }
+    else
+    {
+        numFailures++;
+    }
+
+    // x0 x1 + ... + x198 x199 over 300 variables, plus the last ten all true with at least five of them true as don't cares.
+    // Listing no primes at all leaves the 252 primes of the don't cares to be covered on the BDDs.
+    manager = NULL;
+    if (CreateBddManager(numWidestVars, &manager) == STATUS_OKAY)
+    {
+        bddNode pairs = BDD_FALSE;
+        for (unsigned long iVar = 0; iVar < numWiderVars; iVar += 2)
+            pairs = BddOr(manager, pairs, BddAnd(manager, BddVariable(manager, iVar), BddVariable(manager, iVar + 1)));
+
+        bddNode atLeast[6] = { BDD_TRUE, BDD_FALSE, BDD_FALSE, BDD_FALSE, BDD_FALSE, BDD_FALSE };
+        bddNode allTrue = BDD_TRUE;
+        for (unsigned long iVar = numWidestVars - 10; iVar < numWidestVars; iVar++)
+        {
+            bddNode x = BddVariable(manager, iVar);
+            for (unsigned long iCount = 5; iCount > 0; iCount--)
+                atLeast[iCount] = BddOr(manager, atLeast[iCount], BddAnd(manager, x, atLeast[iCount - 1]));
+            allTrue = BddAnd(manager, allTrue, x);
+        }
+
+        bddNode onSet = BddOr(manager, pairs, allTrue);
+        bddNode dcSet = BddAnd(manager, atLeast[5], BddNot(manager, onSet));
+        bddNode upperBound = BddOr(manager, onSet, dcSet);
+
+        WideSumOfProducts wide = { 0 };
+        BddCoverInfo info;
+        if (ReduceLogicWideFromBdd(manager, onSet, dcSet, 0, &wide, &info) == STATUS_OKAY)
+        {
+            bddNode cover = BddFromWideSumOfProducts(manager, &wide);
+            cube64 input[8] = { 0 };
+            input[(numWidestVars - 1) / 64] = CUBE64_ALL_VARS((numWidestVars - 1) % 64 + 1) & ~CUBE64_ALL_VARS((numWidestVars - 10) % 64);
+
+            if (BddAnd(manager, onSet, BddNot(manager, cover)) == BDD_FALSE && BddAnd(manager, cover, BddNot(manager, upperBound)) == BDD_FALSE &&
+                wide.numWords == 8 && wide.numTerms == numWiderVars / 2 + 1 && info.numEssential == numWiderVars / 2 &&
+                info.numCorePrimes == 252.0 && !info.isCoreListed && EvaluateWideSumOfProducts(&wide, input) == LOGIC_TRUE)
+                numRight++;
+            else
+                numWrong++;
+            FinalizeWideSumOfProducts(&wide);
+        }
+        else
+        {
+            numFailures++;
+        }
+
+        // past the widest cube there is no cover type to hold the terms
+        WideSumOfProducts tooWide = { 0 };
+        BddManager* tooWideManager = NULL;
+        if (CreateBddManager(WIDE_MAX_VARIABLES + 1, &tooWideManager) == STATUS_OKAY &&
+            ReduceLogicWideFromBdd(tooWideManager, BDD_TRUE, BDD_FALSE, 0, &tooWide, NULL) == STATUS_TOO_MANY_VARIABLES && tooWide.terms == NULL)
+            numRight++;
+        else
+            numWrong++;
+
+        DestroyBddManager(tooWideManager);
+        DestroyBddManager(manager);
+    }
+    else
+    {
+        numFailures++;
+    }
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestCubeStore(void)
+{
+    const unsigned long numTests = 20;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestCubeStore test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+            SumOfProducts sumOfProducts = { iVars };
+            SumOfProducts roundTrip = { iVars };
+            CubeStore store = { 0 };
+            if ((iTest % 2 ? ReduceLogicPOS(truthTable, &sumOfProducts) : ReduceLogic(truthTable, &sumOfProducts)) != STATUS_OKAY ||
+                CubeStoreFromSumOfProducts(&sumOfProducts, &store) != STATUS_OKAY ||
+                SumOfProductsFromCubeStore(&store, &roundTrip) != STATUS_OKAY)
+            {
+                numFailures++;
+                FinalizeSumOfProducts(&sumOfProducts);
+                continue;
+            }
+
+            if (((size_t)store.cares % CUBE_STORE_ALIGNMENT) == 0 && ((size_t)store.values % CUBE_STORE_ALIGNMENT) == 0)
+                numRight++;
+            else
+                numWrong++;
+
+            for (cube64 iInput = 0; iInput < numOfPossibleInputs; iInput++)
+            {
+                if (truthTable[iInput] == LOGIC_DONT_CARE || EvaluateCubeStore(&store, iInput) == truthTable[iInput])
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            TestAllInputs(roundTrip, truthTable, &numRight, &numWrong);
+
+            // every term contains itself, so some containing term must always be found
+            for (unsigned long iTerm = 0; iTerm < sumOfProducts.numTerms; iTerm++)
+            {
+                cube64 care = ~sumOfProducts.dontCares[iTerm] & ((1 << iVars) - 1);
+                unsigned long iFound = CubeStoreFindContaining(&store, sumOfProducts.terms[iTerm], care);
+                if (iFound < sumOfProducts.numTerms && (store.cares[iFound] & care) == store.cares[iFound])
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            FinalizeSumOfProducts(&sumOfProducts);
+            FinalizeSumOfProducts(&roundTrip);
+            FinalizeCubeStore(&store);
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestSmallFunctionBatch(void)
+{
+    const unsigned long numTests = 100000;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 6;
+
+    triLogic truthTable[64];
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestSmallFunctionBatch test...\n\n");
+
+    unsigned long timer = GetTickCountForOS();
+    for (unsigned long iTest = 0; iTest < numTests; iTest++)
+    {
+        SumOfProducts sumOfProducts = { minVar + iTest % (maxVar - minVar + 1) };
+        unsigned long numOfPossibleInputs = 1 << sumOfProducts.numVars;
+        if (iTest % 2)
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+        else
+            GetRandomBoolArray(numOfPossibleInputs, truthTable);
+
+        if (ReduceLogic(truthTable, &sumOfProducts) == STATUS_OKAY)
+        {
+            TestAllInputs(sumOfProducts, truthTable, &numRight, &numWrong);
+            FinalizeSumOfProducts(&sumOfProducts);
+        }
+        else
+        {
+            numFailures++;
+        }
+    }
+    timer = GetTickCountForOS() - timer;
+    printf("%i functions of up to %i variables took %i %s...\n", numTests, maxVar, timer, unitsGetTickCount);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestPrimeImplicants(void)
+{
+    const unsigned long numTests = 10;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 8;
+    const unsigned long numLargeVars = 14;
+    const unsigned long maxBruteForceVars = 6;
+
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestPrimeImplicants test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+            SumOfProducts primes = { iVars };
+            if (GeneratePrimeImplicants(truthTable, &primes) != STATUS_OKAY)
+            {
+                numFailures++;
+                continue;
+            }
+
+            // each one must avoid the FALSE entries, hold a TRUE one, and hit a FALSE entry when any literal is dropped
+            for (unsigned long iTerm = 0; iTerm < primes.numTerms; iTerm++)
+            {
+                int isPrime = !CubeHasValue(truthTable, iVars, primes.terms[iTerm], primes.dontCares[iTerm], LOGIC_FALSE) &&
+                    CubeHasValue(truthTable, iVars, primes.terms[iTerm], primes.dontCares[iTerm], LOGIC_TRUE);
+
+                for (unsigned long iVar = 0; iVar < iVars && isPrime; iVar++)
+                {
+                    cube64 bitMask = (cube64)1 << iVar;
+                    if ((primes.dontCares[iTerm] & bitMask) == 0 &&
+                        !CubeHasValue(truthTable, iVars, primes.terms[iTerm], primes.dontCares[iTerm] | bitMask, LOGIC_FALSE))
+                        isPrime = 0;
+                }
+
+                if (isPrime)
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            // small functions have all their cubes checked to see that no prime is missing
+            if (iVars <= maxBruteForceVars)
+            {
+                unsigned long numPrimes = 0;
+                for (cube64 dontCares = 0; dontCares < numOfPossibleInputs; dontCares++)
+                {
+                    for (cube64 term = 0; term < numOfPossibleInputs; term++)
+                    {
+                        if ((term & dontCares) != 0 ||
+                            CubeHasValue(truthTable, iVars, term, dontCares, LOGIC_FALSE) ||
+                            !CubeHasValue(truthTable, iVars, term, dontCares, LOGIC_TRUE))
+                            continue;
+
+                        unsigned long iVar;
+                        for (iVar = 0; iVar < iVars; iVar++)
+                        {
+                            cube64 bitMask = (cube64)1 << iVar;
+                            if ((dontCares & bitMask) == 0 && !CubeHasValue(truthTable, iVars, term, dontCares | bitMask, LOGIC_FALSE))
+                                break;
+                        }
+
+                        numPrimes += (iVar == iVars);
+                    }
+                }
+
+                if (numPrimes == primes.numTerms)
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            // and together they must cover every TRUE entry, since each one is in some prime
+            for (cube64 iInput = 0; iInput < numOfPossibleInputs; iInput++)
+            {
+                if (truthTable[iInput] != LOGIC_TRUE)
+                    continue;
+
+                if (EvaluateSumOfProducts(primes, iInput) == LOGIC_TRUE)
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            FinalizeSumOfProducts(&primes);
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    // a large function with few FALSE entries, which has a lot of primes
+    unsigned long numOfPossibleInputs = 1 << numLargeVars;
+    truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+    if (truthTable != NULL)
+    {
+        for (unsigned long iInput = 0; iInput < numOfPossibleInputs; iInput++)
+            truthTable[iInput] = (GetRandomLong(0, 99) < 3) ? LOGIC_FALSE : LOGIC_TRUE;
+
+        SumOfProducts primes = { numLargeVars };
+        unsigned long timer = GetTickCountForOS();
+        if (GeneratePrimeImplicants(truthTable, &primes) == STATUS_OKAY)
+        {
+            timer = GetTickCountForOS() - timer;
+            printf("%i prime implicants of %i variables took %i %s...\n", primes.numTerms, numLargeVars, timer, unitsGetTickCount);
+            TestAllInputs(primes, truthTable, &numRight, &numWrong);
+        }
+        else
+        {
+            numFailures++;
+        }
+
+        FinalizeSumOfProducts(&primes);
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestSparseOffSet(void)
+{
+    const unsigned long numTests = 5;
+    const unsigned long minVar = 7;
+    const unsigned long maxVar = 13;
+    const long percentFalse = 2;
+
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestSparseOffSet test...\n\n");
+
+    // few FALSE entries make large cubes, whose checks get answered from the transformed OFF-set
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        unsigned long timer = GetTickCountForOS();
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            for (unsigned long iInput = 0; iInput < numOfPossibleInputs; iInput++)
+            {
+                long random = GetRandomLong(0, 99);
+                truthTable[iInput] = (random < percentFalse) ? LOGIC_FALSE : ((random < 4 * percentFalse) ? LOGIC_DONT_CARE : LOGIC_TRUE);
+            }
+
+            SumOfProducts sumOfProducts = { iVars };
+            if (ReduceLogic(truthTable, &sumOfProducts) != STATUS_OKAY)
+            {
+                numFailures++;
+                continue;
+            }
+
+            TestAllInputs(sumOfProducts, truthTable, &numRight, &numWrong);
+
+            // every term must still hit a FALSE entry when any of its literals is dropped
+            for (unsigned long iTerm = 0; iTerm < sumOfProducts.numTerms; iTerm++)
+            {
+                int isExpanded = 1;
+                for (unsigned long iVar = 0; iVar < iVars && isExpanded; iVar++)
+                {
+                    cube64 bitMask = (cube64)1 << iVar;
+                    if ((sumOfProducts.dontCares[iTerm] & bitMask) == 0 &&
+                        !CubeHasValue(truthTable, iVars, sumOfProducts.terms[iTerm], sumOfProducts.dontCares[iTerm] | bitMask, LOGIC_FALSE))
+                        isExpanded = 0;
+                }
+
+                if (isExpanded)
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            FinalizeSumOfProducts(&sumOfProducts);
+        }
+        timer = GetTickCountForOS() - timer;
+        printf("%i functions of %i variables took %i %s...\n", numTests, iVars, timer, unitsGetTickCount);
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestExpansionOrders(void)
+{
+    const unsigned long numTests = 10;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+    const ReduceLogicOptions orders[4] =
+    {
+        { POLARITY_SUM_OF_PRODUCTS, SEED_ORDER_ASCENDING, EXPAND_ORDER_FIXED },
+        { POLARITY_SUM_OF_PRODUCTS, SEED_ORDER_MOST_CONSTRAINED, EXPAND_ORDER_FIXED },
+        { POLARITY_SUM_OF_PRODUCTS, SEED_ORDER_ASCENDING, EXPAND_ORDER_MOST_UNCOVERED },
+        { POLARITY_SUM_OF_PRODUCTS, SEED_ORDER_MOST_CONSTRAINED, EXPAND_ORDER_MOST_UNCOVERED },
+    };
+    const char* orderNames[4] = { "ascending, fixed", "most constrained, fixed", "ascending, most uncovered", "most constrained, most uncovered" };
+
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+    unsigned long totalTerms[4] = { 0 };
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestExpansionOrders test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+            for (unsigned long iOrder = 0; iOrder < 4; iOrder++)
+            {
+                for (int isProductOfSums = 0; isProductOfSums < 2; isProductOfSums++)
+                {
+                    ReduceLogicOptions options = orders[iOrder];
+                    options.polarity = isProductOfSums ? POLARITY_PRODUCT_OF_SUMS : POLARITY_SUM_OF_PRODUCTS;
+
+                    SumOfProducts sumOfProducts = { iVars };
+                    if (ReduceLogicWithOptions(truthTable, &sumOfProducts, &options) != STATUS_OKAY)
+                    {
+                        numFailures++;
+                        continue;
+                    }
+
+                    TestAllInputs(sumOfProducts, truthTable, &numRight, &numWrong);
+                    if (!isProductOfSums)
+                        totalTerms[iOrder] += sumOfProducts.numTerms;
+
+                    FinalizeSumOfProducts(&sumOfProducts);
+                }
+            }
+
+            // the default orders must give exactly what ReduceLogic gives
+            SumOfProducts defaultOrder = { iVars };
+            SumOfProducts noOptions = { iVars };
+            if (ReduceLogicWithOptions(truthTable, &defaultOrder, NULL) == STATUS_OKAY &&
+                ReduceLogic(truthTable, &noOptions) == STATUS_OKAY)
+            {
+                int isSame = (defaultOrder.numTerms == noOptions.numTerms);
+                for (unsigned long iTerm = 0; iTerm < defaultOrder.numTerms && isSame; iTerm++)
+                {
+                    isSame = (defaultOrder.dontCares[iTerm] == noOptions.dontCares[iTerm]) &&
+                        ((defaultOrder.terms[iTerm] & ~defaultOrder.dontCares[iTerm]) == (noOptions.terms[iTerm] & ~noOptions.dontCares[iTerm]));
+                }
+
+                if (isSame)
+                    numRight++;
+                else
+                    numWrong++;
+            }
+            else
+            {
+                numFailures++;
+            }
+
+            FinalizeSumOfProducts(&defaultOrder);
+            FinalizeSumOfProducts(&noOptions);
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    for (unsigned long iOrder = 0; iOrder < 4; iOrder++)
+        printf("%s: %i terms in total\n", orderNames[iOrder], totalTerms[iOrder]);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestOnOnlyIrredundancy(void)
+{
+    const unsigned long numTests = 20;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+    unsigned long numAllEntriesTerms = 0;
+    unsigned long numOnEntriesTerms = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestOnOnlyIrredundancy test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+            for (int isProductOfSums = 0; isProductOfSums < 2; isProductOfSums++)
+            {
+                const triLogic onValue = isProductOfSums ? LOGIC_FALSE : LOGIC_TRUE;
+                ReduceLogicOptions options = { POLARITY_SUM_OF_PRODUCTS };
+                options.polarity = isProductOfSums ? POLARITY_PRODUCT_OF_SUMS : POLARITY_SUM_OF_PRODUCTS;
+
+                SumOfProducts allEntries = { iVars };
+                SumOfProducts onEntries = { iVars };
+                if (ReduceLogicWithOptions(truthTable, &allEntries, &options) != STATUS_OKAY)
+                    numFailures++;
+
+                options.irredundancy = IRREDUNDANCY_ON_ENTRIES;
+                if (ReduceLogicWithOptions(truthTable, &onEntries, &options) != STATUS_OKAY)
+                    numFailures++;
+
+                TestAllInputs(onEntries, truthTable, &numRight, &numWrong);
+                numAllEntriesTerms += allEntries.numTerms;
+                numOnEntriesTerms += onEntries.numTerms;
+
+                // every term must be the only one to cover some ON entry
+                for (unsigned long iTerm = 0; iTerm < onEntries.numTerms; iTerm++)
+                {
+                    int hasUniqueOn = 0;
+                    for (cube64 iInput = 0; iInput < numOfPossibleInputs && !hasUniqueOn; iInput++)
+                    {
+                        if (truthTable[iInput] != onValue || ((iInput ^ onEntries.terms[iTerm]) & ~onEntries.dontCares[iTerm]) != 0)
+                            continue;
+
+                        unsigned long iOther;
+                        for (iOther = 0; iOther < onEntries.numTerms; iOther++)
+                        {
+                            if (iOther != iTerm && ((iInput ^ onEntries.terms[iOther]) & ~onEntries.dontCares[iOther]) == 0)
+                                break;
+                        }
+
+                        hasUniqueOn = (iOther == onEntries.numTerms);
+                    }
+
+                    if (hasUniqueOn)
+                        numRight++;
+                    else
+                        numWrong++;
+                }
+
+                FinalizeSumOfProducts(&allEntries);
+                FinalizeSumOfProducts(&onEntries);
+            }
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    printf("%i terms kept counting all entries, %i counting only ON entries\n", numAllEntriesTerms, numOnEntriesTerms);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestCostObjectives(void)
+{
+    const unsigned long numTests = 20;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+    double weights[12];
+    double defaultLiterals = 0.0;
+    double objectiveLiterals = 0.0;
+    double defaultWeighted = 0.0;
+    double objectiveWeighted = 0.0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestCostObjectives test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+            for (unsigned long iVar = 0; iVar < iVars; iVar++)
+                weights[iVar] = (double)GetRandomLong(1, 10);
+
+            ReduceLogicOptions literalsOptions = { POLARITY_SUM_OF_PRODUCTS };
+            ReduceLogicOptions weightedOptions = { POLARITY_SUM_OF_PRODUCTS };
+            literalsOptions.objective = OBJECTIVE_LITERALS;
+            weightedOptions.objective = OBJECTIVE_WEIGHTED;
+            weightedOptions.weights = weights;
+
+            SumOfProducts byDefault = { iVars };
+            SumOfProducts byLiterals = { iVars };
+            SumOfProducts byWeights = { iVars };
+            if (ReduceLogic(truthTable, &byDefault) != STATUS_OKAY ||
+                ReduceLogicWithOptions(truthTable, &byLiterals, &literalsOptions) != STATUS_OKAY ||
+                ReduceLogicWithOptions(truthTable, &byWeights, &weightedOptions) != STATUS_OKAY)
+            {
+                numFailures++;
+                FinalizeSumOfProducts(&byDefault);
+                FinalizeSumOfProducts(&byLiterals);
+                FinalizeSumOfProducts(&byWeights);
+                continue;
+            }
+
+            TestAllInputs(byLiterals, truthTable, &numRight, &numWrong);
+            TestAllInputs(byWeights, truthTable, &numRight, &numWrong);
+
+            // the reported costs must match a recount of the terms
+            double literals = 0.0;
+            double weighted = 0.0;
+            double weightedOfDefault = 0.0;
+            double literalsOfDefault = 0.0;
+            for (unsigned long iVar = 0; iVar < iVars; iVar++)
+            {
+                cube64 bitMask = (cube64)1 << iVar;
+                for (unsigned long iTerm = 0; iTerm < byLiterals.numTerms; iTerm++)
+                    literals += (byLiterals.dontCares[iTerm] & bitMask) ? 0.0 : 1.0;
+                for (unsigned long iTerm = 0; iTerm < byWeights.numTerms; iTerm++)
+                    weighted += (byWeights.dontCares[iTerm] & bitMask) ? 0.0 : weights[iVar];
+                for (unsigned long iTerm = 0; iTerm < byDefault.numTerms; iTerm++)
+                {
+                    literalsOfDefault += (byDefault.dontCares[iTerm] & bitMask) ? 0.0 : 1.0;
+                    weightedOfDefault += (byDefault.dontCares[iTerm] & bitMask) ? 0.0 : weights[iVar];
+                }
+            }
+
+            if (byDefault.cost == (double)byDefault.numTerms && byLiterals.cost == literals && byWeights.cost == weighted)
+                numRight++;
+            else
+                numWrong++;
+
+            defaultLiterals += literalsOfDefault;
+            objectiveLiterals += literals;
+            defaultWeighted += weightedOfDefault;
+            objectiveWeighted += weighted;
+
+            FinalizeSumOfProducts(&byDefault);
+            FinalizeSumOfProducts(&byLiterals);
+            FinalizeSumOfProducts(&byWeights);
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    // weights are required for the weighted objective
+    triLogic smallTable[2] = { LOGIC_FALSE, LOGIC_TRUE };
+    ReduceLogicOptions noWeights = { POLARITY_SUM_OF_PRODUCTS };
+    noWeights.objective = OBJECTIVE_WEIGHTED;
+    SumOfProducts sumOfProducts = { 1 };
+    if (ReduceLogicWithOptions(smallTable, &sumOfProducts, &noWeights) == STATUS_NULL_ARGUMENT)
+        numRight++;
+    else
+        numWrong++;
+
+    printf("literals: %.0f by default, %.0f with OBJECTIVE_LITERALS\n", defaultLiterals, objectiveLiterals);
+    printf("weighted cost: %.0f by default, %.0f with OBJECTIVE_WEIGHTED\n", defaultWeighted, objectiveWeighted);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestFactoredForm(void)
+{
+    const unsigned long numTests = 20;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+    unsigned long flatOperations = 0;
+    unsigned long factoredOperations = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestFactoredForm test...\n\n");
+
+    // AB + AC + D shares the literal A
+    {
+        const char* varNames[] = { "A", "B", "C", "D" };
+        cube64 terms[] = { 0xC, 0xA, 0x1 };
+        cube64 dontCares[] = { 0x3, 0x5, 0xE };
+        SumOfProducts sumOfProducts = { 4, 3, terms, dontCares };
+        FactoredForm factored = { 0 };
+        if (FactorSumOfProducts(&sumOfProducts, &factored) != STATUS_OKAY ||
+            GenerateFactoredEquationString(&factored, varNames) != STATUS_OKAY)
+        {
+            numFailures++;
+        }
+        else
+        {
+            printf("AB + AC + D factors to %s\n", factored.equation);
+            if (strcmp(factored.equation, "A(B + C) + D") == 0 && FactoredFormNumOperations(&factored) == 3)
+                numRight++;
+            else
+                numWrong++;
+        }
+        FinalizeFactoredForm(&factored);
+    }
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+            SumOfProducts sumOfProducts = { iVars };
+            FactoredForm factored = { 0 };
+            if ((iTest % 2 ? ReduceLogicPOS(truthTable, &sumOfProducts) : ReduceLogic(truthTable, &sumOfProducts)) != STATUS_OKAY ||
+                FactorSumOfProducts(&sumOfProducts, &factored) != STATUS_OKAY ||
+                GenerateFactoredEquationString(&factored, NULL) != STATUS_OKAY)
+            {
+                numFailures++;
+                FinalizeSumOfProducts(&sumOfProducts);
+                FinalizeFactoredForm(&factored);
+                continue;
+            }
+
+            for (cube64 iInput = 0; iInput < numOfPossibleInputs; iInput++)
+            {
+                if (EvaluateFactoredForm(&factored, iInput) == EvaluateSumOfProducts(sumOfProducts, iInput))
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            // the flat form takes an AND between the literals of a term and an OR between the terms
+            unsigned long numOperations = 0;
+            for (unsigned long iTerm = 0; iTerm < sumOfProducts.numTerms; iTerm++)
+            {
+                unsigned long numLiterals = 0;
+                for (unsigned long iVar = 0; iVar < iVars; iVar++)
+                    numLiterals += (sumOfProducts.dontCares[iTerm] & ((cube64)1 << iVar)) == 0;
+                numOperations += (numLiterals > 1) ? numLiterals - 1 : 0;
+            }
+            numOperations += (sumOfProducts.numTerms > 1) ? sumOfProducts.numTerms - 1 : 0;
+
+            if (FactoredFormNumOperations(&factored) <= numOperations && factored.equation != NULL)
+                numRight++;
+            else
+                numWrong++;
+
+            flatOperations += numOperations;
+            factoredOperations += FactoredFormNumOperations(&factored);
+
+            FinalizeSumOfProducts(&sumOfProducts);
+            FinalizeFactoredForm(&factored);
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    printf("operations: %i flat, %i factored\n", flatOperations, factoredOperations);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestCodeGeneration(void)
+{
+    const unsigned long numTests = 20;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestCodeGeneration test...\n\n");
+
+    // AB + AC' hoists A out of both terms
+    {
+        cube64 terms[] = { 0x6, 0x4 };
+        cube64 dontCares[] = { 0x1, 0x2 };
+        SumOfProducts sumOfProducts = { 3, 2, terms, dontCares };
+        char* source = NULL;
+        if (GenerateCSource(&sumOfProducts, "isSet", CODEGEN_BITSLICED, &source) != STATUS_OKAY)
+        {
+            numFailures++;
+        }
+        else
+        {
+            printf("%s\n", source);
+            if (strstr(source, "const uint64_t common = in[2];") != NULL && strstr(source, "result |= in[1];") != NULL &&
+                strstr(source, "result |= n0;") != NULL)
+                numRight++;
+            else
+                numWrong++;
+        }
+        free(source);
+    }
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+            SumOfProducts sumOfProducts = { iVars };
+            char* scalar = NULL;
+            char* bitsliced = NULL;
+            if ((iTest % 2 ? ReduceLogicPOS(truthTable, &sumOfProducts) : ReduceLogic(truthTable, &sumOfProducts)) != STATUS_OKAY ||
+                GenerateCSource(&sumOfProducts, "scalar", CODEGEN_SCALAR, &scalar) != STATUS_OKAY ||
+                GenerateCSource(&sumOfProducts, "bitsliced", CODEGEN_BITSLICED, &bitsliced) != STATUS_OKAY)
+            {
+                numFailures++;
+                FinalizeSumOfProducts(&sumOfProducts);
+                free(scalar);
+                free(bitsliced);
+                continue;
+            }
+
+            // every term is ored into the result once
+            unsigned long numScalarTerms = 0;
+            unsigned long numBitslicedTerms = 0;
+            for (const char* found = strstr(scalar, "result |="); found != NULL; found = strstr(found + 1, "result |="))
+                numScalarTerms++;
+            for (const char* found = strstr(bitsliced, "result |="); found != NULL; found = strstr(found + 1, "result |="))
+                numBitslicedTerms++;
+
+            if (strstr(scalar, "int scalar(uint64_t x)") != NULL && numScalarTerms == sumOfProducts.numTerms)
+                numRight++;
+            else
+                numWrong++;
+
+            if (strstr(bitsliced, "uint64_t bitsliced(const uint64_t in[") != NULL && numBitslicedTerms == sumOfProducts.numTerms)
+                numRight++;
+            else
+                numWrong++;
+
+            FinalizeSumOfProducts(&sumOfProducts);
+            free(scalar);
+            free(bitsliced);
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    SumOfProducts sumOfProducts = { 1 };
+    char* source = NULL;
+    if (GenerateCSource(&sumOfProducts, NULL, CODEGEN_SCALAR, &source) == STATUS_NULL_ARGUMENT && source == NULL)
+        numRight++;
+    else
+        numWrong++;
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestPlaFiles(void)
+{
+    const unsigned long numTests = 10;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+    const char* path = "shrinquem_test.pla";
+
+    triLogic* truthTable = NULL;
+    triLogic* fromPla = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestPlaFiles test...\n\n");
+
+    // the second output of a two output fd PLA, with names and a row split by |
+    {
+        FILE* file = fopen(path, "wb");
+        if (file == NULL)
+        {
+            numFailures++;
+        }
+        else
+        {
+            fprintf(file, "# a comment\n.i 3\n.o 2\n.ilb x y z\n.ob f g\n.p 4\n1-0 10\n11- 01\r\n0-1 0-\n000|11\n.e\n");
+            fclose(file);
+        }
+
+        PlaFunction pla;
+        triLogic table[8];
+        triLogic expected[8] = { LOGIC_TRUE, LOGIC_DONT_CARE, LOGIC_FALSE, LOGIC_DONT_CARE, LOGIC_FALSE, LOGIC_FALSE, LOGIC_TRUE, LOGIC_TRUE };
+        if (ReadPlaFile(path, 1, &pla) != STATUS_OKAY || TruthTableFromPla(&pla, table) != STATUS_OKAY)
+        {
+            numFailures++;
+        }
+        else
+        {
+            if (memcmp(table, expected, sizeof(expected)) == 0 && pla.onSet.numTerms == 2 && pla.dontCareSet.numTerms == 1 &&
+                pla.offSet.numTerms == 0 && pla.varNames != NULL && strcmp(pla.varNames[0], "x") == 0 &&
+                strcmp(pla.varNames[2], "z") == 0 && pla.outputName != NULL && strcmp(pla.outputName, "g") == 0)
+                numRight++;
+            else
+                numWrong++;
+
+            // the cubes go straight to the BDD engine without the truth table
+            BddManager* manager = NULL;
+            SumOfProducts fromBdd = { 0 };
+            if (CreateBddManager(pla.numVars, &manager) != STATUS_OKAY)
+            {
+                numFailures++;
+            }
+            else
+            {
+                bddNode onSet = BddFromSumOfProducts(manager, &pla.onSet);
+                BddRef(manager, onSet);
+                bddNode dcSet = BddFromSumOfProducts(manager, &pla.dontCareSet);
+                BddRef(manager, dcSet);
+                if (ReduceLogicFromBdd(manager, onSet, dcSet, &fromBdd) != STATUS_OKAY)
+                    numFailures++;
+                else
+                    TestAllInputs(fromBdd, table, &numRight, &numWrong);
+                FinalizeSumOfProducts(&fromBdd);
+                DestroyBddManager(manager);
+            }
+        }
+        FinalizePla(&pla);
+
+        if (ReadPlaFile(path, 2, &pla) == STATUS_INVALID_ARGUMENT && ReadPlaFile("no such file.pla", 0, &pla) == STATUS_FILE_ERROR)
+            numRight++;
+        else
+            numWrong++;
+    }
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        fromPla = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL || fromPla == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+            SumOfProducts sumOfProducts = { iVars };
+            PlaFunction pla;
+            if ((iTest % 2 ? ReduceLogicPOS(truthTable, &sumOfProducts) : ReduceLogic(truthTable, &sumOfProducts)) != STATUS_OKAY ||
+                WritePlaFile(path, &sumOfProducts, NULL, "out") != STATUS_OKAY ||
+                ReadPlaFile(path, 0, &pla) != STATUS_OKAY ||
+                TruthTableFromPla(&pla, fromPla) != STATUS_OKAY)
+            {
+                numFailures++;
+                FinalizeSumOfProducts(&sumOfProducts);
+                continue;
+            }
+
+            // the PLA holds the cover, so every entry must match it
+            for (cube64 iInput = 0; iInput < numOfPossibleInputs; iInput++)
+            {
+                if (fromPla[iInput] == EvaluateSumOfProducts(sumOfProducts, iInput))
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            FinalizeSumOfProducts(&sumOfProducts);
+            FinalizePla(&pla);
+        }
+
+        free(truthTable);
+        free(fromPla);
+        truthTable = NULL;
+        fromPla = NULL;
+    }
+
+    remove(path);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestBinaryFiles(void)
+{
+    const unsigned long numTests = 10;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 14;
+    const char* path = "shrinquem_test.bin";
+
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestBinaryFiles test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL)
+        {
+            numFailures++;
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+            SumOfProducts sumOfProducts = { iVars };
+            MappedSumOfProducts mapped;
+            const int withIndex = (iTest / 2) % 2;
+            if ((iTest % 2 ? ReduceLogicPOS(truthTable, &sumOfProducts) : ReduceLogic(truthTable, &sumOfProducts)) != STATUS_OKAY ||
+                WriteSumOfProductsBinary(path, &sumOfProducts, withIndex) != STATUS_OKAY ||
+                MapSumOfProductsBinary(path, &mapped) != STATUS_OKAY)
+            {
+                numFailures++;
+                FinalizeSumOfProducts(&sumOfProducts);
+                continue;
+            }
+
+            if (mapped.store.numTerms == sumOfProducts.numTerms && mapped.store.polarity == sumOfProducts.polarity &&
+                ((size_t)mapped.store.cares % CUBE_STORE_ALIGNMENT) == 0 && ((size_t)mapped.store.values % CUBE_STORE_ALIGNMENT) == 0 &&
+                (mapped.indexStarts != NULL) == withIndex)
+                numRight++;
+            else
+                numWrong++;
+
+            for (cube64 iInput = 0; iInput < numOfPossibleInputs; iInput++)
+            {
+                if (EvaluateMappedSumOfProducts(&mapped, iInput) == EvaluateSumOfProducts(sumOfProducts, iInput))
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            FinalizeSumOfProducts(&sumOfProducts);
+            UnmapSumOfProductsBinary(&mapped);
+        }
+
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    // a file cut short or with the wrong magic is rejected
+    {
+        MappedSumOfProducts mapped;
+        FILE* file = fopen(path, "wb");
+        if (file == NULL)
+        {
+            numFailures++;
+        }
+        else
+        {
+            fprintf(file, "SHQB");
+            fclose(file);
+            if (MapSumOfProductsBinary(path, &mapped) == STATUS_PARSE_ERROR)
+                numRight++;
+            else
+                numWrong++;
+        }
+
+        file = fopen(path, "wb");
+        if (file == NULL)
+        {
+            numFailures++;
+        }
+        else
+        {
+            for (int iByte = 0; iByte < 256; iByte++)
+                fputc('x', file);
+            fclose(file);
+            if (MapSumOfProductsBinary(path, &mapped) == STATUS_PARSE_ERROR && mapped.mapping == NULL)
+                numRight++;
+            else
+                numWrong++;
+        }
+    }
+
+    remove(path);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestEquationParsing(void)
+{
+    const unsigned long numTests = 20;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+    const char* varNames[] = { "in0", "in1", "in2", "in3", "in4", "in5", "in6", "in7", "in8", "in9", "in10", "in11" };
+
+    triLogic* truthTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+    unsigned long numParsed = 0;
+    unsigned long parseTime = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestEquationParsing test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        EquationParser* autoParser = NULL;
+        EquationParser* namedParser = NULL;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (truthTable == NULL ||
+            CreateEquationParser(iVars, NULL, &autoParser) != STATUS_OKAY ||
+            CreateEquationParser(iVars, varNames, &namedParser) != STATUS_OKAY)
+        {
+            numFailures++;
+            free(truthTable);
+            DestroyEquationParser(autoParser);
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+            // odd tests use the product-of-sums and the tests from 2 on use the names
+            SumOfProducts sumOfProducts = { iVars };
+            SumOfProducts parsed = { 0 };
+            EquationParser* parser = (iTest % 4 < 2) ? autoParser : namedParser;
+            if ((iTest % 2 ? ReduceLogicPOS(truthTable, &sumOfProducts) : ReduceLogic(truthTable, &sumOfProducts)) != STATUS_OKAY ||
+                GenerateEquationString(&sumOfProducts, (parser == autoParser) ? NULL : varNames) != STATUS_OKAY)
+            {
+                numFailures++;
+                FinalizeSumOfProducts(&sumOfProducts);
+                continue;
+            }
+
+            unsigned long timer = GetTickCountForOS();
+            shrinquemStatus status = ParseEquationString(parser, sumOfProducts.equation, sumOfProducts.polarity, &parsed);
+            parseTime += GetTickCountForOS() - timer;
+            numParsed++;
+
+            if (status != STATUS_OKAY)
+            {
+                numFailures++;
+                FinalizeSumOfProducts(&sumOfProducts);
+                continue;
+            }
+
+            // the terms come back exactly, in the same order
+            int isSame = (parsed.numTerms == sumOfProducts.numTerms && parsed.polarity == sumOfProducts.polarity);
+            for (unsigned long iTerm = 0; isSame && iTerm < parsed.numTerms; iTerm++)
+            {
+                isSame = (parsed.dontCares[iTerm] == sumOfProducts.dontCares[iTerm]) &&
+                    (parsed.terms[iTerm] == (sumOfProducts.terms[iTerm] & ~sumOfProducts.dontCares[iTerm]));
+            }
+
+            if (isSame)
+                numRight++;
+            else
+                numWrong++;
+
+            FinalizeSumOfProducts(&sumOfProducts);
+            FinalizeSumOfProducts(&parsed);
+        }
+
+        DestroyEquationParser(autoParser);
+        DestroyEquationParser(namedParser);
+        free(truthTable);
+        truthTable = NULL;
+    }
+
+    // spacing is free, and unknown names or both polarities in a product are errors
+    {
+        EquationParser* parser = NULL;
+        SumOfProducts parsed = { 0 };
+        if (CreateEquationParser(3, NULL, &parser) != STATUS_OKAY)
+        {
+            numFailures++;
+        }
+        else
+        {
+            if (ParseEquationString(parser, "  A'C+B' C'  ", POLARITY_SUM_OF_PRODUCTS, &parsed) == STATUS_OKAY &&
+                parsed.numTerms == 2 && parsed.terms[0] == 0x1 && parsed.dontCares[0] == 0x2 && parsed.terms[1] == 0x0 && parsed.dontCares[1] == 0x4)
+                numRight++;
+            else
+                numWrong++;
+            FinalizeSumOfProducts(&parsed);
+
+            if (ParseEquationString(parser, "(A + B')C", POLARITY_PRODUCT_OF_SUMS, &parsed) == STATUS_OKAY &&
+                parsed.numTerms == 2 && parsed.terms[0] == 0x2 && parsed.dontCares[0] == 0x1 && parsed.terms[1] == 0x0 && parsed.dontCares[1] == 0x6)
+                numRight++;
+            else
+                numWrong++;
+            FinalizeSumOfProducts(&parsed);
+
+            if (ParseEquationString(parser, "AD", POLARITY_SUM_OF_PRODUCTS, &parsed) == STATUS_PARSE_ERROR &&
+                ParseEquationString(parser, "AA'", POLARITY_SUM_OF_PRODUCTS, &parsed) == STATUS_PARSE_ERROR &&
+                ParseEquationString(parser, "A + ", POLARITY_SUM_OF_PRODUCTS, &parsed) == STATUS_PARSE_ERROR &&
+                ParseEquationString(parser, "(A + B", POLARITY_PRODUCT_OF_SUMS, &parsed) == STATUS_PARSE_ERROR)
+                numRight++;
+            else
+                numWrong++;
+        }
+        DestroyEquationParser(parser);
+    }
+
+    printf("Parsed %i equations in %i %s\n", numParsed, parseTime, unitsGetTickCount);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestEquivalenceChecking(void)
+{
+    const unsigned long numTests = 20;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 12;
+    const unsigned long wideVars = 40;
+
+    triLogic* truthTable = NULL;
+    char* boolTable = NULL;
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+    unsigned long numChecks = 0;
+    unsigned long checkTime = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestEquivalenceChecking test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        unsigned long numOfPossibleInputs = 1 << iVars;
+        truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+        boolTable = malloc(numOfPossibleInputs * sizeof(char));
+        if (truthTable == NULL || boolTable == NULL)
+        {
+            numFailures++;
+            free(truthTable);
+            free(boolTable);
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            // without don't cares every cover of the table is the same function
+            GetRandomBoolArray(numOfPossibleInputs, boolTable);
+            for (unsigned long iInput = 0; iInput < numOfPossibleInputs; iInput++)
+                truthTable[iInput] = boolTable[iInput] ? LOGIC_TRUE : LOGIC_FALSE;
+
+            SumOfProducts sumOfProducts = { iVars };
+            SumOfProducts productOfSums = { iVars };
+            SumOfProducts split = { 0 };
+            if (ReduceLogic(truthTable, &sumOfProducts) != STATUS_OKAY ||
+                ReduceLogicPOS(truthTable, &productOfSums) != STATUS_OKAY)
+            {
+                numFailures++;
+                FinalizeSumOfProducts(&sumOfProducts);
+                FinalizeSumOfProducts(&productOfSums);
+                continue;
+            }
+
+            // the covers are irredundant, so one less term is another function
+            SumOfProducts dropped = sumOfProducts;
+            dropped.numTerms = (sumOfProducts.numTerms > 0) ? sumOfProducts.numTerms - 1 : 0;
+            const int isDroppedSame = (sumOfProducts.numTerms == 0);
+
+            // narrow covers compare as tables, widened ones as cubes
+            for (int isWide = 0; isWide <= 1; isWide++)
+            {
+                if (isWide)
+                {
+                    cube64 extraVars = CUBE64_ALL_VARS(wideVars) & ~CUBE64_ALL_VARS(iVars);
+                    sumOfProducts.numVars = productOfSums.numVars = dropped.numVars = wideVars;
+                    for (unsigned long iTerm = 0; iTerm < sumOfProducts.numTerms; iTerm++)
+                        sumOfProducts.dontCares[iTerm] |= extraVars;
+                    for (unsigned long iTerm = 0; iTerm < productOfSums.numTerms; iTerm++)
+                        productOfSums.dontCares[iTerm] |= extraVars;
+
+                    // splitting a term on a variable it doesn't have keeps the function
+                    split = sumOfProducts;
+                    split.terms = malloc((sumOfProducts.numTerms + 1) * sizeof(cube64));
+                    split.dontCares = malloc((sumOfProducts.numTerms + 1) * sizeof(cube64));
+                    split.equation = NULL;
+                    if (split.terms == NULL || split.dontCares == NULL)
+                    {
+                        numFailures++;
+                        break;
+                    }
+                    for (unsigned long iTerm = 0; iTerm < sumOfProducts.numTerms; iTerm++)
+                    {
+                        split.terms[iTerm] = sumOfProducts.terms[iTerm] & ~sumOfProducts.dontCares[iTerm];
+                        split.dontCares[iTerm] = sumOfProducts.dontCares[iTerm];
+                    }
+                    if (sumOfProducts.numTerms > 0)
+                    {
+                        cube64 splitVar = CUBE64_BIT(wideVars - 1);
+                        split.dontCares[0] &= ~splitVar;
+                        split.terms[split.numTerms] = split.terms[0] | splitVar;
+                        split.dontCares[split.numTerms] = split.dontCares[0];
+                        split.numTerms++;
+                    }
+                }
+
+                int isSumSame = 0;
+                int isDroppedSumSame = 1;
+                int isDroppedProductSame = 1;
+                int isSplitSame = 1;
+                unsigned long timer = GetTickCountForOS();
+                shrinquemStatus status = AreSumOfProductsEquivalent(&sumOfProducts, &productOfSums, &isSumSame);
+                if (status == STATUS_OKAY)
+                    status = AreSumOfProductsEquivalent(&sumOfProducts, &dropped, &isDroppedSumSame);
+                if (status == STATUS_OKAY)
+                    status = AreSumOfProductsEquivalent(&productOfSums, &dropped, &isDroppedProductSame);
+                if (status == STATUS_OKAY && isWide)
+                    status = AreSumOfProductsEquivalent(&split, &productOfSums, &isSplitSame);
+                checkTime += GetTickCountForOS() - timer;
+                numChecks += isWide ? 4 : 3;
+
+                if (status != STATUS_OKAY)
+                    numFailures++;
+                else if (isSumSame && isSplitSame && !isDroppedSumSame == !isDroppedSame && !isDroppedProductSame == !isDroppedSame)
+                    numRight++;
+                else
+                    numWrong++;
+            }
+
+            free(split.terms);
+            free(split.dontCares);
+            FinalizeSumOfProducts(&sumOfProducts);
+            FinalizeSumOfProducts(&productOfSums);
+        }
+
+        free(truthTable);
+        free(boolTable);
+        truthTable = NULL;
+        boolTable = NULL;
+    }
+
+    // covers of different widths can't be compared
+    {
+        cube64 term = 0x1;
+        cube64 dontCares = 0x0;
+        SumOfProducts narrow = { 1, 1, &term, &dontCares, NULL, POLARITY_SUM_OF_PRODUCTS };
+        SumOfProducts wide = { 2, 1, &term, &dontCares, NULL, POLARITY_SUM_OF_PRODUCTS };
+        int isEquivalent = 1;
+        if (AreSumOfProductsEquivalent(&narrow, &wide, &isEquivalent) == STATUS_INVALID_ARGUMENT)
+            numRight++;
+        else
+            numWrong++;
+    }
+
+    printf("Performed %i equivalence checks in %i %s\n", numChecks, checkTime, unitsGetTickCount);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestPackedTables(void)
+{
+    const unsigned long numTests = 10;
+    const unsigned long minVar = 1;
+    const unsigned long maxVar = 14;
+    const unsigned long timedVars = 24;
+
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestPackedTables test...\n\n");
+
+    for (unsigned long iVars = minVar; iVars <= maxVar; iVars++)
+    {
+        const size_t numOfPossibleInputs = (size_t)1 << iVars;
+        PackedTruthTable function = { 0 };
+        PackedTruthTable scratch = { 0 };
+        triLogic* reference = malloc(numOfPossibleInputs * sizeof(triLogic));
+        triLogic* expected = malloc(numOfPossibleInputs * sizeof(triLogic));
+        triLogic* actual = malloc(numOfPossibleInputs * sizeof(triLogic));
+        if (reference == NULL || expected == NULL || actual == NULL ||
+            AllocatePackedTruthTable(iVars, &function) != STATUS_OKAY ||
+            AllocatePackedTruthTable(iVars, &scratch) != STATUS_OKAY)
+        {
+            numFailures++;
+            free(reference);
+            free(expected);
+            free(actual);
+            FinalizePackedTruthTable(&function);
+            break;
+        }
+
+        for (unsigned long iTest = 0; iTest < numTests; iTest++)
+        {
+            // ((a b) XOR c') + d, with the entries where e f are set made don't cares
+            unsigned long vars[6];
+            for (unsigned long iPick = 0; iPick < 6; iPick++)
+                vars[iPick] = (unsigned long)GetRandomLong(0, (long)iVars - 1);
+
+            shrinquemStatus status = PackedTableVariable(vars[0], &function);
+            if (status == STATUS_OKAY)
+                status = PackedTableVariable(vars[1], &scratch);
+            if (status == STATUS_OKAY)
+                status = PackedTableAnd(&function, &scratch, &function);
+            if (status == STATUS_OKAY)
+                status = PackedTableVariable(vars[2], &scratch);
+            if (status == STATUS_OKAY)
+                status = PackedTableNot(&scratch, &scratch);
+            if (status == STATUS_OKAY)
+                status = PackedTableXor(&function, &scratch, &function);
+            if (status == STATUS_OKAY)
+                status = PackedTableVariable(vars[3], &scratch);
+            if (status == STATUS_OKAY)
+                status = PackedTableOr(&function, &scratch, &function);
+            if (status == STATUS_OKAY)
+                status = PackedTableVariable(vars[4], &scratch);
+            if (status == STATUS_OKAY)
+            {
+                PackedTruthTable other = { 0 };
+                status = AllocatePackedTruthTable(iVars, &other);
+                if (status == STATUS_OKAY)
+                    status = PackedTableVariable(vars[5], &other);
+                if (status == STATUS_OKAY)
+                    status = PackedTableAnd(&scratch, &other, &scratch);
+                if (status == STATUS_OKAY)
+                    status = PackedTableMaskDontCares(&function, &scratch, &function);
+                FinalizePackedTruthTable(&other);
+            }
+            if (status != STATUS_OKAY)
+            {
+                numFailures++;
+                continue;
+            }
+
+            for (size_t iInput = 0; iInput < numOfPossibleInputs; iInput++)
+            {
+                int bits[6];
+                for (unsigned long iPick = 0; iPick < 6; iPick++)
+                    bits[iPick] = (iInput >> vars[iPick]) & 1;
+                if (bits[4] && bits[5])
+                    reference[iInput] = LOGIC_DONT_CARE;
+                else
+                    reference[iInput] = (((bits[0] && bits[1]) != !bits[2]) || bits[3]) ? LOGIC_TRUE : LOGIC_FALSE;
+            }
+
+            // the table itself, and back through the triLogic form
+            if (PackedTableToTriLogic(&function, actual) == STATUS_OKAY &&
+                memcmp(actual, reference, numOfPossibleInputs) == 0 &&
+                PackedTableFromTriLogic(reference, &scratch) == STATUS_OKAY &&
+                memcmp(scratch.dontCares, function.dontCares, function.numWords * sizeof(cube64)) == 0 &&
+                PackedTableToTriLogic(&scratch, expected) == STATUS_OKAY &&
+                memcmp(expected, reference, numOfPossibleInputs) == 0)
+                numRight++;
+            else
+                numWrong++;
+
+            // a cofactor on a random variable
+            unsigned long iVar = (unsigned long)GetRandomLong(0, (long)iVars - 1);
+            int value = (int)GetRandomLong(0, 1);
+            for (size_t iInput = 0; iInput < numOfPossibleInputs; iInput++)
+                expected[iInput] = reference[value ? (iInput | ((size_t)1 << iVar)) : (iInput & ~((size_t)1 << iVar))];
+            if (PackedTableCofactor(&function, iVar, value, &scratch) == STATUS_OKAY &&
+                PackedTableToTriLogic(&scratch, actual) == STATUS_OKAY &&
+                memcmp(actual, expected, numOfPossibleInputs) == 0)
+                numRight++;
+            else
+                numWrong++;
+
+            // a swap of two random variables
+            unsigned long jVar = (unsigned long)GetRandomLong(0, (long)iVars - 1);
+            for (size_t iInput = 0; iInput < numOfPossibleInputs; iInput++)
+            {
+                size_t swapped = iInput & ~(((size_t)1 << iVar) | ((size_t)1 << jVar));
+                swapped |= ((iInput >> iVar) & 1) << jVar;
+                swapped |= ((iInput >> jVar) & 1) << iVar;
+                expected[iInput] = reference[swapped];
+            }
+            if (PackedTableSwapVariables(&function, iVar, jVar, &scratch) == STATUS_OKAY &&
+                PackedTableToTriLogic(&scratch, actual) == STATUS_OKAY &&
+                memcmp(actual, expected, numOfPossibleInputs) == 0)
+                numRight++;
+            else
+                numWrong++;
+
+            // a random permutation, variable v of the table becomes variable permutation[v]
+            unsigned long permutation[CUBE64_MAX_VARIABLES];
+            for (unsigned long iPerm = 0; iPerm < iVars; iPerm++)
+                permutation[iPerm] = iPerm;
+            for (unsigned long iPerm = iVars - 1; iPerm > 0; iPerm--)
+            {
+                unsigned long iOther = (unsigned long)GetRandomLong(0, (long)iPerm);
+                unsigned long temp = permutation[iPerm];
+                permutation[iPerm] = permutation[iOther];
+                permutation[iOther] = temp;
+            }
+            for (size_t iInput = 0; iInput < numOfPossibleInputs; iInput++)
+            {
+                size_t source = 0;
+                for (unsigned long iPerm = 0; iPerm < iVars; iPerm++)
+                    source |= ((iInput >> permutation[iPerm]) & 1) << iPerm;
+                expected[iInput] = reference[source];
+            }
+            if (PackedTablePermute(&function, permutation, &scratch) == STATUS_OKAY &&
+                PackedTableToTriLogic(&scratch, actual) == STATUS_OKAY &&
+                memcmp(actual, expected, numOfPossibleInputs) == 0)
+                numRight++;
+            else
+                numWrong++;
+
+            // the minimizer gives the same cover as from the triLogic table
+            SumOfProducts packedResult = { 0 };
+            SumOfProducts tableResult = { iVars };
+            if (ReduceLogicPacked(&function, &packedResult, NULL) != STATUS_OKAY ||
+                ReduceLogic(reference, &tableResult) != STATUS_OKAY)
+            {
+                numFailures++;
+            }
+            else
+            {
+                int isSame = (packedResult.numTerms == tableResult.numTerms);
+                for (unsigned long iTerm = 0; isSame && iTerm < packedResult.numTerms; iTerm++)
+                    isSame = packedResult.terms[iTerm] == tableResult.terms[iTerm] && packedResult.dontCares[iTerm] == tableResult.dontCares[iTerm];
+                if (isSame)
+                    numRight++;
+                else
+                    numWrong++;
+            }
+            FinalizeSumOfProducts(&packedResult);
+            FinalizeSumOfProducts(&tableResult);
+        }
+
+        free(reference);
+        free(expected);
+        free(actual);
+        FinalizePackedTruthTable(&function);
+        FinalizePackedTruthTable(&scratch);
+    }
+
+    // building a wide table takes a pass over its words per operation
+    {
+        PackedTruthTable function = { 0 };
+        PackedTruthTable scratch = { 0 };
+        triLogic* truthTable = malloc(((size_t)1 << timedVars) * sizeof(triLogic));
+        unsigned long timer = GetTickCountForOS();
+        shrinquemStatus status = (truthTable == NULL) ? STATUS_OUT_OF_MEMORY : AllocatePackedTruthTable(timedVars, &function);
+        if (status == STATUS_OKAY)
+            status = AllocatePackedTruthTable(timedVars, &scratch);
+        for (unsigned long iVar = 0; iVar + 1 < timedVars && status == STATUS_OKAY; iVar += 2)
+        {
+            status = PackedTableVariable(iVar, &scratch);
+            if (status == STATUS_OKAY)
+                status = PackedTableXor(&function, &scratch, &function);
+            if (status == STATUS_OKAY)
+                status = PackedTableVariable(iVar + 1, &scratch);
+            if (status == STATUS_OKAY)
+                status = PackedTableOr(&function, &scratch, &function);
+        }
+        if (status == STATUS_OKAY)
+            status = PackedTableToTriLogic(&function, truthTable);
+        timer = GetTickCountForOS() - timer;
+
+        if (status == STATUS_OKAY)
+            printf("Built and unpacked a %i variable table in %i %s\n", timedVars, timer, unitsGetTickCount);
+        else
+            numFailures++;
+
+        free(truthTable);
+        FinalizePackedTruthTable(&function);
+        FinalizePackedTruthTable(&scratch);
+    }
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+// counts the reports and cancels once a number of them were made, when a limit is given
+typedef struct ProgressRecord
+{
+    unsigned long numReports;
+    unsigned long numOutOfOrder;
+    unsigned long numExpanding;
+    unsigned long numIrredundant;
+    unsigned long cancelAfter; // 0 never cancels
+    progressPhase lastPhase;
+    cube64 lastProcessed;
+    int cancel;
+} ProgressRecord;
+
+static void RecordProgress(
+    const ReduceLogicProgress* progress,
+    void* context)
+{
+    ProgressRecord* record = (ProgressRecord*)context;
+
+    // within a phase the count only goes up, and never past the total
+    if (record->numReports > 0 && progress->phase == record->lastPhase && progress->numProcessed < record->lastProcessed)
+        record->numOutOfOrder++;
+    if (progress->numProcessed > progress->numTotal || progress->phase < record->lastPhase)
+        record->numOutOfOrder++;
+
+    record->numReports++;
+    record->numExpanding += (progress->phase == PROGRESS_PHASE_EXPANDING);
+    record->numIrredundant += (progress->phase == PROGRESS_PHASE_IRREDUNDANT);
+    record->lastPhase = progress->phase;
+    record->lastProcessed = progress->numProcessed;
+
+    if (record->cancelAfter != 0 && record->numReports >= record->cancelAfter)
+        record->cancel = 1;
+}
+
+static void TestProgressAndCancellation(void)
+{
+    const unsigned long numTests = 4;
+    const unsigned long numVars = 18;
+    const size_t numOfPossibleInputs = (size_t)1 << numVars;
+
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestProgressAndCancellation test...\n\n");
+
+    triLogic* truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+    if (truthTable == NULL)
+        numFailures++;
+
+    for (unsigned long iTest = 0; iTest < numTests && truthTable != NULL; iTest++)
+    {
+        GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+        // the reports don't change the result, odd tests take the ordered expansion and the cost pass
+        ProgressRecord record = { 0 };
+        ReduceLogicOptions options = { POLARITY_SUM_OF_PRODUCTS };
+        if (iTest % 2)
+        {
+            options.seeding = SEED_ORDER_MOST_CONSTRAINED;
+            options.irredundancy = IRREDUNDANCY_ON_ENTRIES;
+        }
+        options.progress = RecordProgress;
+        options.progressContext = &record;
+        options.cancel = &record.cancel;
+
+        ReduceLogicOptions plainOptions = options;
+        plainOptions.progress = NULL;
+        plainOptions.cancel = NULL;
+
+        SumOfProducts reported = { numVars };
+        SumOfProducts plain = { numVars };
+        if (ReduceLogicWithOptions(truthTable, &reported, &options) != STATUS_OKAY ||
+            ReduceLogicWithOptions(truthTable, &plain, &plainOptions) != STATUS_OKAY)
+        {
+            numFailures++;
+            FinalizeSumOfProducts(&reported);
+            FinalizeSumOfProducts(&plain);
+            continue;
+        }
+
+        int isSame = (reported.numTerms == plain.numTerms);
+        for (unsigned long iTerm = 0; isSame && iTerm < reported.numTerms; iTerm++)
+            isSame = (reported.terms[iTerm] == plain.terms[iTerm]) && (reported.dontCares[iTerm] == plain.dontCares[iTerm]);
+
+        if (isSame && record.numOutOfOrder == 0 && record.numExpanding > 1 && record.numIrredundant > 1 &&
+            record.lastPhase == PROGRESS_PHASE_IRREDUNDANT)
+            numRight++;
+        else
+            numWrong++;
+
+        FinalizeSumOfProducts(&reported);
+        FinalizeSumOfProducts(&plain);
+
+        // cancelling before the start, in the expansion and in the irredundancy pass leaves no terms
+        unsigned long cancelPoints[3] = { 1, 2, record.numExpanding + 1 };
+        for (unsigned long iPoint = 0; iPoint < 3; iPoint++)
+        {
+            ProgressRecord cancelRecord = { 0 };
+            cancelRecord.cancelAfter = cancelPoints[iPoint];
+            options.progressContext = &cancelRecord;
+            options.cancel = &cancelRecord.cancel;
+
+            SumOfProducts cancelled = { numVars };
+            if (ReduceLogicWithOptions(truthTable, &cancelled, &options) == STATUS_CANCELLED &&
+                cancelled.numTerms == 0 && cancelled.terms == NULL && cancelled.dontCares == NULL &&
+                cancelRecord.numReports == cancelPoints[iPoint])
+                numRight++;
+            else
+                numWrong++;
+
+            FinalizeSumOfProducts(&cancelled);
+        }
+    }
+
+    free(truthTable);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestDeadlines(void)
+{
+    const unsigned long numTests = 4;
+    const unsigned long numVars = 20;
+    const size_t numOfPossibleInputs = (size_t)1 << numVars;
+    const double timeLimits[3] = { 0.0, 0.02, 1000.0 };
+
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+    unsigned long numIncomplete = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestDeadlines test...\n\n");
+
+    triLogic* truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+    char* isCovered = malloc(numOfPossibleInputs * sizeof(char));
+    if (truthTable == NULL || isCovered == NULL)
+        numFailures++;
+
+    for (unsigned long iTest = 0; iTest < numTests && truthTable != NULL && isCovered != NULL; iTest++)
+    {
+        GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+        // odd tests take the ordered expansion and the cost pass
+        ReduceLogicOptions options = { POLARITY_SUM_OF_PRODUCTS };
+        if (iTest % 2)
+        {
+            options.expansion = EXPAND_ORDER_MOST_UNCOVERED;
+            options.irredundancy = IRREDUNDANCY_ON_ENTRIES;
+        }
+
+        SumOfProducts full = { numVars };
+        unsigned long timer = GetTickCountForOS();
+        if (ReduceLogicWithOptions(truthTable, &full, &options) != STATUS_OKAY)
+        {
+            numFailures++;
+            continue;
+        }
+        timer = GetTickCountForOS() - timer;
+        printf("Minimized %i variables without a deadline in %i %s\n", numVars, timer, unitsGetTickCount);
+
+        for (unsigned long iLimit = 0; iLimit < 3; iLimit++)
+        {
+            SumOfProducts limited = { numVars };
+            int isComplete = 0;
+            timer = GetTickCountForOS();
+            if (ReduceLogicWithDeadline(truthTable, &limited, &options, timeLimits[iLimit], &isComplete) != STATUS_OKAY)
+            {
+                numFailures++;
+                continue;
+            }
+            timer = GetTickCountForOS() - timer;
+            printf("  with %.2f seconds: %i terms, %s, in %i %s\n", timeLimits[iLimit], limited.numTerms,
+                isComplete ? "complete" : "cut short", timer, unitsGetTickCount);
+            numIncomplete += !isComplete;
+
+            // every ON entry is covered and no OFF entry is, with the cover painted one term at a time
+            int isCorrect = 1;
+            memset(isCovered, 0, numOfPossibleInputs);
+            for (unsigned long iTerm = 0; iTerm < limited.numTerms && isCorrect; iTerm++)
+            {
+                cube64 term = limited.terms[iTerm] & ~limited.dontCares[iTerm];
+                cube64 dcBits = 0;
+                do
+                {
+                    isCovered[term | dcBits] = 1;
+                    isCorrect = (truthTable[term | dcBits] != LOGIC_FALSE);
+                    dcBits = (dcBits - limited.dontCares[iTerm]) & limited.dontCares[iTerm];
+                } while (dcBits && isCorrect);
+            }
+            for (size_t iInput = 0; iInput < numOfPossibleInputs && isCorrect; iInput++)
+                isCorrect = (truthTable[iInput] != LOGIC_TRUE || isCovered[iInput]);
+
+            // with no time the cover is still correct, and with plenty it is the usual one
+            int isSame = 1;
+            if (iLimit == 2)
+            {
+                isSame = isComplete && (limited.numTerms == full.numTerms);
+                for (unsigned long iTerm = 0; isSame && iTerm < limited.numTerms; iTerm++)
+                    isSame = (limited.terms[iTerm] == full.terms[iTerm]) && (limited.dontCares[iTerm] == full.dontCares[iTerm]);
+            }
+            else if (iLimit == 0)
+            {
+                isSame = !isComplete;
+            }
+
+            if (isCorrect && isSame)
+                numRight++;
+            else
+                numWrong++;
+
+            FinalizeSumOfProducts(&limited);
+        }
+
+        FinalizeSumOfProducts(&full);
+    }
+
+    free(truthTable);
+    free(isCovered);
+
+    printf("%i of the runs were cut short\n", numIncomplete);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestCheckpoints(void)
+{
+    const unsigned long numTests = 4;
+    const unsigned long numVars = 18;
+    const size_t numOfPossibleInputs = (size_t)1 << numVars;
+    const char* path = "shrinquem_test.chk";
+
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestCheckpoints test...\n\n");
+
+    triLogic* truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+    if (truthTable == NULL)
+        numFailures++;
+
+    for (unsigned long iTest = 0; iTest < numTests && truthTable != NULL; iTest++)
+    {
+        GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+        // odd tests take the other polarity and the cost pass
+        ProgressRecord record = { 0 };
+        ReduceLogicOptions options = { (iTest % 2) ? POLARITY_PRODUCT_OF_SUMS : POLARITY_SUM_OF_PRODUCTS };
+        if (iTest % 2)
+            options.irredundancy = IRREDUNDANCY_ON_ENTRIES;
+        options.progress = RecordProgress;
+        options.progressContext = &record;
+
+        SumOfProducts plain = { numVars };
+        if (ReduceLogicWithOptions(truthTable, &plain, &options) != STATUS_OKAY)
+        {
+            numFailures++;
+            FinalizeSumOfProducts(&plain);
+            continue;
+        }
+
+        // stopped early in the expansion, late in it and in the irredundancy pass, the resumed run ends the same
+        unsigned long cancelPoints[3] = { 2, record.numExpanding - 1, record.numExpanding + 1 };
+        for (unsigned long iPoint = 0; iPoint < 3; iPoint++)
+        {
+            ProgressRecord cancelRecord = { 0 };
+            cancelRecord.cancelAfter = cancelPoints[iPoint];
+            options.progressContext = &cancelRecord;
+            options.cancel = &cancelRecord.cancel;
+
+            SumOfProducts stopped = { numVars };
+            SumOfProducts resumed = { numVars };
+            if (ReduceLogicWithCheckpoints(truthTable, &stopped, &options, path, 0.0) != STATUS_CANCELLED)
+            {
+                numFailures++;
+                options.cancel = NULL;
+                continue;
+            }
+
+            options.cancel = NULL;
+            if (ResumeReduceLogic(truthTable, &resumed, &options, path, 0.0) != STATUS_OKAY)
+            {
+                numFailures++;
+                FinalizeSumOfProducts(&resumed);
+                continue;
+            }
+
+            int isSame = (resumed.numTerms == plain.numTerms) && (resumed.cost == plain.cost);
+            for (unsigned long iTerm = 0; isSame && iTerm < resumed.numTerms; iTerm++)
+                isSame = (resumed.terms[iTerm] == plain.terms[iTerm]) && (resumed.dontCares[iTerm] == plain.dontCares[iTerm]);
+
+            if (isSame)
+                numRight++;
+            else
+                numWrong++;
+
+            FinalizeSumOfProducts(&resumed);
+        }
+
+        // a checkpoint of another table or polarity is refused
+        triLogic first = truthTable[0];
+        truthTable[0] = (first == LOGIC_TRUE) ? LOGIC_FALSE : LOGIC_TRUE;
+        SumOfProducts other = { numVars };
+        if (ResumeReduceLogic(truthTable, &other, &options, path, 0.0) == STATUS_INVALID_ARGUMENT && other.numTerms == 0)
+            numRight++;
+        else
+            numWrong++;
+        FinalizeSumOfProducts(&other);
+        truthTable[0] = first;
+        other.numVars = numVars;
+
+        options.polarity = (options.polarity == POLARITY_SUM_OF_PRODUCTS) ? POLARITY_PRODUCT_OF_SUMS : POLARITY_SUM_OF_PRODUCTS;
+        if (ResumeReduceLogic(truthTable, &other, &options, path, 0.0) == STATUS_INVALID_ARGUMENT)
+            numRight++;
+        else
+            numWrong++;
+        FinalizeSumOfProducts(&other);
+
+        FinalizeSumOfProducts(&plain);
+        remove(path);
+    }
+
+    // there is nothing to resume without a file, and the ordered expansion keeps no checkpoints
+    SumOfProducts missing = { numVars };
+    ReduceLogicOptions ordered = { POLARITY_SUM_OF_PRODUCTS };
+    ordered.seeding = SEED_ORDER_MOST_CONSTRAINED;
+    if (truthTable != NULL)
+    {
+        if (ResumeReduceLogic(truthTable, &missing, NULL, path, 0.0) == STATUS_FILE_ERROR)
+            numRight++;
+        else
+            numWrong++;
+        FinalizeSumOfProducts(&missing);
+        missing.numVars = numVars;
+
+        if (ReduceLogicWithCheckpoints(truthTable, &missing, &ordered, path, 0.0) == STATUS_INVALID_ARGUMENT)
+            numRight++;
+        else
+            numWrong++;
+        FinalizeSumOfProducts(&missing);
+    }
+
+    free(truthTable);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestOutOfCore(void)
+{
+    const unsigned long numTests = 4;
+    const unsigned long numVars = 20;
+    const size_t numOfPossibleInputs = (size_t)1 << numVars;
+    const char* path = "shrinquem_test.tbl";
+
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestOutOfCore test...\n\n");
+
+    triLogic* truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+    if (truthTable == NULL)
+        numFailures++;
+
+    for (unsigned long iTest = 0; iTest < numTests && truthTable != NULL; iTest++)
+    {
+        GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+        FILE* file = fopen(path, "wb");
+        size_t numWritten = (file != NULL) ? fwrite(truthTable, sizeof(triLogic), numOfPossibleInputs, file) : 0;
+        if (file == NULL || fclose(file) != 0 || numWritten != numOfPossibleInputs)
+        {
+            numFailures++;
+            continue;
+        }
+
+        // odd tests take the other polarity and the cost pass
+        ReduceLogicOptions options = { (iTest % 2) ? POLARITY_PRODUCT_OF_SUMS : POLARITY_SUM_OF_PRODUCTS };
+        if (iTest % 2)
+            options.irredundancy = IRREDUNDANCY_ON_ENTRIES;
+
+        ReduceLogicOptions outOfCoreOptions = options;
+        outOfCoreOptions.scratchDirectory = ".";
+
+        MappedTruthTable table;
+        SumOfProducts inMemory = { numVars };
+        SumOfProducts outOfCore = { numVars };
+        if (MapTruthTableFile(path, numVars, &table) != STATUS_OKAY ||
+            ReduceLogicWithOptions(truthTable, &inMemory, &options) != STATUS_OKAY)
+        {
+            numFailures++;
+            UnmapTruthTableFile(&table);
+            FinalizeSumOfProducts(&inMemory);
+            continue;
+        }
+
+        unsigned long timer = GetTickCountForOS();
+        if (ReduceLogicWithOptions(table.values, &outOfCore, &outOfCoreOptions) != STATUS_OKAY)
+        {
+            numFailures++;
+            UnmapTruthTableFile(&table);
+            FinalizeSumOfProducts(&inMemory);
+            continue;
+        }
+        timer = GetTickCountForOS() - timer;
+        printf("Minimized %i variables from a file in %i %s\n", numVars, timer, unitsGetTickCount);
+
+        // the arrays being in files changes nothing about the result
+        int isSame = (outOfCore.numTerms == inMemory.numTerms) && (outOfCore.cost == inMemory.cost);
+        for (unsigned long iTerm = 0; isSame && iTerm < outOfCore.numTerms; iTerm++)
+            isSame = (outOfCore.terms[iTerm] == inMemory.terms[iTerm]) && (outOfCore.dontCares[iTerm] == inMemory.dontCares[iTerm]);
+
+        if (isSame)
+            numRight++;
+        else
+            numWrong++;
+
+        UnmapTruthTableFile(&table);
+        FinalizeSumOfProducts(&inMemory);
+        FinalizeSumOfProducts(&outOfCore);
+
+        // a scratch directory that isn't there can't hold the arrays
+        SumOfProducts missing = { numVars };
+        outOfCoreOptions.scratchDirectory = "shrinquem_no_such_directory";
+        if (ReduceLogicWithOptions(truthTable, &missing, &outOfCoreOptions) == STATUS_FILE_ERROR && missing.terms == NULL)
+            numRight++;
+        else
+            numWrong++;
+        FinalizeSumOfProducts(&missing);
+    }
+
+    // the file has to be the size of the table, and has to be there
+    MappedTruthTable table;
+    if (truthTable != NULL)
+    {
+        if (MapTruthTableFile(path, numVars + 1, &table) == STATUS_INVALID_ARGUMENT && table.values == NULL)
+            numRight++;
+        else
+            numWrong++;
+
+        remove(path);
+        if (MapTruthTableFile(path, numVars, &table) == STATUS_FILE_ERROR && table.values == NULL)
+            numRight++;
+        else
+            numWrong++;
+    }
+
+    free(truthTable);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+static void TestMemoryPlacement(void)
+{
+    const unsigned long numVars = 25;
+    const size_t numOfPossibleInputs = (size_t)1 << numVars;
+    const pagePolicy policies[3] = { PAGES_SMALL, PAGES_TRANSPARENT_HUGE, PAGES_EXPLICIT_HUGE };
+    const char* pageNames[3] = { "transparent huge", "explicit huge", "small" }; // in the order of pagePolicy
+
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestMemoryPlacement test...\n\n");
+
+    // a table large enough for huge pages with few ON entries, so it minimizes quickly
+    triLogic* truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+    if (truthTable == NULL)
+        numFailures++;
+
+    SumOfProducts smallPages = { numVars };
+    for (size_t iInput = 0; iInput < numOfPossibleInputs && truthTable != NULL; iInput++)
+    {
+        truthTable[iInput] = ((iInput & 0xFFF) == 0x123) ? LOGIC_TRUE : LOGIC_FALSE;
+        if (GetRandomLong(0, 1 << 14) == 0)
+            truthTable[iInput] = (triLogic)GetRandomLong(LOGIC_TRUE, LOGIC_DONT_CARE);
+    }
+
+    for (unsigned long iPolicy = 0; iPolicy < 3 && truthTable != NULL; iPolicy++)
+    {
+        ReduceLogicOptions options = { POLARITY_SUM_OF_PRODUCTS };
+        options.pages = policies[iPolicy];
+
+        SumOfProducts sumOfProducts = { numVars };
+        unsigned long timer = GetTickCountForOS();
+        if (ReduceLogicWithOptions(truthTable, &sumOfProducts, &options) != STATUS_OKAY)
+        {
+            numFailures++;
+            continue;
+        }
+        timer = GetTickCountForOS() - timer;
+
+        MemoryPlacement placement;
+        GetMemoryPlacement(&placement);
+        printf("Asked for %s pages and got %s pages on %i of %i nodes in %i %s\n", pageNames[policies[iPolicy]],
+            pageNames[placement.pages], placement.isInterleaved ? placement.numNodes : 1, placement.numNodes, timer, unitsGetTickCount);
+
+        // the pages change nothing about the result, and no request gets bigger pages than it asked for
+        int isSame = 1;
+        if (iPolicy == 0)
+        {
+            smallPages = sumOfProducts;
+            sumOfProducts.terms = NULL;
+            sumOfProducts.dontCares = NULL;
+            sumOfProducts.equation = NULL;
+        }
+        else
+        {
+            isSame = (sumOfProducts.numTerms == smallPages.numTerms);
+            for (unsigned long iTerm = 0; isSame && iTerm < sumOfProducts.numTerms; iTerm++)
+                isSame = (sumOfProducts.terms[iTerm] == smallPages.terms[iTerm]) && (sumOfProducts.dontCares[iTerm] == smallPages.dontCares[iTerm]);
+        }
+
+        int isAllowed = (placement.pages == policies[iPolicy] || placement.pages == PAGES_SMALL || policies[iPolicy] == PAGES_EXPLICIT_HUGE);
+        if (isSame && isAllowed && placement.size >= numOfPossibleInputs && placement.numNodes >= 1 && !placement.isInterleaved)
+            numRight++;
+        else
+            numWrong++;
+
+        FinalizeSumOfProducts(&sumOfProducts);
+    }
+
+    // the two runs of ReduceLogicAuto share their resolved entries, so those are spread over the nodes there are
+    SumOfProducts automatic = { numVars };
+    if (truthTable != NULL)
+    {
+        MemoryPlacement placement;
+        if (ReduceLogicAuto(truthTable, &automatic) != STATUS_OKAY)
+        {
+            numFailures++;
+        }
+        else
+        {
+            GetMemoryPlacement(&placement);
+            printf("Shared the resolved entries over %i of %i nodes\n", placement.isInterleaved ? placement.numNodes : 1, placement.numNodes);
+            if (placement.size >= numOfPossibleInputs && (placement.numNodes > 1 || !placement.isInterleaved))
+                numRight++;
+            else
+                numWrong++;
+        }
+    }
+
+    FinalizeSumOfProducts(&automatic);
+    FinalizeSumOfProducts(&smallPages);
+    free(truthTable);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
+// counts the live blocks and bytes of the library and refuses blocks past a limit, each block is prefixed by its size
+typedef struct CountingAllocator
+{
+    size_t numLiveBlocks;
+    size_t numLiveBytes;
+    size_t numAllocations;
+    size_t limit; // 0 for none
+} CountingAllocator;
+
+#define COUNTING_HEADER_SIZE (16) // keeps the blocks aligned like malloc
+
+static void* CountingAllocate(
+    size_t size,
+    void* context)
+{
+    CountingAllocator* counts = (CountingAllocator*)context;
+    if (counts->limit != 0 && counts->numLiveBytes + size > counts->limit)
+        return NULL;
+
+    char* block = malloc(size + COUNTING_HEADER_SIZE);
+    if (block == NULL)
+        return NULL;
+
+    memcpy(block, &size, sizeof(size_t));
+    counts->numLiveBlocks++;
+    counts->numLiveBytes += size;
+    counts->numAllocations++;
+
+    return block + COUNTING_HEADER_SIZE;
+}
+
+static void* CountingReallocate(
+    void* p,
+    size_t size,
+    void* context)
+{
+    CountingAllocator* counts = (CountingAllocator*)context;
+    char* block = (char*)p - COUNTING_HEADER_SIZE;
+    size_t oldSize;
+    memcpy(&oldSize, block, sizeof(size_t));
+    if (counts->limit != 0 && counts->numLiveBytes - oldSize + size > counts->limit)
+        return NULL;
+
+    block = realloc(block, size + COUNTING_HEADER_SIZE);
+    if (block == NULL)
+        return NULL;
+
+    memcpy(block, &size, sizeof(size_t));
+    counts->numLiveBytes += size - oldSize;
+
+    return block + COUNTING_HEADER_SIZE;
+}
+
+static void CountingRelease(
+    void* p,
+    void* context)
+{
+    CountingAllocator* counts = (CountingAllocator*)context;
+    char* block = (char*)p - COUNTING_HEADER_SIZE;
+    size_t size;
+    memcpy(&size, block, sizeof(size_t));
+
+    counts->numLiveBlocks--;
+    counts->numLiveBytes -= size;
+    free(block);
+}
+
+static void TestMemoryAllocator(void)
+{
+    const unsigned long numTests = 10;
+    const unsigned long numVars = 14;
+    const size_t numOfPossibleInputs = (size_t)1 << numVars;
+
+    unsigned long numRight = 0;
+    unsigned long numWrong = 0;
+    unsigned long numFailures = 0;
+
+    printf("\n\n============================================================");
+    printf("\n\nPerforming TestMemoryAllocator test...\n\n");
+
+    // an allocator missing one of its functions is refused
+    MemoryAllocator incomplete = { CountingAllocate, NULL, CountingRelease, NULL };
+    if (SetMemoryAllocator(&incomplete) == STATUS_NULL_ARGUMENT)
+        numRight++;
+    else
+        numWrong++;
+
+    triLogic* truthTable = malloc(numOfPossibleInputs * sizeof(triLogic));
+    if (truthTable == NULL)
+        numFailures++;
+
+    for (unsigned long iTest = 0; iTest < numTests && truthTable != NULL; iTest++)
+    {
+        GetRandomTriLogicArray(numOfPossibleInputs, truthTable);
+
+        SumOfProducts onHeap = { numVars };
+        if (ReduceLogic(truthTable, &onHeap) != STATUS_OKAY)
+        {
+            numFailures++;
+            continue;
+        }
+
+        // the cover is the same from the allocator, and everything of it is given back by the finalize
+        CountingAllocator counts = { 0 };
+        MemoryAllocator allocator = { CountingAllocate, CountingReallocate, CountingRelease, &counts };
+        SumOfProducts counted = { numVars };
+        if (SetMemoryAllocator(&allocator) != STATUS_OKAY ||
+            ReduceLogic(truthTable, &counted) != STATUS_OKAY ||
+            GenerateEquationString(&counted, NULL) != STATUS_OKAY)
+        {
+            numFailures++;
+            FinalizeSumOfProducts(&counted);
+            SetMemoryAllocator(NULL);
+            FinalizeSumOfProducts(&onHeap);
+            continue;
+        }
+
+        int isSame = (counted.numTerms == onHeap.numTerms);
+        for (unsigned long iTerm = 0; isSame && iTerm < counted.numTerms; iTerm++)
+            isSame = (counted.terms[iTerm] == onHeap.terms[iTerm]) && (counted.dontCares[iTerm] == onHeap.dontCares[iTerm]);
+
+        size_t numResultBlocks = counts.numLiveBlocks;
+        FinalizeSumOfProducts(&counted);
+
+        if (isSame && counts.numAllocations > numResultBlocks && numResultBlocks == 3 && counts.numLiveBlocks == 0)
+            numRight++;
+        else
+            numWrong++;
+
+        // a limit the run goes over makes it fail cleanly, with nothing left allocated
+        counts.limit = (iTest + 1) * numOfPossibleInputs / numTests;
+        counted.numVars = numVars;
+        shrinquemStatus status = ReduceLogic(truthTable, &counted);
+        if (status == STATUS_OUT_OF_MEMORY && counted.terms == NULL && counts.numLiveBlocks == 0)
+            numRight++;
+        else
+            numWrong++;
+        FinalizeSumOfProducts(&counted);
+
+        SetMemoryAllocator(NULL);
+        FinalizeSumOfProducts(&onHeap);
+    }
+
+    free(truthTable);
+
+    printf("\nNumber right    : %i", numRight);
+    printf("\nNumber wrong    : %i", numWrong);
+    printf("\nNumber failures : %i", numFailures);
+    printf("\n");
+}
+
 // returns a random integer between min and max inclusively
 static long GetRandomLong(
     long min,
@@ -529,6 +3618,55 @@ static void GetRandomBoolArray(
         boolArray[i] = (char)GetRandomLong(0, 1);
 }
 
+static void GetRandomTriLogicArray(
+    unsigned long numElements,
+    triLogic triLogicArray[])
+{
+    for (unsigned long i = 0; i < numElements; i++)
+        triLogicArray[i] = (triLogic)GetRandomLong(LOGIC_FALSE, LOGIC_DONT_CARE);
+}
+
+// returns nonzero when some minterm of the cube has the given value in the truth table
+static int CubeHasValue(
+    const triLogic truthTable[],
+    unsigned long numVars,
+    cube64 term,
+    cube64 dontCares,
+    triLogic value)
+{
+    for (cube64 iInput = 0; iInput < ((cube64)1 << numVars); iInput++)
+    {
+        if ((iInput & ~dontCares) == (term & ~dontCares) && truthTable[iInput] == value)
+            return 1;
+    }
+
+    return 0;
+}
+
+static void TestAllInputsExclusive(
+    const SumOfProducts sumOfProducts,
+    const triLogic truthTable[],
+    unsigned long* numRight,
+    unsigned long* numWrong)
+{
+    triLogic result;
+    unsigned long numOfPossibleInputs = 1 << sumOfProducts.numVars;
+
+    for (unsigned long iInput = 0; iInput < numOfPossibleInputs; iInput++)
+    {
+        if (truthTable[iInput] == LOGIC_DONT_CARE)
+            (*numRight)++;
+        else
+        {
+            result = EvaluateExclusiveSumOfProducts(sumOfProducts, iInput);
+            if (truthTable[iInput] == result)
+                (*numRight)++;
+            else
+                (*numWrong)++;
+        }
+    }
+}
+
 static void TestAllInputs(
     const SumOfProducts sumOfProducts,
     const triLogic truthTable[],
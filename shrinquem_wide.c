@@ -0,0 +1,77 @@
+// shrinquem - An algorithm for logic minimization.
+// Copyright (C) 2021 Damon Bohls <damonbohls@gmail.com>
+// MIT License: https://github.com/d-bohls/shrinquem/blob/main/LICENSE
+
+#include "shrinquem.h"
+#include "shrinquem_internal.h"
+
+/*************************************************************************
+DEFINE_WIDE_COVER
+Purpose - defines the operations on a whole cover of one wide cube type,
+  built on the word-parallel operations of that type. The cover functions
+  below pick the instance matching the numWords of the cover.
+*************************************************************************/
+
+#define DEFINE_WIDE_COVER(numBits)                                                                  \
+static triLogic EvaluateCover##numBits(const cube##numBits terms[], unsigned long numTerms, const cube64 input[]) \
+{                                                                                                   \
+    for (unsigned long iTerm = 0; iTerm < numTerms; iTerm++)                                        \
+    {                                                                                               \
+        if (Cube##numBits##ContainsMinterm(&terms[iTerm], input))                                   \
+            return LOGIC_TRUE;                                                                      \
+    }                                                                                               \
+    return LOGIC_FALSE;                                                                             \
+}
+
+DEFINE_WIDE_COVER(128)
+DEFINE_WIDE_COVER(256)
+DEFINE_WIDE_COVER(512)
+
+unsigned long WideCubeWords(
+    unsigned long numVars)
+{
+    if (numVars <= 128)
+        return 2;
+    else if (numVars <= 256)
+        return 4;
+    else if (numVars <= WIDE_MAX_VARIABLES)
+        return 8;
+
+    return 0;
+}
+
+void FinalizeWideSumOfProducts(
+    WideSumOfProducts* wideSumOfProducts)
+{
+    wideSumOfProducts->numVars = 0;
+    wideSumOfProducts->numWords = 0;
+    wideSumOfProducts->numTerms = 0;
+
+    if (wideSumOfProducts->terms)
+    {
+        FreeMemory(wideSumOfProducts->terms);
+        wideSumOfProducts->terms = NULL;
+    }
+}
+
+/*************************************************************************
+EvaluateWideSumOfProducts
+Purpose - returns the value of a wide cover for one input. Every term has
+  don't cares for the variables past numVars, so the bits of the input
+  there don't matter.
+*************************************************************************/
+
+triLogic EvaluateWideSumOfProducts(
+    const WideSumOfProducts* wideSumOfProducts,
+    const cube64 input[])
+{
+    switch (wideSumOfProducts->numWords)
+    {
+    case 2:
+        return EvaluateCover128((const cube128*)wideSumOfProducts->terms, wideSumOfProducts->numTerms, input);
+    case 4:
+        return EvaluateCover256((const cube256*)wideSumOfProducts->terms, wideSumOfProducts->numTerms, input);
+    default: // 8
+        return EvaluateCover512((const cube512*)wideSumOfProducts->terms, wideSumOfProducts->numTerms, input);
+    }
+}